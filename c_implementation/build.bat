@@ -30,6 +30,26 @@ echo   audio_reader.c - OK
 if errorlevel 1 goto error
 echo   fft.c - OK
 
+%CC% %CFLAGS% %INC% -c src/fft_simd.c -o obj/fft_simd.o
+if errorlevel 1 goto error
+echo   fft_simd.c - OK
+
+%CC% %CFLAGS% %INC% -c src/fft_batch.c -o obj/fft_batch.o
+if errorlevel 1 goto error
+echo   fft_batch.c - OK
+
+%CC% %CFLAGS% %INC% -c src/fft_lags.c -o obj/fft_lags.o
+if errorlevel 1 goto error
+echo   fft_lags.c - OK
+
+%CC% %CFLAGS% %INC% -c src/thread_pool.c -o obj/thread_pool.o
+if errorlevel 1 goto error
+echo   thread_pool.c - OK
+
+%CC% %CFLAGS% %INC% -c src/gcc_weight.c -o obj/gcc_weight.o
+if errorlevel 1 goto error
+echo   gcc_weight.c - OK
+
 %CC% %CFLAGS% %INC% -c src/gcc_phat.c -o obj/gcc_phat.o
 if errorlevel 1 goto error
 echo   gcc_phat.c - OK
@@ -38,10 +58,30 @@ echo   gcc_phat.c - OK
 if errorlevel 1 goto error
 echo   srp_map.c - OK
 
+%CC% %CFLAGS% %INC% -c src/srp_freq.c -o obj/srp_freq.o
+if errorlevel 1 goto error
+echo   srp_freq.c - OK
+
+%CC% %CFLAGS% %INC% -c src/srp_ico.c -o obj/srp_ico.o
+if errorlevel 1 goto error
+echo   srp_ico.c - OK
+
+%CC% %CFLAGS% %INC% -c src/tau_cache.c -o obj/tau_cache.o
+if errorlevel 1 goto error
+echo   tau_cache.c - OK
+
 %CC% %CFLAGS% %INC% -c src/test_data.c -o obj/test_data.o
 if errorlevel 1 goto error
 echo   test_data.c - OK
 
+%CC% %CFLAGS% %INC% -c src/benchmark.c -o obj/benchmark.o
+if errorlevel 1 goto error
+echo   benchmark.c - OK
+
+%CC% %CFLAGS% %INC% -c src/fixed_point.c -o obj/fixed_point.o
+if errorlevel 1 goto error
+echo   fixed_point.c - OK
+
 %CC% %CFLAGS% %INC% -c src/main.c -o obj/main.o
 if errorlevel 1 goto error
 echo   main.c - OK
@@ -50,7 +90,7 @@ echo.
 echo Linking...
 
 REM Link all object files
-%CC% obj/main.o obj/audio_reader.o obj/fft.o obj/gcc_phat.o obj/srp_map.o obj/test_data.o -o bin/cross3d_preprocess.exe %LDFLAGS%
+%CC% obj/main.o obj/audio_reader.o obj/fft.o obj/fft_simd.o obj/fft_batch.o obj/fft_lags.o obj/thread_pool.o obj/gcc_weight.o obj/gcc_phat.o obj/srp_map.o obj/srp_freq.o obj/srp_ico.o obj/tau_cache.o obj/test_data.o obj/benchmark.o obj/fixed_point.o -o bin/cross3d_preprocess.exe %LDFLAGS%
 if errorlevel 1 goto error
 
 echo.
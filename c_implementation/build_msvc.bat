@@ -57,9 +57,19 @@ cl /nologo /O2 /W3 /I include /Fe:bin\cross3d_preprocess.exe ^
    src\main.c ^
    src\audio_reader.c ^
    src\fft.c ^
+   src\fft_simd.c ^
+   src\fft_batch.c ^
+   src\fft_lags.c ^
+   src\thread_pool.c ^
+   src\gcc_weight.c ^
    src\gcc_phat.c ^
    src\srp_map.c ^
-   src\test_data.c
+   src\srp_freq.c ^
+   src\srp_ico.c ^
+   src\tau_cache.c ^
+   src\test_data.c ^
+   src\benchmark.c ^
+   src\fixed_point.c
 
 if errorlevel 1 goto error
 
@@ -0,0 +1,179 @@
+/**
+ * @file benchmark.h
+ * @brief 性能基准测试模块头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 该模块对各处理环节的不同实现进行计时比较，
+ * 通过主程序的 --bench 参数运行。
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 比较FFT算法变体的执行时间
+ * 
+ * 在4096和16384点上分别测试位反转变体与Stockham变体 (标量引擎)，
+ * 以及位反转变体的最佳SIMD引擎作为参考，
+ * 报告复数FFT与实数FFT的单次平均耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_fft_algorithms(void);
+
+/**
+ * @brief 比较混合基点数与补零到2的幂的执行时间
+ * 
+ * 对960/3840/4800点的混合基Stockham计划，与补零后的1024/4096/8192点
+ * 的标量Stockham计划及默认引擎计划比较复数FFT与实数FFT的单次平均耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_fft_mixed_radix(void);
+
+/**
+ * @brief 比较批量变换与逐路循环的执行时间
+ * 
+ * 默认引擎下测试一帧NUM_CHANNELS路实数FFT
+ * 与NUM_MIC_PAIRS路实数IFFT (GCC逆变换) 的总耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_fft_batch(void);
+
+/**
+ * @brief 比较部分时延逆变换各策略的执行时间
+ * 
+ * 在FFT_SIZE点上对不同的最大时延分别强制使用完整/直接策略，
+ * 报告单次平均耗时及代价模型自动选择的策略。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_fft_lags(void);
+
+/**
+ * @brief 比较完整GCC的两种逆变换方式的执行时间
+ * 
+ * 对一帧白化频谱分别以逐对实数IFFT (批量) 与两对合一的复数IFFT
+ * 计算全部NUM_MIC_PAIRS对的GCC，报告单帧平均耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_gcc_ifft_modes(void);
+
+/**
+ * @brief 比较各GCC加权函数的执行时间
+ * 
+ * 对一帧FFT结果分别报告PHAT、PHAT-β、SCOT与ROTH的通道加权耗时
+ * 以及包含逆变换的整帧GCC耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_gcc_weightings(void);
+
+/**
+ * @brief 比较不同GCC频带的执行时间
+ * 
+ * 对一帧FFT结果分别以全频带、100-8000 Hz与300-3400 Hz计算全部NUM_MIC_PAIRS对的
+ * 完整GCC与 ±7 时延窗口GCC，报告单帧平均耗时。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_gcc_band(void);
+
+/**
+ * @brief 比较SRP查表路径与频域引擎的执行时间
+ * 
+ * 在300-3400 Hz与100-8000 Hz频带下，对1到TAU_TABLE_SIZE个网格点分别计时
+ * 孔径窗口GCC + 查表、频域引擎单帧与8帧批量 (每帧)，并列出代价模型的选择。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_srp_engines(void);
+
+/**
+ * @brief 比较取整、线性与三次插值时延下SRP投影的执行时间
+ * 
+ * 分别计时完整GCC上的查表投影 (srp_map_compute) 与融合投影 (srp_map_compute_fused)。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_srp_interp(void);
+
+/**
+ * @brief 比较近场/远场与时延列去重下SRP投影的执行时间
+ * 
+ * 对近场、远场各自在去重前后的网格，报告实际计算的网格点数，计时完整GCC查表与融合投影，
+ * 以及300-3400 Hz频带下频域引擎的单帧耗时 (导向矩阵超出内存上限时为-1)。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_srp_far_field(void);
+
+/**
+ * @brief 比较不同麦克风对子集的GCC与SRP执行时间及定位一致性
+ * 
+ * 对全部对、基线最长的33对、几何贪心的33/22对以及屏蔽一个麦克风后贪心的22对，
+ * 计时完整GCC与融合投影，并对BENCH_PAIR_SOURCES个位于随机网格点的声源统计子集的SRP峰值点
+ * 在全部对的SRP-Map上比最大值低多少 (平均百分比)。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_pair_selection(void);
+
+/**
+ * @brief 比较二十面体SRP图两种时延表布局的执行时间
+ * 
+ * 对r = 1..SRP_ICO_MAX_RESOLUTION的网格，计时按对排列 (int32完整GCC索引，逐对累加) 与
+ * 按网格点排列 (int16紧凑GCC偏移，AVX2 gather累加) 的单帧耗时，并比较两者结果的最大差值。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_srp_ico_layout(void);
+
+/**
+ * @brief 比较二十面体网格上层次峰值搜索与穷举SRP图的执行时间及峰值一致性
+ * 
+ * 对r = 2..SRP_ICO_MAX_RESOLUTION与每层保留1/SRP_ICO_SEARCH_TOP_K/8个候选，
+ * 对BENCH_PAIR_SOURCES个随机方向的声源统计平均计算的网格点数、与穷举峰值相同的次数
+ * 以及搜索峰值的归一化功率损失，并计时单帧搜索与穷举计算整张图。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_srp_ico_search(void);
+
+/**
+ * @brief 比较二十面体SRP计划在计算时延表与读取时延表缓存时的创建时间
+ * 
+ * 对r = 1..SRP_ICO_MAX_RESOLUTION的网格，分别计时禁用缓存 (逐对逐网格点计算) 与缓存命中
+ * (映射缓存文件) 的单次计划创建，并比较两个计划输出的SRP图。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_tau_cache(void);
+
+/**
+ * @brief 比较串行与线程池并行GCC-PHAT的执行时间
+ * 
+ * 对一帧FFT结果分别以单个GCC上下文与1、2、4...个工作线程 (直到处理器核数)
+ * 计算全部NUM_MIC_PAIRS对的GCC，按墙钟时间报告单帧平均耗时与加速比。
+ * 
+ * @return 状态码
+ */
+status_t benchmark_gcc_parallel(void);
+
+/**
+ * @brief 运行全部基准测试
+ * @return 状态码
+ */
+status_t benchmark_run_all(void);
+
+#endif /* BENCHMARK_H */
@@ -16,14 +16,14 @@
  *============================================================================*/
 #define SAMPLE_RATE         24000       /* 采样率 (Hz) */
 #define NUM_CHANNELS        12          /* 麦克风通道数 */
-#define FRAME_LENGTH        4096        /* 每帧采样点数 (FFT点数) */
+#define FRAME_LENGTH        4096        /* 每帧采样点数 (FFT点数, 偶数 2^a * 3^b * 5^c) */
 #define HOP_LENGTH          1024        /* 帧移 (samples) */
 #define NUM_FRAMES          103         /* 总帧数 */
 
 /*============================================================================
  * FFT参数
  *============================================================================*/
-#define FFT_SIZE            4096        /* FFT点数 */
+#define FFT_SIZE            FRAME_LENGTH    /* FFT点数 (非2的幂时使用混合基FFT，无需补零) */
 #define FFT_BINS            (FFT_SIZE / 2 + 1)  /* FFT频点数 = 2049 */
 
 /*============================================================================
@@ -36,7 +36,10 @@
  * GCC-PHAT参数
  *============================================================================*/
 #define GCC_LENGTH          FFT_SIZE        /* GCC输出长度 */
-#define MAX_TAU_SAMPLES     128         /* 最大时延采样点数 */
+#define MAX_TAU_SAMPLES     128         /* 最大时延采样点数 (紧凑GCC的容量上限) */
+#define GCC_BAND_LOW_HZ     0.0f        /* GCC频带下限 (Hz)，语音DOA可取100 */
+#define GCC_BAND_HIGH_HZ    0.0f        /* GCC频带上限 (Hz, 0表示Nyquist)，语音DOA可取8000 */
+#define GCC_MAX_PAIRS       0           /* 启用的麦克风对数上限 (0表示全部，否则按几何贪心选取) */
 
 /*============================================================================
  * SRP-Map参数
@@ -45,6 +48,16 @@
 #define SRP_AZIMUTH_BINS    4           /* 方位角分辨率 */
 #define SRP_RANGE_BINS      8           /* 距离分辨率 (W维度) */
 #define TAU_TABLE_SIZE      (SRP_ELEVATION_BINS * SRP_AZIMUTH_BINS * SRP_RANGE_BINS)
+#define SRP_FREQ_MAX_STEER_MB 64        /* 频域SRP导向矩阵的内存上限 (MB) */
+#define SRP_TAU_INTERP      0           /* 时延插值: 0取整, 1线性, 2三次 (见srp_interp_t) */
+#define SRP_FAR_FIELD       0           /* 1: 远场模式，时延只由方向决定 (与距离无关) */
+#define SRP_DEDUP_TAU       1           /* 1: 时延列相同的网格点只计算一次 */
+#define SRP_ICO_RESOLUTION  2           /* 二十面体SRP图的网格分辨率r (与icoCNN模型一致) */
+#define SRP_ICO_MAX_RESOLUTION 4        /* 二十面体网格支持的最大分辨率 */
+#define SRP_ICO_SEARCH_TOP_K 4          /* 层次峰值搜索每层保留的候选数 */
+#define SRP_ICO_SEARCH_MIN_RES 3        /* 主程序演示层次搜索的最低分辨率 (更粗的网格穷举即可) */
+#define TAU_CACHE_ENABLE    1           /* 1: 时延表按几何与网格哈希缓存到文件 (见tau_cache.h) */
+#define TAU_CACHE_DIR       "output/tau_cache"  /* 时延表缓存目录 */
 
 /*============================================================================
  * 数学常量
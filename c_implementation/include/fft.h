@@ -6,6 +6,12 @@
  * 
  * 该模块实现快速傅里叶变换(FFT)和逆变换(IFFT)，
  * 采用Cooley-Tukey算法。
+ * 
+ * 变换通过FFT计划(fft_plan_t)执行，每个计划拥有独立的旋转因子表，
+ * 同一进程中可同时使用多种点数 (如1024/2048/8192)。
+ * 点数可为任意偶数 2^a * 3^b * 5^c (如960/4800)，非2的幂点数使用混合基Stockham变体。
+ * fft_init()创建FFT_SIZE点的默认计划，供旧接口使用。
+ * 多通道数据可通过批量接口一次完成变换 (见fft_batch.c)。
  */
 
 #ifndef FFT_H
@@ -14,10 +20,196 @@
 #include "types.h"
 #include "config.h"
 
+/*============================================================================
+ * 常量定义
+ *============================================================================*/
+#define FFT_BATCH_LANES         8       /* 批量变换交织的通道数 (一个AVX2向量) */
+#define FFT_MAX_STAGES          32      /* Stockham最大级数 */
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 变换方向
+ */
+typedef enum {
+    FFT_FORWARD = 0,    /* 正向FFT */
+    FFT_BACKWARD        /* 逆向IFFT (含1/N归一化) */
+} fft_direction_t;
+
+/**
+ * @brief FFT执行引擎
+ */
+typedef enum {
+    FFT_ENGINE_AUTO = 0,    /* 运行时选择当前CPU支持的最佳引擎 */
+    FFT_ENGINE_SCALAR,      /* 标量引擎 (交织布局) */
+    FFT_ENGINE_SSE,         /* SSE向量引擎 (SoA布局) */
+    FFT_ENGINE_AVX2         /* AVX2+FMA向量引擎 (SoA布局) */
+} fft_engine_t;
+
+/**
+ * @brief FFT算法变体
+ */
+typedef enum {
+    FFT_ALGO_BIT_REVERSE = 0,   /* 位反转重排 + 原位基4蝶形 */
+    FFT_ALGO_STOCKHAM           /* Stockham自排序 (乒乓缓冲, 无位反转, 基2/3/4/5混合) */
+} fft_algorithm_t;
+
+/**
+ * @brief FFT计划创建选项
+ */
+typedef struct {
+    fft_engine_t engine;        /* 执行引擎 */
+    fft_algorithm_t algorithm;  /* 算法变体 (Stockham目前仅支持标量引擎) */
+} fft_plan_options_t;
+
+/**
+ * @brief FFT计划
+ * 
+ * 旋转因子按基4阶段连续存放: 四分之一蝶形大小为h的阶段占3h个元素，
+ * 每组为 (W^j, W^2j, W^3j)，蝶形内循环顺序访问，不再依赖FFT_SIZE步长。
+ * 实数变换使用N/2点复数子计划(half)完成。
+ * SIMD引擎另持有实部/虚部分离(SoA)的旋转因子表和工作缓冲区。
+ * Stockham变体不使用位反转表，每级在数据与stockham_work之间乒乓读写，
+ * 各级的基依次取4、2、3、5 (stockham_radix)，基为r的一级按
+ * (W_L^p, W_L^2p, ..., W_L^(r-1)p) 逐级存放旋转因子 (L为当前子变换长度)。
+ * 非2的幂点数只能使用Stockham变体与标量引擎。
+ * 位反转变体的顶层计划另持有批量变换缓冲区，按 [元素][通道] 交织存放
+ * FFT_BATCH_LANES路数据。
+ * 注意: work、split_*、stockham_work和batch_*均为计划私有的工作缓冲区，
+ * 同一计划不可被多个线程同时执行。
+ */
+typedef struct fft_plan_s {
+    int n;                          /* 变换点数 */
+    int log2n;                      /* log2(n) (仅2的幂点数有意义) */
+    complex_t* twiddles;            /* 按基4阶段连续的旋转因子表 (不超过n个) */
+    int* bit_reverse;               /* 位反转表 (n个) */
+    struct fft_plan_s* half;        /* N/2点复数子计划 (实数变换用) */
+    complex_t* real_twiddles;       /* 实数变换旋转因子 W_N^k, k < N/2 */
+    complex_t* work;                /* N/2点工作缓冲区 (实数IFFT用) */
+    fft_engine_t engine;            /* 实际使用的执行引擎 */
+    float32_t* simd_twiddles_re;    /* SoA旋转因子实部 (按阶段分段存放) */
+    float32_t* simd_twiddles_im;    /* SoA旋转因子虚部 */
+    float32_t* split_re;            /* SoA工作缓冲区实部 (n个) */
+    float32_t* split_im;            /* SoA工作缓冲区虚部 (n个) */
+    fft_algorithm_t algorithm;      /* 算法变体 */
+    int stockham_stages;            /* Stockham级数 */
+    int stockham_radix[FFT_MAX_STAGES]; /* Stockham各级的基 (2/3/4/5) */
+    complex_t* stockham_twiddles;   /* Stockham逐级旋转因子表 */
+    complex_t* stockham_work;       /* Stockham乒乓缓冲区 (n个) */
+    float32_t* batch_re;            /* 批量变换缓冲区实部 (N/2 * FFT_BATCH_LANES个) */
+    float32_t* batch_im;            /* 批量变换缓冲区虚部 */
+} fft_plan_t;
+
 /*============================================================================
  * 函数声明
  *============================================================================*/
 
+/**
+ * @brief 创建FFT计划 (自动选择执行引擎)
+ * @param n 变换点数 (偶数 2^a * 3^b * 5^c, n >= 4)
+ * @return 计划指针，失败返回NULL
+ */
+fft_plan_t* fft_plan_create(int n);
+
+/**
+ * @brief 按选项创建FFT计划
+ * @param n 变换点数 (偶数 2^a * 3^b * 5^c, n >= 4)
+ * @param options 创建选项 (NULL表示默认选项)；请求的引擎不受支持时退化为可用的最佳引擎，
+ *                非2的幂点数总是使用Stockham变体与标量引擎
+ * @return 计划指针，失败返回NULL
+ */
+fft_plan_t* fft_plan_create_ex(int n, const fft_plan_options_t* options);
+
+/**
+ * @brief 销毁FFT计划
+ * @param plan 计划指针 (可为NULL)
+ */
+void fft_plan_destroy(fft_plan_t* plan);
+
+/**
+ * @brief 执行n点复数FFT/IFFT
+ * @param plan FFT计划
+ * @param input 输入复数数据 (n点)
+ * @param output 输出复数数据 (n点, 可与input相同)
+ * @param direction 变换方向
+ * @return 状态码
+ */
+status_t fft_plan_execute(const fft_plan_t* plan,
+                          const complex_t* input,
+                          complex_t* output,
+                          fft_direction_t direction);
+
+/**
+ * @brief 执行n点实数FFT (实数到复数)
+ * @param plan FFT计划
+ * @param input 输入实数数据 (n点)
+ * @param output 输出正频率部分 (n/2+1个频点)
+ * @return 状态码
+ */
+status_t fft_plan_execute_r2c(const fft_plan_t* plan,
+                              const float32_t* input,
+                              complex_t* output);
+
+/**
+ * @brief 执行n点实数IFFT (复数到实数)
+ * @param plan FFT计划
+ * @param input 输入正频率部分 (n/2+1个频点, DC与Nyquist只取实部)
+ * @param output 输出实数数据 (n点)
+ * @return 状态码
+ */
+status_t fft_plan_execute_c2r(const fft_plan_t* plan,
+                              const complex_t* input,
+                              float32_t* output);
+
+/**
+ * @brief 批量执行多路n点实数FFT
+ * 
+ * 每FFT_BATCH_LANES路为一组交织到SIMD通道上同时变换，
+ * 每级旋转因子对整组只加载一次。Stockham计划退化为逐路执行。
+ * 
+ * @param plan FFT计划
+ * @param inputs 各路输入实数数据指针 (每路n点)
+ * @param outputs 各路输出正频率部分指针 (每路n/2+1个频点)
+ * @param count 路数
+ * @return 状态码
+ */
+status_t fft_plan_execute_r2c_batch(const fft_plan_t* plan,
+                                    const float32_t* const* inputs,
+                                    complex_t* const* outputs,
+                                    int count);
+
+/**
+ * @brief 批量执行多路n点实数IFFT
+ * @param plan FFT计划
+ * @param inputs 各路输入正频率部分指针 (每路n/2+1个频点)
+ * @param outputs 各路输出实数数据指针 (每路n点)
+ * @param count 路数
+ * @return 状态码
+ */
+status_t fft_plan_execute_c2r_batch(const fft_plan_t* plan,
+                                    const complex_t* const* inputs,
+                                    float32_t* const* outputs,
+                                    int count);
+
+/**
+ * @brief 对音频帧的全部通道执行批量实数FFT
+ * @param plan FFT计划 (点数须等于FFT_SIZE)
+ * @param frame 输入音频帧
+ * @param result 输出FFT结果
+ * @return 状态码
+ */
+status_t fft_plan_execute_frame(const fft_plan_t* plan,
+                                const audio_frame_t* frame,
+                                fft_result_t* result);
+
+/**
+ * @brief 获取FFT_SIZE点的默认计划
+ * @return 默认计划指针 (fft_init之前为NULL)
+ */
+const fft_plan_t* fft_get_default_plan(void);
+
 /**
  * @brief 初始化FFT模块（预计算旋转因子）
  * @return 状态码
@@ -30,7 +222,7 @@ status_t fft_init(void);
 void fft_cleanup(void);
 
 /**
- * @brief 对音频帧执行实数FFT
+ * @brief 对音频帧执行实数FFT (默认计划, 全部通道批量变换)
  * @param frame 输入音频帧
  * @param result 输出FFT结果
  * @return 状态码
@@ -41,20 +233,51 @@ status_t fft_execute_real(const audio_frame_t* frame, fft_result_t* result);
  * @brief 对单通道数据执行FFT
  * @param input 输入实数数据
  * @param output 输出复数数据
- * @param n FFT点数
+ * @param n FFT点数 (须等于FFT_SIZE)
  * @return 状态码
  */
 status_t fft_forward(const float32_t* input, complex_t* output, int n);
 
+/**
+ * @brief 对单通道实数数据执行实数FFT (N/2点复数FFT打包实现)
+ * @param input 输入实数数据 (n点)
+ * @param output 输出正频率部分 (n/2+1个频点)
+ * @param n FFT点数 (须等于FFT_SIZE, 其他点数请使用fft_plan_execute_r2c)
+ * @return 状态码
+ */
+status_t fft_forward_real(const float32_t* input, complex_t* output, int n);
+
 /**
  * @brief 对复数数据执行IFFT
  * @param input 输入复数数据
  * @param output 输出复数数据
- * @param n IFFT点数
+ * @param n IFFT点数 (须等于FFT_SIZE)
  * @return 状态码
  */
 status_t fft_inverse(const complex_t* input, complex_t* output, int n);
 
+/**
+ * @brief 对正频率部分执行实数IFFT (复数到实数, 无需构造共轭对称的负频率)
+ * @param input 输入正频率部分 (n/2+1个频点, DC与Nyquist只取实部)
+ * @param output 输出实数数据 (n点)
+ * @param n IFFT点数 (须等于FFT_SIZE, 其他点数请使用fft_plan_execute_c2r)
+ * @return 状态码
+ */
+status_t fft_inverse_real(const complex_t* input, float32_t* output, int n);
+
+/**
+ * @brief 批量执行多路实数IFFT (默认计划)
+ * @param inputs 各路输入正频率部分指针 (每路n/2+1个频点)
+ * @param outputs 各路输出实数数据指针 (每路n点)
+ * @param count 路数
+ * @param n IFFT点数 (须等于FFT_SIZE)
+ * @return 状态码
+ */
+status_t fft_inverse_real_batch(const complex_t* const* inputs,
+                                float32_t* const* outputs,
+                                int count,
+                                int n);
+
 /**
  * @brief 复数乘法
  * @param a 复数a
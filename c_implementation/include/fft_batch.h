@@ -0,0 +1,37 @@
+/**
+ * @file fft_batch.h
+ * @brief 多通道批量FFT头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 该模块把FFT_BATCH_LANES路信号交织到SIMD通道上同时变换，
+ * 蝶形阶段的每个旋转因子对整组只加载一次。
+ * 批量接口 (fft_plan_execute_r2c_batch等) 声明在fft.h中，
+ * 本头文件只包含计划创建/销毁时使用的资源管理函数。
+ */
+
+#ifndef FFT_BATCH_H
+#define FFT_BATCH_H
+
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 为计划分配批量变换缓冲区（由fft_plan_create调用）
+ * @param plan FFT计划 (位反转变体的顶层计划)
+ * @return 状态码
+ */
+status_t fft_batch_plan_init(fft_plan_t* plan);
+
+/**
+ * @brief 释放计划的批量变换缓冲区
+ * @param plan FFT计划
+ */
+void fft_batch_plan_free(fft_plan_t* plan);
+
+#endif /* FFT_BATCH_H */
@@ -0,0 +1,119 @@
+/**
+ * @file fft_lags.h
+ * @brief 部分时延逆变换头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * SRP只读取 ±max_lag 范围内的GCC时延，完整的N点实数IFFT大部分输出被丢弃。
+ * 该模块只计算所需时延的输出，提供两种策略:
+ * - 完整: 实数IFFT后截取窗口
+ * - 直接: 对正频率部分直接求部分DFT
+ * 创建时按代价模型自动选择最省的策略 (也可强制指定)。
+ */
+
+#ifndef FFT_LAGS_H
+#define FFT_LAGS_H
+
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 部分时延逆变换策略
+ */
+typedef enum {
+    FFT_LAGS_AUTO = 0,      /* 按代价模型自动选择 */
+    FFT_LAGS_FULL,          /* 完整实数IFFT后截取 */
+    FFT_LAGS_DIRECT         /* 直接部分DFT */
+} fft_lag_strategy_t;
+
+/**
+ * @brief 部分时延逆变换计划
+ * 
+ * 输出为时延 -max_lag..max_lag 的 2*max_lag+1 个值 (即fftshift后的中心窗口)。
+ * 注意: 计划持有工作缓冲区，同一计划不可被多个线程同时执行。
+ */
+typedef struct {
+    int n;                          /* 实数IFFT点数 */
+    int max_lag;                    /* 最大时延 (采样点) */
+    fft_lag_strategy_t strategy;    /* 实际使用的策略 */
+    fft_plan_t* plan;               /* n点实数计划 */
+    float32_t* lag_table;           /* 直接策略: 每个时延t一行n个值 (cos, sin)(2*pi*k*t/n)交织, k < n/2 */
+    float32_t* full;                /* 完整策略: n点输出缓冲区 */
+    int band_start;                 /* 直接策略累加的频点范围 [band_start, band_end) */
+    int band_end;
+} fft_lag_plan_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 创建部分时延逆变换计划
+ * @param n 实数IFFT点数 (偶数 2^a * 3^b * 5^c, n >= 8)
+ * @param max_lag 最大时延 (1 <= max_lag < n/2)
+ * @param strategy 策略 (FFT_LAGS_AUTO表示按代价模型选择)
+ * @return 计划指针，失败返回NULL
+ */
+fft_lag_plan_t* fft_lag_plan_create(int n, int max_lag, fft_lag_strategy_t strategy);
+
+/**
+ * @brief 销毁部分时延逆变换计划
+ * @param lag_plan 计划指针 (可为NULL)
+ */
+void fft_lag_plan_destroy(fft_lag_plan_t* lag_plan);
+
+/**
+ * @brief 声明输入只在频带 [bin_lo, bin_hi] 内非零 (频带外须为零)
+ * 
+ * 直接策略只累加频带内的频点 (向外对齐到8个频点以保持AVX2向量化)，
+ * 基于FFT的策略不受影响。
+ * 
+ * @param lag_plan 计划
+ * @param bin_lo 频带下限频点
+ * @param bin_hi 频带上限频点 (含)
+ */
+void fft_lag_plan_set_band(fft_lag_plan_t* lag_plan, int bin_lo, int bin_hi);
+
+/**
+ * @brief 计算 -max_lag..max_lag 范围内的实数IFFT输出
+ * @param lag_plan 计划
+ * @param input 输入正频率部分 (n/2+1个频点, DC与Nyquist只取实部)
+ * @param output 输出 (2*max_lag+1个值, output[max_lag + t]为时延t)
+ * @return 状态码
+ */
+status_t fft_lag_plan_execute(const fft_lag_plan_t* lag_plan,
+                              const complex_t* input,
+                              float32_t* output);
+
+/**
+ * @brief 按代价模型估计各策略的开销并选择最省者
+ * @param n 实数IFFT点数
+ * @param max_lag 最大时延
+ * @return 选中的策略
+ */
+fft_lag_strategy_t fft_lags_choose_strategy(int n, int max_lag);
+
+/**
+ * @brief 估计自动选择的策略执行一次的开销
+ * 
+ * 单位为N/2点频谱上的一次标量乘加 (与其他模块的代价模型共用)。
+ * 
+ * @param n 实数IFFT点数
+ * @param max_lag 最大时延
+ * @return 估计开销
+ */
+float32_t fft_lags_estimate_cost(int n, int max_lag);
+
+/**
+ * @brief 获取策略名称（调试用）
+ * @param strategy 策略
+ * @return 策略名称字符串
+ */
+const char* fft_lags_strategy_name(fft_lag_strategy_t strategy);
+
+#endif /* FFT_LAGS_H */
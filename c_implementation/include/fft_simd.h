@@ -0,0 +1,136 @@
+/**
+ * @file fft_simd.h
+ * @brief SIMD FFT引擎头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 该模块实现x86平台的SSE/AVX2向量化FFT引擎。
+ * 引擎内部采用实部/虚部分离(SoA)的数据布局，
+ * 对外通过转换函数保持complex_t交织布局接口不变。
+ * 引擎在创建计划时根据CPU特性运行时选择，非x86平台退化为标量引擎。
+ */
+
+#ifndef FFT_SIMD_H
+#define FFT_SIMD_H
+
+#include "types.h"
+#include "config.h"
+#include "fft.h"
+
+/*============================================================================
+ * 平台检测
+ *============================================================================*/
+
+/* x86平台启用SSE/AVX2内建函数; GCC/Clang通过target属性单独编译各引擎的函数 */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FFT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FFT_TARGET_SSE
+#define FFT_TARGET_AVX2
+#else
+#define FFT_TARGET_SSE      __attribute__((target("sse2")))
+#define FFT_TARGET_AVX2     __attribute__((target("avx2,fma")))
+#endif
+#else
+#define FFT_SIMD_X86 0
+#endif
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 检测当前CPU支持的最佳FFT引擎
+ * @return FFT_ENGINE_AVX2 / FFT_ENGINE_SSE / FFT_ENGINE_SCALAR
+ */
+fft_engine_t fft_simd_best_engine(void);
+
+/**
+ * @brief 获取引擎名称（调试用）
+ * @param engine 引擎类型
+ * @return 引擎名称字符串
+ */
+const char* fft_engine_name(fft_engine_t engine);
+
+/**
+ * @brief 交织复数转换为实部/虚部分离数组
+ * @param input 输入复数数据
+ * @param re 输出实部数组
+ * @param im 输出虚部数组
+ * @param n 数据点数
+ */
+void fft_split_deinterleave(const complex_t* input, float32_t* re, float32_t* im, int n);
+
+/**
+ * @brief 实部/虚部分离数组转换为交织复数
+ * @param re 输入实部数组
+ * @param im 输入虚部数组
+ * @param output 输出复数数据
+ * @param n 数据点数
+ */
+void fft_split_interleave(const float32_t* re, const float32_t* im, complex_t* output, int n);
+
+/**
+ * @brief 为计划分配SoA旋转因子表和工作缓冲区（由fft_plan_create调用）
+ * @param plan FFT计划 (twiddles已初始化)
+ * @return 状态码
+ */
+status_t fft_simd_plan_init(fft_plan_t* plan);
+
+/**
+ * @brief 释放计划的SoA资源
+ * @param plan FFT计划
+ */
+void fft_simd_plan_free(fft_plan_t* plan);
+
+/**
+ * @brief 对分离布局数据执行n点复数FFT/IFFT (原位, 自然顺序)
+ * @param plan FFT计划 (SIMD引擎)
+ * @param re 输入/输出实部数组 (n点)
+ * @param im 输入/输出虚部数组 (n点)
+ * @param direction 变换方向
+ * @return 状态码
+ */
+status_t fft_simd_execute_split(const fft_plan_t* plan,
+                                float32_t* re,
+                                float32_t* im,
+                                fft_direction_t direction);
+
+/**
+ * @brief SIMD引擎执行n点复数FFT/IFFT (交织布局接口)
+ * @param plan FFT计划 (SIMD引擎)
+ * @param input 输入复数数据 (n点)
+ * @param output 输出复数数据 (n点, 可与input相同)
+ * @param direction 变换方向
+ * @return 状态码
+ */
+status_t fft_simd_execute(const fft_plan_t* plan,
+                          const complex_t* input,
+                          complex_t* output,
+                          fft_direction_t direction);
+
+/**
+ * @brief SIMD引擎执行n点实数FFT
+ * @param plan FFT计划 (SIMD引擎)
+ * @param input 输入实数数据 (n点)
+ * @param output 输出正频率部分 (n/2+1个频点)
+ * @return 状态码
+ */
+status_t fft_simd_execute_r2c(const fft_plan_t* plan,
+                              const float32_t* input,
+                              complex_t* output);
+
+/**
+ * @brief SIMD引擎执行n点实数IFFT
+ * @param plan FFT计划 (SIMD引擎)
+ * @param input 输入正频率部分 (n/2+1个频点)
+ * @param output 输出实数数据 (n点)
+ * @return 状态码
+ */
+status_t fft_simd_execute_c2r(const fft_plan_t* plan,
+                              const complex_t* input,
+                              float32_t* output);
+
+#endif /* FFT_SIMD_H */
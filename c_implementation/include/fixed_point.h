@@ -0,0 +1,136 @@
+/**
+ * @file fixed_point.h
+ * @brief 定点处理链头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 面向Zynq PL (HLS) 与无高速FPU处理器的定点版本 FFT -> GCC-PHAT -> SRP:
+ * - FFT: Q15基2蝶形，块浮点缩放 (每级按块最大值决定右移位数，指数累计到通道指数)
+ * - GCC-PHAT: 互功率谱归一化采用查表+一次牛顿迭代的近似倒数平方根，
+ *   只计算GCC频带内的频点 (默认与浮点处理链相同，见GCC_BAND_LOW_HZ)，
+ *   逆变换同样按级块浮点缩放，输出Q15
+ * - SRP: Q15值的32位整数累加
+ * 所有缓冲区按FFT_SIZE静态分配，运算只使用16x16位乘法与32/64位累加。
+ * 定点FFT要求FFT_SIZE为2的幂 (混合基点数下fixed_point_init返回错误)。
+ * 精度报告以output目录中浮点处理链的结果为参考，评估各阶段的量化误差。
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 初始化定点模块 (旋转因子ROM、位反转表、倒数平方根查找表)
+ * @return 状态码
+ */
+status_t fixed_point_init(void);
+
+/**
+ * @brief 释放定点模块资源
+ */
+void fixed_point_cleanup(void);
+
+/**
+ * @brief 单通道定点实数FFT
+ * 
+ * 输入先按帧最大值量化为Q15块浮点，经N/2点打包复数FFT与后处理得到正频率部分。
+ * 
+ * @param input 输入实数数据 (FFT_SIZE点)
+ * @param output 输出频点尾数 (FFT_BINS个, Q15)
+ * @param exponent 输出块指数: 频点值 = output / 2^15 * 2^exponent
+ * @return 状态码
+ */
+status_t fixed_fft_real(const float32_t* input, complex_q15_t* output, int* exponent);
+
+/**
+ * @brief 对一帧所有通道执行定点实数FFT
+ * @param frame 输入音频帧
+ * @param fft_result 输出定点FFT结果
+ * @return 状态码
+ */
+status_t fixed_fft_execute_real(const audio_frame_t* frame, fft_result_q15_t* fft_result);
+
+/**
+ * @brief 浮点FFT结果量化为块浮点格式 (每通道按最大值取指数)
+ * @param fft_result 输入浮点FFT结果
+ * @param fixed_result 输出定点FFT结果
+ */
+void fixed_fft_quantize(const fft_result_t* fft_result, fft_result_q15_t* fixed_result);
+
+/**
+ * @brief 定点FFT结果转换为浮点 (用于比较)
+ * @param fixed_result 输入定点FFT结果
+ * @param fft_result 输出浮点FFT结果
+ */
+void fixed_fft_to_float(const fft_result_q15_t* fixed_result, fft_result_t* fft_result);
+
+/**
+ * @brief 设置定点GCC-PHAT的频带 (频带外的频点不参与计算，互功率谱为0)
+ * @param f_lo 频带下限 (Hz)
+ * @param f_hi 频带上限 (Hz, <= 0 表示奈奎斯特频率)
+ * @return 状态码 (参数无效时保留原频带)
+ */
+status_t fixed_gcc_set_band(float32_t f_lo, float32_t f_hi);
+
+/**
+ * @brief 计算单个麦克风对的定点GCC-PHAT
+ * 
+ * 两个通道的块指数在PHAT归一化中抵消，不影响结果。
+ * 
+ * @param fft_ch1 通道1的定点FFT结果 (FFT_BINS个)
+ * @param fft_ch2 通道2的定点FFT结果 (FFT_BINS个)
+ * @param gcc_output 输出GCC结果 (GCC_LENGTH点, Q15, 已fftshift)
+ * @return 状态码
+ */
+status_t fixed_gcc_compute_pair(const complex_q15_t* fft_ch1,
+                                const complex_q15_t* fft_ch2,
+                                q15_t* gcc_output);
+
+/**
+ * @brief 计算所有麦克风对的定点GCC-PHAT (麦克风对顺序与gcc_phat一致)
+ * @param fft_result 输入定点FFT结果
+ * @param gcc_result 输出定点GCC结果
+ * @return 状态码
+ */
+status_t fixed_gcc_compute_all(const fft_result_q15_t* fft_result,
+                               gcc_result_q15_t* gcc_result);
+
+/**
+ * @brief 定点GCC结果转换为浮点 (用于比较)
+ * @param fixed_result 输入定点GCC结果
+ * @param gcc_result 输出浮点GCC结果
+ */
+void fixed_gcc_to_float(const gcc_result_q15_t* fixed_result, gcc_result_t* gcc_result);
+
+/**
+ * @brief 定点SRP-Map投影
+ * @param gcc_result 输入定点GCC结果
+ * @param tau_table Tau Table
+ * @param srp_result 输出定点SRP结果 (Q15累加和)
+ * @return 状态码
+ */
+status_t fixed_srp_compute(const gcc_result_q15_t* gcc_result,
+                           const tau_table_t* tau_table,
+                           srp_map_q31_t* srp_result);
+
+/**
+ * @brief 生成定点处理链相对浮点处理链的精度报告
+ * 
+ * 读取output_dir中的fft_result.bin、gcc_result.bin、srp_result.bin与tau_table.bin:
+ * - 由量化后的参考FFT计算定点GCC与SRP，评估GCC-PHAT与SRP阶段的误差
+ * - 若存在audio_data.bin，再由第0帧计算定点FFT，评估FFT阶段及端到端误差
+ * 报告各阶段的信号量化噪声比(SQNR)、最大绝对误差和峰值位置一致性，
+ * 以及定点实现的存储需求 (用于估算BRAM用量)。
+ * 
+ * @param output_dir 浮点结果所在目录
+ * @return 状态码
+ */
+status_t fixed_point_accuracy_report(const char* output_dir);
+
+#endif /* FIXED_POINT_H */
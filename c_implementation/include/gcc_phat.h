@@ -6,6 +6,22 @@
  * 
  * 该模块实现广义互相关-相位变换(GCC-PHAT)算法，
  * 用于计算麦克风对之间的时延估计。
+ * 
+ * 工作缓冲区与FFT计划归GCC上下文(gcc_ctx_t)所有: 不同上下文可在不同线程中
+ * 同时使用，同一上下文同一时刻只能被一个线程使用。gcc_phat_*接口使用模块的
+ * 默认上下文，不可重入。gcc_phat_compute_all_parallel把麦克风对分发给线程池，
+ * 每个工作线程使用自己的上下文。
+ * 
+ * 频域加权默认为PHAT，可按上下文在运行时切换为PHAT-β、SCOT或ROTH (见gcc_weight.h)。
+ * 
+ * 可按上下文把GCC限制在频带 [f_lo, f_hi] 内 (如语音的100-8000 Hz)，并可附加
+ * 逐频点的加权掩码。频带外的频点在加权与互功率谱循环中直接跳过而不是算完再清零，
+ * 其互功率谱始终为0；加权频谱只在频带内写入。
+ * 
+ * 麦克风对可以只启用一部分: 按掩码指定、按基线长度取最长的若干对，或按阵列几何贪心
+ * 选取；失效的麦克风可在运行时屏蔽，含该麦克风的对随之停用。GCC、SRP投影与频域引擎
+ * 都只遍历启用的麦克风对 (gcc_phat_get_active_pairs)，gcc_result中停用对的行不更新。
+ * 只被停用对使用的通道也不做加权。启用集合为模块全局状态，只能在没有计算进行时修改。
  */
 
 #ifndef GCC_PHAT_H
@@ -13,6 +29,38 @@
 
 #include "types.h"
 #include "config.h"
+#include "gcc_weight.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 完整GCC的逆变换方式 (启用时延窗口时不使用)
+ */
+typedef enum {
+    GCC_IFFT_REAL = 0,      /* 每个麦克风对一次实数IFFT (N/2点打包，按组批量执行) */
+    GCC_IFFT_PAIRED         /* 两对合一: 互功率谱打包为A + jB，一次N点复数IFFT得到两行GCC */
+} gcc_ifft_mode_t;
+
+/**
+ * @brief 麦克风对选取方式
+ */
+typedef enum {
+    GCC_PAIRS_ALL = 0,      /* 全部可用的麦克风对 */
+    GCC_PAIRS_LONGEST,      /* 基线最长的max_pairs对 */
+    GCC_PAIRS_GREEDY        /* 按几何贪心选取: 每步选使基线信息矩阵行列式增加最多的对 */
+} gcc_pair_select_t;
+
+/**
+ * @brief GCC上下文 (不透明类型): 私有FFT计划、时延窗口计划与全部工作缓冲区
+ */
+typedef struct gcc_ctx gcc_ctx_t;
+
+/**
+ * @brief 并行GCC线程池 (不透明类型): 工作线程与每个线程的GCC上下文
+ */
+typedef struct gcc_pool gcc_pool_t;
 
 /*============================================================================
  * 函数声明
@@ -30,7 +78,134 @@ status_t gcc_phat_init(void);
 void gcc_phat_cleanup(void);
 
 /**
- * @brief 计算所有麦克风对的GCC-PHAT
+ * @brief 设置GCC时延窗口，之后只计算 ±max_lag 范围内的GCC值
+ * 
+ * SRP只读取tau表覆盖的时延 (见srp_map_get_max_tau)，其余时延的IFFT输出都被丢弃。
+ * 窗口按代价模型选择部分逆变换策略 (见fft_lags.h)；若完整的批量IFFT更省则不启用。
+ * 启用后gcc_result中窗口以外的值不再更新。
+ * 
+ * @param max_lag 最大时延 (采样点, 小于GCC_LENGTH/2)；<= 0 表示恢复完整GCC
+ * @return 状态码
+ */
+status_t gcc_phat_set_max_lag(int max_lag);
+
+/**
+ * @brief 设置完整GCC的逆变换方式
+ * 
+ * 两对合一模式利用GCC输出为实数: 两个麦克风对的互功率谱A、B组成
+ * Hermitian组合 A + jB，一次N点复数IFFT的实部与虚部分别为两行GCC，
+ * 66个逆变换减为33个，结果与逐对实数IFFT一致 (仅有舍入差异)。
+ * 
+ * @param mode 逆变换方式
+ * @return 状态码
+ */
+status_t gcc_phat_set_ifft_mode(gcc_ifft_mode_t mode);
+
+/**
+ * @brief 设置默认上下文的频域加权 (清除SCOT平滑状态)
+ * @param type 加权类型
+ * @param param PHAT-β的β或SCOT的平滑系数α，其他类型忽略
+ * @return 状态码 (参数无效时保留原加权)
+ */
+status_t gcc_phat_set_weighting(gcc_weighting_t type, float32_t param);
+
+/**
+ * @brief 获取默认上下文的频域加权类型
+ * @return 加权类型
+ */
+gcc_weighting_t gcc_phat_get_weighting(void);
+
+/**
+ * @brief 按默认上下文的加权处理各通道频谱 (gcc_phat_whiten_spectrum的可配置版本)
+ * 
+ * 输出可直接用于gcc_phat_compute_all_whitened、紧凑GCC与融合SRP投影。
+ * ROTH对两个通道不对称，无法表示为单一的加权频谱，返回错误。
+ * 
+ * @param fft_result 输入FFT结果
+ * @param weighted 输出加权频谱 (可与fft_result相同)
+ * @return 状态码
+ */
+status_t gcc_phat_weight_spectrum(const fft_result_t* fft_result, fft_result_t* weighted);
+
+/**
+ * @brief 把频带换算为FFT频点范围 (只保留频率完全落在频带内的频点)
+ * @param f_lo 频带下限 (Hz, >= 0)
+ * @param f_hi 频带上限 (Hz, <= 0 表示奈奎斯特频率)
+ * @param bin_lo 输出起始频点
+ * @param bin_hi 输出结束频点 (含)
+ * @return 状态码 (频带无效或不含任何频点时返回错误)
+ */
+status_t gcc_phat_band_to_bins(float32_t f_lo, float32_t f_hi, int* bin_lo, int* bin_hi);
+
+/**
+ * @brief 设置默认上下文的GCC频带
+ * 
+ * 频带外的频点不参与加权与互功率谱计算。时延窗口的直接求和策略只累加频带内的
+ * 频点，基于FFT的策略与完整GCC的逆变换仍处理整个频谱 (频带外为0)。
+ * 
+ * @param f_lo 频带下限 (Hz)
+ * @param f_hi 频带上限 (Hz, <= 0 表示奈奎斯特频率)
+ * @return 状态码 (参数无效时保留原频带)
+ */
+status_t gcc_phat_set_band(float32_t f_lo, float32_t f_hi);
+
+/**
+ * @brief 设置默认上下文的逐频点加权掩码 (乘在频带内的互功率谱上)
+ * @param mask FFT_BINS个权值 (拷贝保存)，NULL表示取消掩码
+ * @return 状态码
+ */
+status_t gcc_phat_set_band_mask(const float32_t* mask);
+
+/**
+ * @brief 获取默认上下文的GCC频点范围
+ * @param bin_lo 输出起始频点
+ * @param bin_hi 输出结束频点 (含)
+ */
+void gcc_phat_get_band(int* bin_lo, int* bin_hi);
+
+/**
+ * @brief 获取默认上下文的逐频点加权掩码
+ * @return FFT_BINS个权值，未设置掩码时返回NULL
+ */
+const float32_t* gcc_phat_get_band_mask(void);
+
+/**
+ * @brief 获取完整GCC的逆变换方式
+ * @return 逆变换方式
+ */
+gcc_ifft_mode_t gcc_phat_get_ifft_mode(void);
+
+/**
+ * @brief 获取当前生效的时延窗口
+ * @return 最大时延，0表示计算完整GCC
+ */
+int gcc_phat_get_max_lag(void);
+
+/**
+ * @brief 获取当前时延窗口使用的逆变换策略名称（调试用）
+ * @return 策略名称字符串
+ */
+const char* gcc_phat_lag_strategy_name(void);
+
+/**
+ * @brief 白化各通道频谱 (PHAT加权的通道级分解)
+ * 
+ * 输出 W(f) = X(f) / |X(f)|，幅度过小的频点置零。
+ * 由于 |X1 * conj(X2)| = |X1| * |X2|，白化后各麦克风对的互功率谱
+ * W1 * conj(W2) 即为PHAT加权互功率谱，每帧只需NUM_CHANNELS次归一化。
+ * 
+ * @param fft_result 输入FFT结果
+ * @param whitened 输出白化频谱 (可与fft_result相同，原位执行)
+ * @return 状态码
+ */
+status_t gcc_phat_whiten_spectrum(const fft_result_t* fft_result,
+                                  fft_result_t* whitened);
+
+/**
+ * @brief 计算所有启用的麦克风对的GCC-PHAT
+ * 
+ * 先按默认上下文的加权处理各通道频谱 (默认PHAT)，再对各麦克风对求互功率谱与逆变换。
+ * 
  * @param fft_result 输入FFT结果
  * @param gcc_result 输出GCC结果
  * @return 状态码
@@ -38,8 +213,272 @@ void gcc_phat_cleanup(void);
 status_t gcc_phat_compute_all(const fft_result_t* fft_result, 
                                gcc_result_t* gcc_result);
 
+/**
+ * @brief 由白化频谱计算所有麦克风对的GCC-PHAT
+ * 
+ * 每个麦克风对的互功率谱只是一次复数乘法 W1 * conj(W2)，不再逐频点开方和除法。
+ * 
+ * @param whitened 白化频谱 (gcc_phat_whiten_spectrum的输出)
+ * @param gcc_result 输出GCC结果
+ * @return 状态码
+ */
+status_t gcc_phat_compute_all_whitened(const fft_result_t* whitened,
+                                       gcc_result_t* gcc_result);
+
+/**
+ * @brief 初始化紧凑GCC结构
+ * 
+ * 紧凑GCC每对只保存 -max_lag..max_lag 的 2*max_lag+1 个时延，各对按行连续存放，
+ * 66对的工作集只有几KB (完整gcc_result_t约1MB)。max_lag通常取srp_map_get_aperture_tau()。
+ * 
+ * @param compact 紧凑GCC结构
+ * @param max_lag 最大时延 (1 <= max_lag <= MAX_TAU_SAMPLES)
+ * @return 状态码
+ */
+status_t gcc_phat_compact_init(gcc_compact_t* compact, int max_lag);
+
+/**
+ * @brief 由白化频谱计算所有启用的麦克风对的紧凑GCC
+ * 
+ * 逆变换按紧凑结构的max_lag创建部分时延计划 (见fft_lags.h)，
+ * 每对的窗口直接写入紧凑行，不经过完整GCC缓冲区。
+ * 
+ * @param whitened 白化频谱 (gcc_phat_whiten_spectrum的输出)
+ * @param compact 输出紧凑GCC (须先经gcc_phat_compact_init初始化)
+ * @return 状态码
+ */
+status_t gcc_phat_compute_compact(const fft_result_t* whitened,
+                                  gcc_compact_t* compact);
+
+/**
+ * @brief 由白化频谱计算单个麦克风对 -max_lag..max_lag 范围内的GCC
+ * 
+ * 紧凑GCC与融合GCC->SRP投影的逐对内核，部分时延计划在max_lag变化时重建。
+ * 
+ * @param whitened 白化频谱 (gcc_phat_whiten_spectrum的输出)
+ * @param pair 麦克风对索引 (0-65)
+ * @param max_lag 最大时延 (1 <= max_lag < GCC_LENGTH/2)
+ * @param lags 输出 (2*max_lag+1个值, lags[max_lag + tau]为时延tau)
+ * @return 状态码
+ */
+status_t gcc_phat_compute_pair_lags(const fft_result_t* whitened,
+                                    int pair,
+                                    int max_lag,
+                                    float32_t* lags);
+
+/*============================================================================
+ * GCC上下文 (可重入接口)
+ *============================================================================*/
+
+/**
+ * @brief 创建GCC上下文 (须先调用gcc_phat_init)
+ * 
+ * 上下文约占400KB，包含私有的FFT_SIZE点FFT计划，默认计算完整GCC、实数IFFT方式。
+ * 
+ * @return 上下文指针，失败返回NULL
+ */
+gcc_ctx_t* gcc_ctx_create(void);
+
+/**
+ * @brief 销毁GCC上下文
+ * @param ctx 上下文 (可为NULL)
+ */
+void gcc_ctx_destroy(gcc_ctx_t* ctx);
+
+/**
+ * @brief 设置上下文的GCC时延窗口 (语义同gcc_phat_set_max_lag)
+ * @param ctx 上下文
+ * @param max_lag 最大时延；<= 0 表示恢复完整GCC
+ * @return 状态码
+ */
+status_t gcc_ctx_set_max_lag(gcc_ctx_t* ctx, int max_lag);
+
+/**
+ * @brief 设置上下文完整GCC的逆变换方式 (语义同gcc_phat_set_ifft_mode)
+ * @param ctx 上下文
+ * @param mode 逆变换方式
+ * @return 状态码
+ */
+status_t gcc_ctx_set_ifft_mode(gcc_ctx_t* ctx, gcc_ifft_mode_t mode);
+
+/**
+ * @brief 设置上下文的频域加权 (语义同gcc_phat_set_weighting)
+ * @param ctx 上下文
+ * @param type 加权类型
+ * @param param 加权参数
+ * @return 状态码
+ */
+status_t gcc_ctx_set_weighting(gcc_ctx_t* ctx, gcc_weighting_t type, float32_t param);
+
+/**
+ * @brief 获取上下文的频域加权类型
+ * @param ctx 上下文
+ * @return 加权类型
+ */
+gcc_weighting_t gcc_ctx_get_weighting(const gcc_ctx_t* ctx);
+
+/**
+ * @brief 按上下文的加权处理各通道频谱 (语义同gcc_phat_weight_spectrum)
+ * @param ctx 上下文
+ * @param fft_result 输入FFT结果
+ * @param weighted 输出加权频谱
+ * @return 状态码
+ */
+status_t gcc_ctx_weight_spectrum(gcc_ctx_t* ctx, const fft_result_t* fft_result,
+                                 fft_result_t* weighted);
+
+/**
+ * @brief 设置上下文的GCC频带 (语义同gcc_phat_set_band)
+ * @param ctx 上下文
+ * @param f_lo 频带下限 (Hz)
+ * @param f_hi 频带上限 (Hz, <= 0 表示奈奎斯特频率)
+ * @return 状态码
+ */
+status_t gcc_ctx_set_band(gcc_ctx_t* ctx, float32_t f_lo, float32_t f_hi);
+
+/**
+ * @brief 设置上下文的逐频点加权掩码 (语义同gcc_phat_set_band_mask)
+ * @param ctx 上下文
+ * @param mask FFT_BINS个权值，NULL表示取消掩码
+ * @return 状态码
+ */
+status_t gcc_ctx_set_band_mask(gcc_ctx_t* ctx, const float32_t* mask);
+
+/**
+ * @brief 获取上下文的GCC频点范围
+ * @param ctx 上下文
+ * @param bin_lo 输出起始频点
+ * @param bin_hi 输出结束频点 (含)
+ */
+void gcc_ctx_get_band(const gcc_ctx_t* ctx, int* bin_lo, int* bin_hi);
+
+/**
+ * @brief 获取上下文的逐频点加权掩码
+ * @param ctx 上下文
+ * @return FFT_BINS个权值，未设置掩码时返回NULL
+ */
+const float32_t* gcc_ctx_get_band_mask(const gcc_ctx_t* ctx);
+
+/**
+ * @brief 使用上下文的FFT计划对一帧所有通道执行实数FFT
+ * @param ctx 上下文
+ * @param frame 输入音频帧
+ * @param fft_result 输出FFT结果
+ * @return 状态码
+ */
+status_t gcc_ctx_execute_fft(gcc_ctx_t* ctx, const audio_frame_t* frame, fft_result_t* fft_result);
+
+/**
+ * @brief 使用上下文计算所有麦克风对的GCC-PHAT (语义同gcc_phat_compute_all)
+ * @param ctx 上下文
+ * @param fft_result 输入FFT结果
+ * @param gcc_result 输出GCC结果
+ * @return 状态码
+ */
+status_t gcc_ctx_compute_all(gcc_ctx_t* ctx, const fft_result_t* fft_result,
+                             gcc_result_t* gcc_result);
+
+/**
+ * @brief 使用上下文由白化频谱计算所有麦克风对的GCC-PHAT
+ * @param ctx 上下文
+ * @param whitened 白化频谱
+ * @param gcc_result 输出GCC结果
+ * @return 状态码
+ */
+status_t gcc_ctx_compute_all_whitened(gcc_ctx_t* ctx, const fft_result_t* whitened,
+                                      gcc_result_t* gcc_result);
+
+/**
+ * @brief 使用上下文计算单个麦克风对 -max_lag..max_lag 范围内的GCC
+ * @param ctx 上下文
+ * @param whitened 白化频谱
+ * @param pair 麦克风对索引 (0-65)
+ * @param max_lag 最大时延
+ * @param lags 输出 (2*max_lag+1个值)
+ * @return 状态码
+ */
+status_t gcc_ctx_compute_pair_lags(gcc_ctx_t* ctx, const fft_result_t* whitened,
+                                   int pair, int max_lag, float32_t* lags);
+
+/*============================================================================
+ * 并行GCC
+ *============================================================================*/
+
+/**
+ * @brief 创建并行GCC线程池 (须先调用gcc_phat_init)
+ * @param num_threads 工作线程数 (<= 0 表示使用处理器核数)
+ * @return 线程池指针，失败返回NULL
+ */
+gcc_pool_t* gcc_pool_create(int num_threads);
+
+/**
+ * @brief 销毁并行GCC线程池
+ * @param pool 线程池 (可为NULL)
+ */
+void gcc_pool_destroy(gcc_pool_t* pool);
+
+/**
+ * @brief 获取并行GCC的工作线程数
+ * @param pool 线程池
+ * @return 工作线程数
+ */
+int gcc_pool_size(const gcc_pool_t* pool);
+
+/**
+ * @brief 设置所有工作线程上下文的GCC时延窗口
+ * @param pool 线程池
+ * @param max_lag 最大时延；<= 0 表示恢复完整GCC
+ * @return 状态码
+ */
+status_t gcc_pool_set_max_lag(gcc_pool_t* pool, int max_lag);
+
+/**
+ * @brief 设置所有工作线程上下文的GCC频带
+ * @param pool 线程池
+ * @param f_lo 频带下限 (Hz)
+ * @param f_hi 频带上限 (Hz, <= 0 表示奈奎斯特频率)
+ * @return 状态码
+ */
+status_t gcc_pool_set_band(gcc_pool_t* pool, float32_t f_lo, float32_t f_hi);
+
+/**
+ * @brief 设置所有工作线程上下文的逐频点加权掩码
+ * @param pool 线程池
+ * @param mask FFT_BINS个权值，NULL表示取消掩码
+ * @return 状态码
+ */
+status_t gcc_pool_set_band_mask(gcc_pool_t* pool, const float32_t* mask);
+
+/**
+ * @brief 设置并行GCC的频域加权 (清除SCOT平滑状态)
+ * @param pool 线程池
+ * @param type 加权类型
+ * @param param 加权参数
+ * @return 状态码
+ */
+status_t gcc_pool_set_weighting(gcc_pool_t* pool, gcc_weighting_t type, float32_t param);
+
+/**
+ * @brief 并行计算所有麦克风对的GCC-PHAT
+ * 
+ * 先按通道并行加权，再把启用的麦克风对分块分发给工作线程: 完整GCC每块为一组
+ * 批量IFFT (FFT_BATCH_LANES对)，启用时延窗口时每块1对。各麦克风对写入
+ * gcc_result的不同行，结果与串行接口逐位一致。同一线程池不可被多个线程同时使用。
+ * 
+ * @param pool 线程池
+ * @param fft_result 输入FFT结果
+ * @param gcc_result 输出GCC结果
+ * @return 状态码
+ */
+status_t gcc_phat_compute_all_parallel(gcc_pool_t* pool,
+                                       const fft_result_t* fft_result,
+                                       gcc_result_t* gcc_result);
+
 /**
  * @brief 计算单个麦克风对的GCC-PHAT
+ * 
+ * 使用默认上下文的加权；该接口不区分通道，SCOT使用瞬时自功率谱 (与PHAT相同)。
+ * 
  * @param fft_ch1 通道1的FFT结果
  * @param fft_ch2 通道2的FFT结果
  * @param gcc_output 输出GCC结果
@@ -64,6 +503,53 @@ void gcc_phat_get_mic_pair(int pair_index, int* mic1, int* mic2);
  */
 void gcc_phat_init_mic_pairs(void);
 
+/**
+ * @brief 按阵列几何选取启用的麦克风对 (只在未屏蔽的麦克风之间选取)
+ * 
+ * GCC_PAIRS_LONGEST按基线长度 |p1 - p2| 排序。GCC_PAIRS_GREEDY从空集合开始，
+ * 每步加入使信息矩阵 F = eps*I + sum b*b^T (b为基线向量) 行列式增加最多的对，
+ * 即 b^T F^-1 b 最大者: 先取最长基线，之后优先补足覆盖不足的方向。
+ * 
+ * @param method 选取方式
+ * @param mic_positions 麦克风位置 (GCC_PAIRS_ALL时可为NULL)
+ * @param max_pairs 最多启用的对数 (<= 0 或不少于可用对数时启用全部可用对)
+ * @return 状态码
+ */
+status_t gcc_phat_select_pairs(gcc_pair_select_t method, const mic_position_t* mic_positions,
+                               int max_pairs);
+
+/**
+ * @brief 按掩码设置启用的麦克风对 (与麦克风屏蔽取交集)
+ * @param mask NUM_MIC_PAIRS个标志 (非0为启用)，NULL表示全部启用
+ * @return 状态码 (结果没有任何可用对时返回错误并保留原设置)
+ */
+status_t gcc_phat_set_pair_mask(const int* mask);
+
+/**
+ * @brief 屏蔽失效的麦克风，含该麦克风的对随之停用
+ * 
+ * 已选取的麦克风对集合保持不变，恢复麦克风后对应的对重新启用；
+ * 需要在剩余麦克风中重新补足对数时再调用gcc_phat_select_pairs。
+ * 
+ * @param mask NUM_CHANNELS个标志 (非0为正常)，NULL表示全部正常
+ * @return 状态码 (结果没有任何可用对时返回错误并保留原设置)
+ */
+status_t gcc_phat_set_mic_mask(const int* mask);
+
+/**
+ * @brief 获取启用的麦克风对列表 (按对索引升序)
+ * @param pairs 输出列表指针 (模块内部数组，下次修改启用集合前有效)，可为NULL
+ * @return 启用的对数
+ */
+int gcc_phat_get_active_pairs(const int** pairs);
+
+/**
+ * @brief 麦克风对是否启用
+ * @param pair_index 麦克风对索引 (0-65)
+ * @return 1表示启用
+ */
+int gcc_phat_pair_is_active(int pair_index);
+
 /**
  * @brief 打印GCC结果信息（调试用）
  * @param gcc_result GCC结果
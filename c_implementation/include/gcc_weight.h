@@ -0,0 +1,137 @@
+/**
+ * @file gcc_weight.h
+ * @brief GCC频域加权函数头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 广义互相关的加权函数都可以分解为通道级缩放: 互功率谱
+ * G12 = X1 * conj(X2) * psi 中的 psi 只依赖两个通道各自的自功率谱，
+ * 因此每帧先算出各通道的 |X|^2 (自功率谱缓存)，再按加权类型得到缩放后的频谱
+ * W = X * s(|X|^2)，各麦克风对的互功率谱只剩 W1 * conj(W2) 一次复数乘法:
+ * - PHAT:   s = 1 / |X|              psi = 1 / (|X1| |X2|)
+ * - PHAT-β: s = 1 / |X|^β            psi = 1 / (|X1| |X2|)^β，β=1即PHAT，β=0为普通互相关
+ * - SCOT:   s = 1 / sqrt(P)          psi = 1 / sqrt(P11 P22)，P为帧间递归平滑的自功率谱
+ * - ROTH:   第一个通道 s = 1 / P，第二个通道不加权   psi = 1 / P11
+ * ROTH对两个通道不对称，第二个通道直接使用原始频谱 (见gcc_weight_is_symmetric)。
+ * 
+ * 加权类型在gcc_weight_init中绑定到内核函数 (AVX2或标量，运行时按CPU选择)，
+ * 运算时没有逐频点的类型分支。
+ */
+
+#ifndef GCC_WEIGHT_H
+#define GCC_WEIGHT_H
+
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief GCC加权类型
+ */
+typedef enum {
+    GCC_WEIGHT_PHAT = 0,    /* 相位变换 (默认) */
+    GCC_WEIGHT_PHAT_BETA,   /* 部分白化 PHAT-β (参数为β) */
+    GCC_WEIGHT_SCOT,        /* 平滑相干变换 (参数为自功率谱平滑系数α) */
+    GCC_WEIGHT_ROTH,        /* Roth处理器 */
+    GCC_WEIGHT_COUNT
+} gcc_weighting_t;
+
+/**
+ * @brief 自功率谱内核: power = alpha * power + (1 - alpha) * |x|^2
+ */
+typedef void (*gcc_power_kernel_t)(const complex_t* x, float32_t* power, float32_t alpha, int n);
+
+/**
+ * @brief 缩放内核: w = x * s(power)，自功率谱低于阈值的频点置零
+ */
+typedef void (*gcc_scale_kernel_t)(const complex_t* x, const float32_t* power,
+                                   float32_t exponent, complex_t* w, int n);
+
+/**
+ * @brief 加权配置 (内核函数在初始化时绑定)
+ */
+typedef struct {
+    gcc_weighting_t type;
+    float32_t param;                /* 加权参数 (β或α，其他类型为0) */
+    float32_t alpha;                /* 自功率谱平滑系数 (仅SCOT非0) */
+    float32_t exponent;             /* 缩放指数 -β/2 (仅PHAT-β使用) */
+    int symmetric;                  /* 两个通道是否使用相同加权 */
+    gcc_power_kernel_t power_fn;    /* |x|^2 (忽略alpha) */
+    gcc_power_kernel_t smooth_fn;   /* 递归平滑 */
+    gcc_scale_kernel_t scale_fn;
+} gcc_weight_t;
+
+/**
+ * @brief 各通道的自功率谱缓存 (SCOT的帧间平滑状态)
+ */
+typedef struct {
+    int primed[NUM_CHANNELS];                   /* 该通道是否已有平滑值 */
+    float32_t power[NUM_CHANNELS][FFT_BINS];    /* 自功率谱 */
+} gcc_weight_cache_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 初始化加权配置
+ * @param weight 加权配置
+ * @param type 加权类型
+ * @param param PHAT-β的β (0 <= β <= 2)；SCOT的平滑系数α (0 <= α < 1, 0表示不平滑)；其他类型忽略
+ * @return 状态码
+ */
+status_t gcc_weight_init(gcc_weight_t* weight, gcc_weighting_t type, float32_t param);
+
+/**
+ * @brief 两个通道是否使用相同加权 (ROTH为0，第二个通道使用原始频谱)
+ * @param weight 加权配置
+ * @return 1表示对称
+ */
+int gcc_weight_is_symmetric(const gcc_weight_t* weight);
+
+/**
+ * @brief 清除自功率谱缓存 (新的数据流开始时调用)
+ * @param cache 自功率谱缓存
+ */
+void gcc_weight_cache_reset(gcc_weight_cache_t* cache);
+
+/**
+ * @brief 加权一个通道的频谱并更新该通道的自功率谱缓存
+ * 
+ * 只处理 [first_bin, first_bin + num_bins) 范围内的频点 (GCC频带)，范围外的
+ * 输出与缓存不写入。不同通道只访问缓存中各自的行，可在不同线程中同时处理。
+ * 
+ * @param weight 加权配置
+ * @param cache 自功率谱缓存
+ * @param channel 通道索引
+ * @param x 输入频谱 (FFT_BINS个频点)
+ * @param w 输出加权频谱 (可与x相同)
+ * @param first_bin 起始频点
+ * @param num_bins 频点数
+ */
+void gcc_weight_apply_channel(const gcc_weight_t* weight, gcc_weight_cache_t* cache,
+                              int channel, const complex_t* x, complex_t* w,
+                              int first_bin, int num_bins);
+
+/**
+ * @brief 无状态加权 (SCOT退化为使用瞬时自功率谱，即PHAT)
+ * @param weight 加权配置
+ * @param x 输入频谱
+ * @param power 自功率谱工作缓冲区 (n个)
+ * @param w 输出加权频谱 (可与x相同)
+ * @param n 频点数
+ */
+void gcc_weight_apply(const gcc_weight_t* weight, const complex_t* x,
+                      float32_t* power, complex_t* w, int n);
+
+/**
+ * @brief 获取加权类型名称（调试用）
+ * @param type 加权类型
+ * @return 名称字符串
+ */
+const char* gcc_weighting_name(gcc_weighting_t type);
+
+#endif /* GCC_WEIGHT_H */
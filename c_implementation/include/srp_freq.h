@@ -0,0 +1,132 @@
+/**
+ * @file srp_freq.h
+ * @brief 频域SRP引擎头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 不经过GCC与Tau Table查表，直接在频域求各网格点的导向响应功率:
+ *   P(g) = sum_pair sum_k s_k / N * Re{ W1(k) conj(W2(k)) e^(j*2*pi*k*tau(pair, g)/N) }
+ * 其中s_k为实数IFFT的共轭对称权重 (DC与Nyquist为1，其余为2)。时延取整时结果与
+ * GCC + 查表相同，时延可为小数 (不受采样点量化影响)。
+ * 
+ * 把每帧的互功率谱排成长度D = 2 * 频点数 * 启用的麦克风对数的实向量c，预计算的导向矩阵
+ * A (网格点数 x D) 每行为 (cos, -sin) 交织的导向向量，则 P = A * c；多帧时c组成矩阵，
+ * 整体为一次分块SGEMM (沿D分块使数据常驻缓存，寄存器内按4个网格点 x 2帧分块)。
+ * 
+ * 运算量与网格点数 x 频点数成正比，而GCC + 查表与网格点数基本无关，
+ * 只在网格点少 (如细化搜索) 或频带窄时占优；srp_freq_choose_engine按代价模型选择。
+ */
+
+#ifndef SRP_FREQ_H
+#define SRP_FREQ_H
+
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief SRP计算路径
+ */
+typedef enum {
+    SRP_ENGINE_AUTO = 0,    /* 按代价模型选择 */
+    SRP_ENGINE_LOOKUP,      /* 孔径窗口GCC + Tau Table查表 (融合投影) */
+    SRP_ENGINE_FREQ         /* 频域导向矩阵SGEMM */
+} srp_engine_t;
+
+/**
+ * @brief 频域SRP计划 (不透明类型): 导向矩阵与互功率谱工作缓冲区
+ * 
+ * 计划持有工作缓冲区，同一计划不可被多个线程同时执行。
+ */
+typedef struct srp_freq_plan srp_freq_plan_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 创建频域SRP计划 (须先调用gcc_phat_init以确定麦克风对)
+ * 
+ * 计划只包含创建时启用的麦克风对 (见gcc_phat_get_active_pairs)，并保存创建时的频点加权掩码
+ * (gcc_phat_get_band_mask)，打包互功率谱时与GCC路径一样逐频点相乘。导向矩阵大小为
+ * num_points x 2 * (bin_hi - bin_lo + 1) * 启用对数 个float，超过SRP_FREQ_MAX_STEER_MB时返回NULL。
+ * 
+ * @param tau 全部NUM_MIC_PAIRS对在各网格点的时延 (采样点，可为小数)，按 [pair][point] 排列，
+ *            只读取启用的对
+ * @param num_points 网格点数
+ * @param bin_lo 频带起始频点
+ * @param bin_hi 频带结束频点 (含)
+ * @return 计划指针，失败返回NULL
+ */
+srp_freq_plan_t* srp_freq_plan_create(const float32_t* tau, int num_points, int bin_lo, int bin_hi);
+
+/**
+ * @brief 销毁频域SRP计划
+ * @param plan 计划指针 (可为NULL)
+ */
+void srp_freq_plan_destroy(srp_freq_plan_t* plan);
+
+/**
+ * @brief 获取计划的网格点数
+ * @param plan 计划
+ * @return 网格点数
+ */
+int srp_freq_plan_num_points(const srp_freq_plan_t* plan);
+
+/**
+ * @brief 计划是否与当前GCC设置一致 (不一致时应重建计划)
+ * 
+ * 比较启用的麦克风对、GCC频带 (gcc_phat_get_band) 与频点加权掩码。
+ * 
+ * @param plan 计划
+ * @return 1表示一致
+ */
+int srp_freq_plan_is_current(const srp_freq_plan_t* plan);
+
+/**
+ * @brief 由一帧加权频谱计算所有网格点的SRP
+ * @param plan 计划
+ * @param whitened 加权频谱 (gcc_phat_weight_spectrum的输出，只读取计划的频带)
+ * @param srp_out 输出 (num_points个值)
+ * @return 状态码
+ */
+status_t srp_freq_compute(srp_freq_plan_t* plan, const fft_result_t* whitened, float32_t* srp_out);
+
+/**
+ * @brief 由多帧加权频谱计算所有网格点的SRP (导向矩阵在各帧间复用)
+ * @param plan 计划
+ * @param whitened 加权频谱数组 (num_frames帧)
+ * @param num_frames 帧数
+ * @param srp_out 输出，按 [frame][point] 排列
+ * @return 状态码
+ */
+status_t srp_freq_compute_batch(srp_freq_plan_t* plan, const fft_result_t* whitened,
+                                int num_frames, float32_t* srp_out);
+
+/**
+ * @brief 按代价模型估计每帧开销并选择SRP计算路径
+ * 
+ * 按当前启用的麦克风对数估计。查表路径: 各麦克风对的孔径窗口GCC (fft_lags_estimate_cost) 与查表累加；
+ * 频域路径: 导向矩阵乘法，导向矩阵超出缓存时按帧数摊销其读取开销，
+ * 超过SRP_FREQ_MAX_STEER_MB时不可用。开销单位与fft_lags相同。
+ * 
+ * @param num_points 网格点数
+ * @param bin_lo 频带起始频点
+ * @param bin_hi 频带结束频点 (含)
+ * @param max_lag 查表路径的孔径时延
+ * @param num_frames 每次计算的帧数 (>= 1)
+ * @return SRP_ENGINE_LOOKUP或SRP_ENGINE_FREQ
+ */
+srp_engine_t srp_freq_choose_engine(int num_points, int bin_lo, int bin_hi, int max_lag, int num_frames);
+
+/**
+ * @brief 获取SRP计算路径名称（调试用）
+ * @param engine 计算路径
+ * @return 名称字符串
+ */
+const char* srp_engine_name(srp_engine_t engine);
+
+#endif /* SRP_FREQ_H */
@@ -0,0 +1,217 @@
+/**
+ * @file srp_ico.h
+ * @brief 二十面体SRP-Map模块头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 生成icoCNN使用的二十面体网格 (icoCNN.icosahedral_grid_coordinates) 并直接按图表布局
+ * [5][2^r][2^(r+1)] 输出SRP-PHAT图，与Python的SRP_icosahedral_map逐点对应:
+ * - 网格点: 5个图表，每个图表由4个三角面拼成平行四边形，图表内整数坐标 (h, w) 经所在面的
+ *   仿射变换映射到二十面体表面 (与Python相同，不投影到单位球面)
+ * - 时延: 远场模型 tau = g · (p2 - p1) / c * fs，取最近的整数采样点 (等距时取较小者)
+ * - 投影: Python对全部N x N个有序麦克风组合求和，(m, n) 与 (n, m) 取值相同，对角项为
+ *   各通道零时延的PHAT自相关 (= 1)，即 P = 2 * sum_pair GCC + 通道数
+ * - 归一化: P += 1e-12，再除以全图最大值
+ * 
+ * 只累加启用的麦克风对 (见gcc_phat_get_active_pairs)，对角项按启用的对用到的通道计数。
+ * 
+ * 时延表有两种布局 (srp_ico_plan_set_layout):
+ * - 按对排列: [pair][point] 的int32完整GCC索引，逐对顺序读取时延行累加到整张图
+ * - 按网格点排列: [point][pair] 的int16偏移，指向只含孔径窗口的紧凑GCC
+ *   (偏移已加上该对的行首)，每个网格点的启用对连续存放并补齐到8的倍数，
+ *   AVX2下每8对一次gather累加，网格点多 (r = 4) 时查表不再按行跨步
+ * 计划在CPU支持AVX2时默认按网格点排列，否则按对排列 (标量gather慢于逐对累加)。
+ * 
+ * 只需要声源方向 (不需要整张图) 时可用层次搜索 (srp_ico_search_run): 计算r = 1的全部
+ * 40个网格点，保留SRP最大的K个，逐层只计算它们在细一层中的子节点 (自身与相邻的中点)，
+ * 直到目标分辨率。r = 4、K = 4时约计算110个网格点 (穷举为2560个)。
+ */
+
+#ifndef SRP_ICO_H
+#define SRP_ICO_H
+
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 网格尺寸
+ *============================================================================*/
+#define SRP_ICO_CHARTS          5                               /* 图表数 */
+#define SRP_ICO_HEIGHT(r)       (1 << (r))                      /* 图表高度 2^r */
+#define SRP_ICO_WIDTH(r)        (1 << ((r) + 1))                /* 图表宽度 2^(r+1) */
+#define SRP_ICO_POINTS(r)       (SRP_ICO_CHARTS * SRP_ICO_HEIGHT(r) * SRP_ICO_WIDTH(r))
+#define SRP_ICO_SEARCH_MAX_K    32                              /* 层次搜索每层保留的最大候选数 */
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 时延表布局
+ */
+typedef enum {
+    SRP_ICO_LAYOUT_PAIR_MAJOR = 0,  /* [pair][point] 完整GCC索引，逐对累加 */
+    SRP_ICO_LAYOUT_GRID_MAJOR       /* [point][pair] 紧凑GCC偏移 (int16)，逐点gather累加 */
+} srp_ico_layout_t;
+
+/**
+ * @brief 层次搜索找到的峰值
+ */
+typedef struct {
+    int index;                      /* 目标分辨率下按 [5][H][W] 的网格点索引 */
+    int chart;                      /* 图表 */
+    int h;                          /* 图表内的行 */
+    int w;                          /* 图表内的列 */
+    float32_t power;                /* 未归一化的SRP-PHAT: 2 * sum_pair GCC + 通道数 */
+    float32_t direction[3];         /* 网格点方向 (单位向量) */
+    int evaluated;                  /* 各层累计计算的网格点数 */
+} srp_ico_peak_t;
+
+/**
+ * @brief 二十面体SRP计划 (不透明类型): 网格分辨率与各麦克风对的时延索引表
+ * 
+ * 按网格点排列时计划持有紧凑GCC工作缓冲区，同一计划不可被多个线程同时执行。
+ */
+typedef struct srp_ico_plan srp_ico_plan_t;
+
+/**
+ * @brief 层次峰值搜索 (不透明类型): 第1..r层的计划与相邻两层之间的子节点表
+ * 
+ * 持有候选工作缓冲区，同一搜索不可被多个线程同时执行。
+ */
+typedef struct srp_ico_search srp_ico_search_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 生成分辨率r的二十面体网格坐标
+ * @param r 网格分辨率 (1 <= r <= SRP_ICO_MAX_RESOLUTION)
+ * @param xyz 输出笛卡尔坐标，按 [5][2^r][2^(r+1)][3] 排列 (SRP_ICO_POINTS(r) * 3个)
+ * @return 状态码
+ */
+status_t srp_ico_grid_coordinates(int r, float32_t* xyz);
+
+/**
+ * @brief 创建二十面体SRP计划 (须先调用gcc_phat_init以确定麦克风对)
+ * 
+ * 时延表保存全部NUM_MIC_PAIRS对 (按 [pair][point] 排列的完整GCC索引)，
+ * r = 4时为66 x 2560个。时延表按阵列几何与分辨率缓存 (见tau_cache.h)，
+ * 命中时直接映射缓存文件，未命中时计算后写回。
+ * 
+ * @param r 网格分辨率 (1 <= r <= SRP_ICO_MAX_RESOLUTION)
+ * @param mic_positions 麦克风位置 (相对阵列中心)
+ * @return 计划指针，失败返回NULL
+ */
+srp_ico_plan_t* srp_ico_plan_create(int r, const mic_position_t* mic_positions);
+
+/**
+ * @brief 销毁二十面体SRP计划
+ * @param plan 计划 (可为NULL)
+ */
+void srp_ico_plan_destroy(srp_ico_plan_t* plan);
+
+/**
+ * @brief 设置计划的时延表布局
+ * 
+ * 按网格点排列的表只包含当前启用的麦克风对，启用的对变化后由srp_ico_map_compute自动重建。
+ * 
+ * @param plan 计划
+ * @param layout 时延表布局
+ * @return 状态码 (紧凑GCC超出int16偏移范围时返回STATUS_ERROR_INVALID_PARAM)
+ */
+status_t srp_ico_plan_set_layout(srp_ico_plan_t* plan, srp_ico_layout_t layout);
+
+/**
+ * @brief 获取计划的时延表布局
+ * @param plan 计划
+ * @return 时延表布局
+ */
+srp_ico_layout_t srp_ico_plan_get_layout(const srp_ico_plan_t* plan);
+
+/**
+ * @brief 获取计划的网格分辨率
+ * @param plan 计划
+ * @return 分辨率r
+ */
+int srp_ico_plan_resolution(const srp_ico_plan_t* plan);
+
+/**
+ * @brief 获取计划的网格点数
+ * @param plan 计划
+ * @return 网格点数 SRP_ICO_POINTS(r)
+ */
+int srp_ico_plan_num_points(const srp_ico_plan_t* plan);
+
+/**
+ * @brief 计划的时延表是否直接映射自缓存文件
+ * @param plan 计划
+ * @return 1表示命中缓存且为内存映射，0表示本次计算 (或读入内存的副本)
+ */
+int srp_ico_plan_is_cache_mapped(const srp_ico_plan_t* plan);
+
+/**
+ * @brief 由GCC结果计算归一化的二十面体SRP-PHAT图
+ * 
+ * 网格点不超出单位球，时延不超过阵列孔径 (srp_map_get_aperture_tau)，
+ * 只读取该范围内的GCC值，可与gcc_phat_set_max_lag配合使用。
+ * 
+ * @param plan 计划
+ * @param gcc_result 输入GCC结果 (PHAT加权)
+ * @param map 输出，按 [5][2^r][2^(r+1)] 排列，最大值为1
+ * @return 状态码
+ */
+status_t srp_ico_map_compute(srp_ico_plan_t* plan, const gcc_result_t* gcc_result,
+                             float32_t* map);
+
+/**
+ * @brief 保存二十面体SRP图
+ * @param filename 文件路径
+ * @param plan 计划 (提供分辨率)
+ * @param map SRP图
+ * @return 状态码
+ */
+status_t srp_ico_save_map(const char* filename, const srp_ico_plan_t* plan, const float32_t* map);
+
+/**
+ * @brief 创建层次峰值搜索 (须先调用gcc_phat_init以确定麦克风对)
+ * 
+ * 为第1..r层各创建一个计划 (时延表经tau_cache缓存)，并按3D距离建立每层网格点在
+ * 细一层中的子节点表。
+ * 
+ * @param r 目标分辨率 (1 <= r <= SRP_ICO_MAX_RESOLUTION)
+ * @param top_k 每层保留的候选数 (1 <= top_k <= SRP_ICO_SEARCH_MAX_K)
+ * @param mic_positions 麦克风位置 (相对阵列中心)
+ * @return 搜索指针，失败返回NULL
+ */
+srp_ico_search_t* srp_ico_search_create(int r, int top_k, const mic_position_t* mic_positions);
+
+/**
+ * @brief 销毁层次峰值搜索
+ * @param search 搜索 (可为NULL)
+ */
+void srp_ico_search_destroy(srp_ico_search_t* search);
+
+/**
+ * @brief 由GCC结果做由粗到细的峰值搜索
+ * 
+ * 只累加启用的麦克风对，功率与srp_ico_map_compute归一化前的值相同。
+ * 峰值所在的粗网格点未进入前K个时结果可能与穷举不同，增大top_k可提高一致性。
+ * 
+ * @param search 搜索
+ * @param gcc_result 输入GCC结果 (PHAT加权)
+ * @param peak 输出峰值与计算的网格点数
+ * @return 状态码
+ */
+status_t srp_ico_search_run(srp_ico_search_t* search, const gcc_result_t* gcc_result,
+                            srp_ico_peak_t* peak);
+
+/**
+ * @brief 获取时延表布局名称（调试用）
+ * @param layout 时延表布局
+ * @return 名称字符串
+ */
+const char* srp_ico_layout_name(srp_ico_layout_t layout);
+
+#endif /* SRP_ICO_H */
@@ -6,6 +6,18 @@
  * 
  * 该模块实现SRP(Steered Response Power)空间功率谱投影，
  * 将GCC结果映射到三维空间网格。
+ * 
+ * 时延默认取整到采样点 (Tau Table)。小口径阵列的时延只有少数几个整数值，
+ * 许多网格点会得到相同的投影；启用插值后使用小数时延表 (向下取整的索引 + 小数权重)，
+ * 在相邻GCC样本之间线性或三次插值，每次查表只多读1-3个相邻样本。
+ * 
+ * Tau Table包含全部麦克风对，各投影路径只累加GCC模块中启用的麦克风对
+ * (见gcc_phat_select_pairs)，网格点的SRP值随启用对数成比例变化。
+ * 
+ * 远场模式 (srp_map_set_far_field) 按方向向量u计算平面波时延 u · (p2 - p1) / c，
+ * 与距离无关，各距离单元的结果相同。时延列相同的网格点 (远场下的各距离单元、
+ * 近场下小口径阵列取整后的相邻距离) 只计算一次 (srp_map_set_dedup)，
+ * 输出仍为完整的 [elevation][azimuth][range] 网格。
  */
 
 #ifndef SRP_MAP_H
@@ -13,6 +25,20 @@
 
 #include "types.h"
 #include "config.h"
+#include "srp_freq.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 时延插值方式 (与配置SRP_TAU_INTERP的取值对应)
+ */
+typedef enum {
+    SRP_INTERP_NEAREST = 0,     /* 取整到最近的采样点 (Tau Table) */
+    SRP_INTERP_LINEAR = 1,      /* 相邻两点线性插值 */
+    SRP_INTERP_CUBIC = 2        /* 相邻四点三次插值 (Catmull-Rom) */
+} srp_interp_t;
 
 /*============================================================================
  * 函数声明
@@ -20,6 +46,10 @@
 
 /**
  * @brief 初始化SRP-Map模块
+ * 
+ * 未取整的时延表按阵列几何与网格定义缓存 (见tau_cache.h)，
+ * 命中时从缓存读入，Tau Table与小数时延表都由它导出。
+ * 
  * @param mic_positions 麦克风位置数组
  * @return 状态码
  */
@@ -30,6 +60,57 @@ status_t srp_map_init(const mic_position_t* mic_positions);
  */
 void srp_map_cleanup(void);
 
+/**
+ * @brief 设置时延插值方式 (srp_map_compute与srp_map_compute_fused使用)
+ * 
+ * 紧凑GCC投影只支持取整时延；频域引擎本身使用未取整的时延，不受影响。
+ * 
+ * @param mode 插值方式
+ * @return 状态码
+ */
+status_t srp_map_set_interp(srp_interp_t mode);
+
+/**
+ * @brief 获取时延插值方式
+ * @return 插值方式
+ */
+srp_interp_t srp_map_get_interp(void);
+
+/**
+ * @brief 设置远场模式 (重新计算Tau Table与小数时延表，频域计划按原设置重建)
+ * 
+ * 远场模式下时延只由方向决定 (平面波)，SRP-Map在距离维上取值相同。
+ * 初始化前调用时只记录设置。
+ * 
+ * @param enable 非0启用远场模式 (默认SRP_FAR_FIELD)
+ * @return 状态码
+ */
+status_t srp_map_set_far_field(int enable);
+
+/**
+ * @brief 是否为远场模式
+ * @return 1表示远场模式
+ */
+int srp_map_is_far_field(void);
+
+/**
+ * @brief 设置是否合并时延列相同的网格点
+ * 
+ * 启用后各投影路径 (包括频域引擎的导向矩阵) 只计算每组时延列相同的网格点中的一个，
+ * 再写回组内全部网格点，结果与不合并时逐位相同。取整时延只比较整数时延，
+ * 插值与频域引擎还要求未取整的时延相同。
+ * 
+ * @param enable 非0启用 (默认SRP_DEDUP_TAU)
+ * @return 状态码
+ */
+status_t srp_map_set_dedup(int enable);
+
+/**
+ * @brief 获取实际计算的网格点数 (时延列不同的网格点数，不合并时为TAU_TABLE_SIZE)
+ * @return 网格点数
+ */
+int srp_map_get_num_unique(void);
+
 /**
  * @brief 计算SRP-Map
  * @param gcc_result 输入GCC结果
@@ -40,7 +121,64 @@ status_t srp_map_compute(const gcc_result_t* gcc_result,
                           srp_map_t* srp_result);
 
 /**
- * @brief 预计算Tau Table
+ * @brief 由紧凑GCC计算SRP-Map
+ * 
+ * 使用映射到紧凑GCC的Tau Table (srp_map_get_compact_tau_table)，
+ * 结果与srp_map_compute对完整GCC的结果一致。
+ * 
+ * @param compact 输入紧凑GCC (max_lag须等于srp_map_get_aperture_tau())
+ * @param srp_result 输出SRP-Map结果
+ * @return 状态码
+ */
+status_t srp_map_compute_compact(const gcc_compact_t* compact,
+                                 srp_map_t* srp_result);
+
+/**
+ * @brief 融合GCC->SRP投影: 不生成完整或紧凑的GCC结果
+ * 
+ * 逐个麦克风对计算孔径范围内的GCC时延 (写入2*tau_max+1点的暂存区)，
+ * 随即通过该对的Tau Table行累加到全部网格点，再处理下一对。
+ * 热循环中没有gcc_result_t中间结果，累加顺序与srp_map_compute相同。
+ * 
+ * @param whitened 白化频谱 (gcc_phat_whiten_spectrum的输出)
+ * @param srp_result 输出SRP-Map结果
+ * @return 状态码
+ */
+status_t srp_map_compute_fused(const fft_result_t* whitened,
+                               srp_map_t* srp_result);
+
+/**
+ * @brief 选择由加权频谱计算SRP-Map的路径 (srp_map_compute_spectrum使用)
+ * 
+ * SRP_ENGINE_AUTO按代价模型 (srp_freq_choose_engine，单帧) 在融合查表与频域引擎之间选择。
+ * 频域引擎使用未取整的时延与调用时的GCC频带 (改变频带后须重新调用)，
+ * 结果与取整时延的查表路径略有不同；导向矩阵超出内存上限时返回错误并保留查表路径。
+ * 
+ * @param engine 计算路径
+ * @return 状态码
+ */
+status_t srp_map_set_engine(srp_engine_t engine);
+
+/**
+ * @brief 获取实际使用的SRP计算路径
+ * @return SRP_ENGINE_LOOKUP或SRP_ENGINE_FREQ
+ */
+srp_engine_t srp_map_get_engine(void);
+
+/**
+ * @brief 由加权频谱计算SRP-Map (按srp_map_set_engine选择的路径)
+ * 
+ * 频域计划的麦克风对与当前启用的麦克风对不一致时，先按原设置重建计划。
+ * 
+ * @param whitened 加权频谱 (gcc_phat_weight_spectrum的输出)
+ * @param srp_result 输出SRP-Map结果
+ * @return 状态码
+ */
+status_t srp_map_compute_spectrum(const fft_result_t* whitened,
+                                  srp_map_t* srp_result);
+
+/**
+ * @brief 预计算Tau Table (远场模式下为平面波时延)
  * @param mic_positions 麦克风位置数组
  * @param tau_table 输出Tau表
  * @return 状态码
@@ -61,12 +199,75 @@ int srp_map_compute_tau(const mic_position_t* mic1_pos,
                          float32_t azimuth,
                          float32_t range);
 
+/**
+ * @brief 计算两个麦克风之间未取整的理论时延
+ * @param mic1_pos 麦克风1位置
+ * @param mic2_pos 麦克风2位置
+ * @param elevation 俯仰角 (rad)
+ * @param azimuth 方位角 (rad)
+ * @param range 距离 (m)
+ * @return 时延 (采样点，小数)
+ */
+float32_t srp_map_compute_tau_frac(const mic_position_t* mic1_pos,
+                                   const mic_position_t* mic2_pos,
+                                   float32_t elevation,
+                                   float32_t azimuth,
+                                   float32_t range);
+
+/**
+ * @brief 计算所有麦克风对在所有网格点的未取整时延 (远场模式下为平面波时延)
+ * @param mic_positions 麦克风位置数组
+ * @param tau 输出 (NUM_MIC_PAIRS * TAU_TABLE_SIZE个，按 [pair][grid] 排列)
+ * @return 状态码
+ */
+status_t srp_map_compute_frac_tau_table(const mic_position_t* mic_positions, float32_t* tau);
+
 /**
  * @brief 获取Tau Table
  * @return Tau Table指针
  */
 const tau_table_t* srp_map_get_tau_table(void);
 
+/**
+ * @brief 获取Tau Table中的最大时延绝对值
+ * 
+ * 该值由阵列孔径决定 (不超过最大麦克风间距/声速*采样率)，
+ * SRP只读取GCC中 ±该值 范围内的时延，可用于gcc_phat_set_max_lag。
+ * 
+ * @return 最大时延 (采样点)
+ */
+int srp_map_get_max_tau(void);
+
+/**
+ * @brief 获取由阵列孔径决定的最大时延
+ * 
+ * 由srp_map_init传入的麦克风位置计算: ceil(最大麦克风间距 / 声速 * 采样率)，
+ * 限制在MAX_TAU_SAMPLES以内，任何声源位置的时延都不会超过该值。
+ * 
+ * @return 最大时延 (采样点, >= 1)
+ */
+int srp_map_get_aperture_tau(void);
+
+/**
+ * @brief 获取映射到紧凑GCC的Tau Table
+ * 
+ * 索引为紧凑GCC data中的偏移 pair * width + tau_max + tau (width = 2*tau_max+1)，
+ * 超出孔径范围的时延 (仅可能来自外部加载的表) 截断到 ±tau_max。
+ * 
+ * @return Tau Table指针
+ */
+const tau_table_t* srp_map_get_compact_tau_table(void);
+
+/**
+ * @brief 获取小数时延表
+ * 
+ * 索引为完整GCC中向下取整的位置，权重为时延的小数部分；外部加载的Tau Table
+ * 没有小数部分，加载后权重为0。
+ * 
+ * @return 小数时延表指针
+ */
+const tau_frac_table_t* srp_map_get_frac_tau_table(void);
+
 /**
  * @brief 保存Tau Table到文件
  * @param filename 文件路径
@@ -76,8 +277,12 @@ status_t srp_map_save_tau_table(const char* filename);
 
 /**
  * @brief 从文件加载Tau Table
+ * 
+ * 文件须由srp_map_save_tau_table写出: 魔数、麦克风对数与网格点数须与当前配置一致，
+ * 且全部索引在 [0, GCC_LENGTH) 内。校验失败时当前Tau Table保持不变。
+ * 
  * @param filename 文件路径
- * @return 状态码
+ * @return 状态码 (格式、尺寸或索引不符时返回STATUS_ERROR_INVALID_PARAM)
  */
 status_t srp_map_load_tau_table(const char* filename);
 
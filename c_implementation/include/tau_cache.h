@@ -0,0 +1,127 @@
+/**
+ * @file tau_cache.h
+ * @brief 时延表缓存模块头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 按内容寻址的时延表文件缓存: 键为麦克风位置、采样率、声速、FFT点数与网格定义的
+ * 64位哈希 (FNV-1a)，文件名为 <TAU_CACHE_DIR>/tau_<键的16位十六进制>.bin。
+ * 文件头之后的数据按TAU_CACHE_ALIGN对齐，可直接内存映射 (POSIX mmap / Win32文件映射)
+ * 后作为只读表使用，启动时不再逐对逐网格点计算三角函数。
+ * 
+ * 打开时校验魔数、版本、字节序、键、元素类型、行列数、数据范围与数据校验和，
+ * 任一不符即视为未命中 (打印原因)，由调用者重新计算并写回。
+ * 写入先写临时文件再改名，不会留下不完整的缓存文件。
+ */
+
+#ifndef TAU_CACHE_H
+#define TAU_CACHE_H
+
+#include <stddef.h>
+#include "types.h"
+#include "config.h"
+
+/*============================================================================
+ * 常量
+ *============================================================================*/
+#define TAU_CACHE_VERSION       1               /* 文件格式与时延取整规则的版本 */
+#define TAU_CACHE_ALIGN         4096            /* 数据起始偏移的对齐 (页大小) */
+#define TAU_CACHE_HASH_INIT     14695981039346656037ULL     /* FNV-1a 64位初值 */
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 缓存表的元素类型
+ */
+typedef enum {
+    TAU_CACHE_INT32 = 0,    /* 整数时延索引 */
+    TAU_CACHE_FLOAT32       /* 未取整的时延 (采样点) */
+} tau_cache_elem_t;
+
+/**
+ * @brief 打开的缓存表 (不透明类型): 内存映射的文件或读入内存的副本
+ */
+typedef struct tau_cache_view tau_cache_view_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 累加哈希 (FNV-1a 64位)
+ * @param hash 当前哈希 (首次为TAU_CACHE_HASH_INIT)
+ * @param data 数据
+ * @param bytes 字节数
+ * @return 新的哈希
+ */
+uint64_t tau_cache_hash(uint64_t hash, const void* data, size_t bytes);
+
+/**
+ * @brief 阵列几何与信号参数的哈希 (各模块再累加自己的网格定义作为缓存键)
+ * 
+ * 包含TAU_CACHE_VERSION、通道数、麦克风对数、麦克风位置、采样率、声速、FFT点数与GCC长度。
+ * 
+ * @param mic_positions 麦克风位置
+ * @return 哈希
+ */
+uint64_t tau_cache_key_geometry(const mic_position_t* mic_positions);
+
+/**
+ * @brief 设置缓存目录 (默认TAU_CACHE_DIR，TAU_CACHE_ENABLE为0时默认禁用)
+ * @param dir 目录路径，NULL表示禁用缓存
+ */
+void tau_cache_set_dir(const char* dir);
+
+/**
+ * @brief 获取缓存目录
+ * @return 目录路径，禁用时返回NULL
+ */
+const char* tau_cache_get_dir(void);
+
+/**
+ * @brief 打开缓存表
+ * @param key 缓存键
+ * @param type 元素类型
+ * @param rows 行数
+ * @param cols 列数
+ * @return 缓存表，未命中、校验失败或缓存禁用时返回NULL
+ */
+tau_cache_view_t* tau_cache_open(uint64_t key, tau_cache_elem_t type, int rows, int cols);
+
+/**
+ * @brief 缓存表数据 (rows x cols个元素，行优先，只读)
+ * @param view 缓存表
+ * @return 数据指针
+ */
+const void* tau_cache_data(const tau_cache_view_t* view);
+
+/**
+ * @brief 缓存表是否为内存映射 (否则为读入内存的副本)
+ * @param view 缓存表
+ * @return 1表示内存映射
+ */
+int tau_cache_is_mapped(const tau_cache_view_t* view);
+
+/**
+ * @brief 关闭缓存表 (解除映射或释放副本)
+ * @param view 缓存表 (可为NULL)
+ */
+void tau_cache_close(tau_cache_view_t* view);
+
+/**
+ * @brief 写入缓存表 (缓存禁用时直接返回STATUS_OK)
+ * 
+ * 缓存目录按需逐级创建。写入失败不影响调用方: 只在第一次失败时打印警告，
+ * 之后静默返回错误码。
+ * @param key 缓存键
+ * @param type 元素类型
+ * @param rows 行数
+ * @param cols 列数
+ * @param data 数据 (rows x cols个4字节元素，行优先)
+ * @return 状态码
+ */
+status_t tau_cache_store(uint64_t key, tau_cache_elem_t type, int rows, int cols, const void* data);
+
+#endif /* TAU_CACHE_H */
@@ -157,6 +157,33 @@ status_t test_data_save_gcc(const char* filename,
 status_t test_data_save_srp(const char* filename,
                              const srp_map_t* srp_result);
 
+/**
+ * @brief 从二进制文件加载FFT结果
+ * @param filename 文件路径
+ * @param fft_result 输出FFT结果
+ * @return 状态码
+ */
+status_t test_data_load_fft(const char* filename,
+                             fft_result_t* fft_result);
+
+/**
+ * @brief 从二进制文件加载GCC结果
+ * @param filename 文件路径
+ * @param gcc_result 输出GCC结果
+ * @return 状态码
+ */
+status_t test_data_load_gcc(const char* filename,
+                             gcc_result_t* gcc_result);
+
+/**
+ * @brief 从二进制文件加载SRP结果
+ * @param filename 文件路径
+ * @param srp_result 输出SRP结果
+ * @return 状态码
+ */
+status_t test_data_load_srp(const char* filename,
+                             srp_map_t* srp_result);
+
 /**
  * @brief 保存数据为文本格式（便于查看）
  * @param filename 文件路径
@@ -0,0 +1,79 @@
+/**
+ * @file thread_pool.h
+ * @brief 工作线程池头文件
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 固定数量的工作线程按任务编号分发一批独立任务，调用线程阻塞到整批完成。
+ * 任务回调同时收到执行它的工作线程编号，调用者可据此为每个线程准备
+ * 私有的工作缓冲区 (如GCC上下文)，避免任务间共享可写状态。
+ * Windows下使用Win32线程，其余平台使用POSIX线程。
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "types.h"
+
+/*============================================================================
+ * 类型定义
+ *============================================================================*/
+
+/**
+ * @brief 任务回调
+ * @param arg 用户参数
+ * @param task 任务编号 (0 到 num_tasks-1)
+ * @param worker 执行该任务的工作线程编号 (0 到 num_workers-1)
+ */
+typedef void (*thread_pool_task_t)(void* arg, int task, int worker);
+
+/**
+ * @brief 线程池 (不透明类型)
+ */
+typedef struct thread_pool thread_pool_t;
+
+/*============================================================================
+ * 函数声明
+ *============================================================================*/
+
+/**
+ * @brief 创建线程池
+ * @param num_workers 工作线程数 (<= 0 表示使用处理器核数)
+ * @return 线程池指针，失败返回NULL
+ */
+thread_pool_t* thread_pool_create(int num_workers);
+
+/**
+ * @brief 销毁线程池 (等待工作线程退出)
+ * @param pool 线程池 (可为NULL)
+ */
+void thread_pool_destroy(thread_pool_t* pool);
+
+/**
+ * @brief 获取工作线程数
+ * @param pool 线程池
+ * @return 工作线程数
+ */
+int thread_pool_size(const thread_pool_t* pool);
+
+/**
+ * @brief 执行一批任务并等待全部完成
+ * 
+ * 任务按编号动态分发给空闲的工作线程。同一线程池同一时刻只能执行一批任务，
+ * 多个线程共用一个线程池时需由调用者串行化。
+ * 
+ * @param pool 线程池
+ * @param fn 任务回调
+ * @param arg 用户参数
+ * @param num_tasks 任务数
+ * @return 状态码
+ */
+status_t thread_pool_run(thread_pool_t* pool, thread_pool_task_t fn, void* arg, int num_tasks);
+
+/**
+ * @brief 获取在线处理器核数
+ * @return 核数 (至少为1)
+ */
+int thread_pool_cpu_count(void);
+
+#endif /* THREAD_POOL_H */
@@ -51,6 +51,15 @@ typedef struct {
     float32_t data[NUM_MIC_PAIRS][GCC_LENGTH];   /* 所有麦克风对的GCC结果 */
 } gcc_result_t;
 
+/*============================================================================
+ * 紧凑GCC结构 (只保存阵列孔径内的时延)
+ *============================================================================*/
+typedef struct {
+    int max_lag;        /* 最大时延 tau_max (由麦克风位置决定) */
+    int width;          /* 每对的时延数 2*tau_max+1 (行跨度) */
+    float32_t data[NUM_MIC_PAIRS * (2 * MAX_TAU_SAMPLES + 1)];  /* data[pair * width + tau_max + tau] */
+} gcc_compact_t;
+
 /*============================================================================
  * SRP-Map结果结构
  *============================================================================*/
@@ -65,6 +74,14 @@ typedef struct {
     int tau_indices[NUM_MIC_PAIRS][TAU_TABLE_SIZE];  /* 时延索引表 */
 } tau_table_t;
 
+/*============================================================================
+ * 小数时延表结构 (插值SRP投影)
+ *============================================================================*/
+typedef struct {
+    int tau_indices[NUM_MIC_PAIRS][TAU_TABLE_SIZE];          /* 向下取整的GCC索引 */
+    float32_t tau_weights[NUM_MIC_PAIRS][TAU_TABLE_SIZE];    /* 小数部分 [0, 1) */
+} tau_frac_table_t;
+
 /*============================================================================
  * 麦克风对索引结构
  *============================================================================*/
@@ -82,6 +99,40 @@ typedef struct {
     float32_t z;        /* Z坐标 (m) */
 } mic_position_t;
 
+/*============================================================================
+ * 定点数类型 (定点处理链, 见fixed_point.h)
+ *============================================================================*/
+typedef int16_t         q15_t;              /* Q15: 值 = m / 2^15 */
+typedef int32_t         q31_t;              /* Q31 (或Q15累加器) */
+
+typedef struct {
+    q15_t real;         /* 实部 */
+    q15_t imag;         /* 虚部 */
+} complex_q15_t;
+
+/**
+ * 定点FFT结果: 块浮点格式，每个通道共享一个指数
+ * 频点值 = m / 2^15 * 2^exponent[ch]
+ */
+typedef struct {
+    complex_q15_t data[NUM_CHANNELS][FFT_BINS];
+    int exponent[NUM_CHANNELS];
+} fft_result_q15_t;
+
+/**
+ * 定点GCC结果: Q15 (PHAT加权后GCC值不超过1，不需要指数)
+ */
+typedef struct {
+    q15_t data[NUM_MIC_PAIRS][GCC_LENGTH];
+} gcc_result_q15_t;
+
+/**
+ * 定点SRP结果: 各麦克风对Q15值的32位累加和
+ */
+typedef struct {
+    q31_t data[SRP_ELEVATION_BINS][SRP_AZIMUTH_BINS][SRP_RANGE_BINS];
+} srp_map_q31_t;
+
 /*============================================================================
  * 处理状态枚举
  *============================================================================*/
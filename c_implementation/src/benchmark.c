@@ -0,0 +1,1486 @@
+/**
+ * @file benchmark.c
+ * @brief 性能基准测试模块实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 计时采用clock()，每个测试项重复执行直到累计时间超过BENCH_MIN_SECONDS，
+ * 报告单次平均耗时 (微秒)。多线程测试项的clock()会累计所有线程的CPU时间，
+ * 改用墙钟时间。
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "benchmark.h"
+#include "fft.h"
+#include "fft_simd.h"
+#include "fft_lags.h"
+#include "gcc_phat.h"
+#include "gcc_weight.h"
+#include "thread_pool.h"
+#include "srp_map.h"
+#include "srp_freq.h"
+#include "srp_ico.h"
+#include "tau_cache.h"
+#include "test_data.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+/*============================================================================
+ * 基准测试参数
+ *============================================================================*/
+#define BENCH_MIN_SECONDS       0.2     /* 每个测试项的最短计时时间 */
+#define BENCH_WARMUP_RUNS       8       /* 计时前的预热次数 */
+#define BENCH_SRP_FRAMES        8       /* 频域SRP批量测试的帧数 */
+#define BENCH_PAIR_SOURCES      32      /* 麦克风对子集测试的随机声源数 */
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+/**
+ * @brief 墙钟时间 (秒)，用于多线程测试项
+ */
+static double wall_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief 生成确定性的伪随机测试数据 (线性同余)
+ */
+static void fill_random(float32_t* data, int count)
+{
+    unsigned int state = 12345u;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (float32_t)(state >> 8) / 16777216.0f - 0.5f;
+    }
+}
+
+/**
+ * @brief 计时n点复数FFT，返回单次平均耗时 (微秒)
+ */
+static double time_complex_fft(const fft_plan_t* plan, const complex_t* input, complex_t* output)
+{
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        fft_plan_execute(plan, input, output, FFT_FORWARD);
+    }
+    
+    long runs = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        for (int i = 0; i < 16; i++) {
+            fft_plan_execute(plan, input, output, FFT_FORWARD);
+        }
+        runs += 16;
+        elapsed = clock() - start;
+    } while ((double)elapsed / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    
+    return (double)elapsed / CLOCKS_PER_SEC * 1e6 / runs;
+}
+
+/**
+ * @brief 计时n点实数FFT，返回单次平均耗时 (微秒)
+ */
+static double time_real_fft(const fft_plan_t* plan, const float32_t* input, complex_t* output)
+{
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        fft_plan_execute_r2c(plan, input, output);
+    }
+    
+    long runs = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        for (int i = 0; i < 16; i++) {
+            fft_plan_execute_r2c(plan, input, output);
+        }
+        runs += 16;
+        elapsed = clock() - start;
+    } while ((double)elapsed / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    
+    return (double)elapsed / CLOCKS_PER_SEC * 1e6 / runs;
+}
+
+/*============================================================================
+ * 基准测试函数
+ *============================================================================*/
+
+status_t benchmark_fft_algorithms(void)
+{
+    static const int sizes[] = { 4096, 16384 };
+    
+    /* 测试的计划配置: 标量位反转 / 标量Stockham / 最佳引擎位反转 */
+    fft_plan_options_t variants[3];
+    const char* names[3] = { "bit-reverse", "stockham", "bit-reverse" };
+    variants[0].engine = FFT_ENGINE_SCALAR;
+    variants[0].algorithm = FFT_ALGO_BIT_REVERSE;
+    variants[1].engine = FFT_ENGINE_SCALAR;
+    variants[1].algorithm = FFT_ALGO_STOCKHAM;
+    variants[2].engine = FFT_ENGINE_AUTO;
+    variants[2].algorithm = FFT_ALGO_BIT_REVERSE;
+    
+    printf("\n========== Benchmark: FFT Algorithms ==========\n");
+    printf("%-8s %-12s %-8s %14s %14s\n", "N", "Algorithm", "Engine", "Complex (us)", "Real (us)");
+    
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int n = sizes[s];
+        
+        float32_t* real_input = (float32_t*)malloc(2 * n * sizeof(float32_t));
+        complex_t* output = (complex_t*)malloc(n * sizeof(complex_t));
+        if (real_input == NULL || output == NULL) {
+            free(real_input);
+            free(output);
+            return STATUS_ERROR_MEMORY_ALLOC;
+        }
+        
+        /* 复数输入与实数输入共用同一块随机数据 */
+        fill_random(real_input, 2 * n);
+        const complex_t* complex_input = (const complex_t*)real_input;
+        
+        for (int v = 0; v < 3; v++) {
+            /* 最佳引擎为标量时第三项与第一项重复 */
+            if (v == 2 && fft_simd_best_engine() == FFT_ENGINE_SCALAR) {
+                continue;
+            }
+            
+            fft_plan_t* plan = fft_plan_create_ex(n, &variants[v]);
+            if (plan == NULL) {
+                free(real_input);
+                free(output);
+                return STATUS_ERROR_MEMORY_ALLOC;
+            }
+            
+            double t_complex = time_complex_fft(plan, complex_input, output);
+            double t_real = time_real_fft(plan, real_input, output);
+            
+            printf("%-8d %-12s %-8s %14.2f %14.2f\n",
+                   n, names[v], fft_engine_name(plan->engine), t_complex, t_real);
+            
+            fft_plan_destroy(plan);
+        }
+        
+        free(real_input);
+        free(output);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t benchmark_fft_mixed_radix(void)
+{
+    /* 每组为混合基点数与补零后的2的幂点数 */
+    static const int sizes[][2] = { { 960, 1024 }, { 3840, 4096 }, { 4800, 8192 } };
+    int num_sizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    
+    fft_plan_options_t stockham;
+    stockham.engine = FFT_ENGINE_SCALAR;
+    stockham.algorithm = FFT_ALGO_STOCKHAM;
+    
+    printf("\n========== Benchmark: Mixed-Radix FFT ==========\n");
+    printf("%-8s %-12s %-8s %14s %14s\n", "N", "Algorithm", "Engine", "Complex (us)", "Real (us)");
+    
+    for (int s = 0; s < num_sizes; s++) {
+        int padded = sizes[s][1];
+        
+        float32_t* real_input = (float32_t*)malloc(2 * padded * sizeof(float32_t));
+        complex_t* output = (complex_t*)malloc(padded * sizeof(complex_t));
+        if (real_input == NULL || output == NULL) {
+            free(real_input);
+            free(output);
+            return STATUS_ERROR_MEMORY_ALLOC;
+        }
+        fill_random(real_input, 2 * padded);
+        const complex_t* complex_input = (const complex_t*)real_input;
+        
+        /* 混合基点数 (标量Stockham)，补零点数分别测标量Stockham与默认引擎 */
+        for (int v = 0; v < 3; v++) {
+            int n = (v == 0) ? sizes[s][0] : padded;
+            fft_plan_t* plan = fft_plan_create_ex(n, (v == 2) ? NULL : &stockham);
+            if (plan == NULL) {
+                free(real_input);
+                free(output);
+                return STATUS_ERROR_MEMORY_ALLOC;
+            }
+            
+            double t_complex = time_complex_fft(plan, complex_input, output);
+            double t_real = time_real_fft(plan, real_input, output);
+            
+            printf("%-8d %-12s %-8s %14.2f %14.2f\n", n,
+                   (plan->algorithm == FFT_ALGO_STOCKHAM) ? "stockham" : "bit-reverse",
+                   fft_engine_name(plan->engine), t_complex, t_real);
+            
+            fft_plan_destroy(plan);
+        }
+        
+        free(real_input);
+        free(output);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t benchmark_fft_batch(void)
+{
+    /* 各路数据共用一块连续缓冲区: 实数输入/输出各n点，频谱n/2+1点 */
+    int n = FFT_SIZE;
+    int bins = n / 2 + 1;
+    int count = NUM_MIC_PAIRS;
+    float32_t* real_data = (float32_t*)malloc((size_t)count * n * sizeof(float32_t));
+    complex_t* spectra = (complex_t*)malloc((size_t)count * bins * sizeof(complex_t));
+    fft_plan_t* plan = fft_plan_create(n);
+    if (real_data == NULL || spectra == NULL || plan == NULL) {
+        free(real_data);
+        free(spectra);
+        fft_plan_destroy(plan);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    fill_random(real_data, count * n);
+    
+    const float32_t* inputs[NUM_MIC_PAIRS];
+    float32_t* real_outputs[NUM_MIC_PAIRS];
+    const complex_t* spectrum_inputs[NUM_MIC_PAIRS];
+    complex_t* spectrum_outputs[NUM_MIC_PAIRS];
+    for (int c = 0; c < count; c++) {
+        inputs[c] = real_data + (size_t)c * n;
+        real_outputs[c] = real_data + (size_t)c * n;
+        spectrum_inputs[c] = spectra + (size_t)c * bins;
+        spectrum_outputs[c] = spectra + (size_t)c * bins;
+    }
+    
+    printf("\n========== Benchmark: Batched FFT (N=%d, engine=%s) ==========\n",
+           n, fft_engine_name(plan->engine));
+    printf("%-28s %14s %14s\n", "Transform", "Loop (us)", "Batch (us)");
+    
+    /* 正向: 一帧NUM_CHANNELS路实数FFT */
+    double t_loop = 0.0, t_batch = 0.0;
+    long runs = 0;
+    clock_t start = clock();
+    do {
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            fft_plan_execute_r2c(plan, inputs[c], spectrum_outputs[c]);
+        }
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    t_loop = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+    
+    runs = 0;
+    start = clock();
+    do {
+        fft_plan_execute_r2c_batch(plan, inputs, spectrum_outputs, NUM_CHANNELS);
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    t_batch = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+    
+    printf("%-28s %14.2f %14.2f\n", "r2c x NUM_CHANNELS", t_loop, t_batch);
+    
+    /* 逆向: 全部麦克风对的实数IFFT (GCC) */
+    runs = 0;
+    start = clock();
+    do {
+        for (int c = 0; c < count; c++) {
+            fft_plan_execute_c2r(plan, spectrum_inputs[c], real_outputs[c]);
+        }
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    t_loop = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+    
+    runs = 0;
+    start = clock();
+    do {
+        fft_plan_execute_c2r_batch(plan, spectrum_inputs, real_outputs, count);
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    t_batch = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+    
+    printf("%-28s %14.2f %14.2f\n", "c2r x NUM_MIC_PAIRS", t_loop, t_batch);
+    
+    fft_plan_destroy(plan);
+    free(real_data);
+    free(spectra);
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 计时部分时延逆变换，返回单次平均耗时 (微秒)
+ */
+static double time_lag_plan(const fft_lag_plan_t* lag_plan, const complex_t* input, float32_t* output)
+{
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        fft_lag_plan_execute(lag_plan, input, output);
+    }
+    
+    long runs = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        for (int i = 0; i < 16; i++) {
+            fft_lag_plan_execute(lag_plan, input, output);
+        }
+        runs += 16;
+        elapsed = clock() - start;
+    } while ((double)elapsed / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    
+    return (double)elapsed / CLOCKS_PER_SEC * 1e6 / runs;
+}
+
+status_t benchmark_fft_lags(void)
+{
+    static const int lags[] = {1, 4, 8, 16, 32, 64, 128};
+    int num_lags = (int)(sizeof(lags) / sizeof(lags[0]));
+    int n = FFT_SIZE;
+    complex_t* input = (complex_t*)malloc((n / 2 + 1) * sizeof(complex_t));
+    float32_t* output = (float32_t*)malloc(n * sizeof(float32_t));
+    if (input == NULL || output == NULL) {
+        free(input);
+        free(output);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    fill_random((float32_t*)input, n + 2);
+    
+    printf("\n========== Benchmark: Lag-Windowed IFFT (N=%d) ==========\n", n);
+    printf("%-10s %12s %12s %10s\n", "Max lag", "Full (us)", "Direct (us)", "Auto");
+    
+    for (int i = 0; i < num_lags; i++) {
+        if (lags[i] >= n / 2) {
+            continue;
+        }
+        
+        static const fft_lag_strategy_t strategies[2] = { FFT_LAGS_FULL, FFT_LAGS_DIRECT };
+        double times[2] = { 0.0, 0.0 };
+        for (int s = 0; s < 2; s++) {
+            fft_lag_plan_t* lag_plan = fft_lag_plan_create(n, lags[i], strategies[s]);
+            if (lag_plan == NULL) {
+                free(input);
+                free(output);
+                return STATUS_ERROR_MEMORY_ALLOC;
+            }
+            times[s] = time_lag_plan(lag_plan, input, output);
+            fft_lag_plan_destroy(lag_plan);
+        }
+        
+        printf("%-10d %12.2f %12.2f %10s\n", lags[i], times[0], times[1],
+               fft_lags_strategy_name(fft_lags_choose_strategy(n, lags[i])));
+    }
+    
+    free(input);
+    free(output);
+    
+    return STATUS_OK;
+}
+
+status_t benchmark_gcc_ifft_modes(void)
+{
+    static const gcc_ifft_mode_t modes[2] = { GCC_IFFT_REAL, GCC_IFFT_PAIRED };
+    static const char* names[2] = { "real (batched)", "paired" };
+    
+    fft_result_t* whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    if (whitened == NULL || gcc_result == NULL || fft_init() != STATUS_OK ||
+        gcc_phat_init() != STATUS_OK) {
+        free(whitened);
+        free(gcc_result);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    fill_random((float32_t*)whitened->data, NUM_CHANNELS * FFT_BINS * 2);
+    gcc_phat_whiten_spectrum(whitened, whitened);
+    
+    gcc_ifft_mode_t saved_mode = gcc_phat_get_ifft_mode();
+    int saved_lag = gcc_phat_get_max_lag();
+    gcc_phat_set_max_lag(0);
+    
+    printf("\n========== Benchmark: GCC Inverse Transforms (N=%d, %d pairs) ==========\n",
+           FFT_SIZE, NUM_MIC_PAIRS);
+    printf("%-16s %14s\n", "Mode", "Frame (us)");
+    
+    for (int m = 0; m < 2; m++) {
+        gcc_phat_set_ifft_mode(modes[m]);
+        for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+            gcc_phat_compute_all_whitened(whitened, gcc_result);
+        }
+        
+        long runs = 0;
+        clock_t start = clock();
+        do {
+            gcc_phat_compute_all_whitened(whitened, gcc_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        printf("%-16s %14.2f\n", names[m], t);
+    }
+    
+    gcc_phat_set_ifft_mode(saved_mode);
+    gcc_phat_set_max_lag(saved_lag);
+    free(whitened);
+    free(gcc_result);
+    
+    return STATUS_OK;
+}
+
+status_t benchmark_gcc_weightings(void)
+{
+    static const gcc_weighting_t types[4] = {
+        GCC_WEIGHT_PHAT, GCC_WEIGHT_PHAT_BETA, GCC_WEIGHT_SCOT, GCC_WEIGHT_ROTH
+    };
+    static const float32_t params[4] = { 0.0f, 0.7f, 0.9f, 0.0f };
+    
+    fft_result_t* fft_result = (fft_result_t*)malloc(sizeof(fft_result_t));
+    fft_result_t* weighted = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_weight_cache_t* cache = (gcc_weight_cache_t*)calloc(1, sizeof(gcc_weight_cache_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    gcc_ctx_t* ctx = NULL;
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (fft_result == NULL || weighted == NULL || cache == NULL || gcc_result == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK ||
+        (ctx = gcc_ctx_create()) == NULL) {
+        goto cleanup;
+    }
+    
+    fill_random((float32_t*)fft_result->data, NUM_CHANNELS * FFT_BINS * 2);
+    
+    printf("\n========== Benchmark: GCC Weightings (N=%d, %d channels, %s) ==========\n",
+           FFT_SIZE, NUM_CHANNELS, fft_engine_name(fft_simd_best_engine()));
+    printf("%-16s %16s %14s\n", "Weighting", "Weighting (us)", "Frame (us)");
+    
+    for (int t = 0; t < 4; t++) {
+        gcc_weight_t weight;
+        gcc_weight_init(&weight, types[t], params[t]);
+        gcc_ctx_set_weighting(ctx, types[t], params[t]);
+        
+        /* 加权阶段: 一帧所有通道 */
+        long runs = 0;
+        clock_t start = clock();
+        do {
+            for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+                gcc_weight_apply_channel(&weight, cache, ch, fft_result->data[ch], weighted->data[ch], 0, FFT_BINS);
+            }
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_weight = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        /* 完整GCC一帧 */
+        for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+            gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+        }
+        runs = 0;
+        start = clock();
+        do {
+            gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_frame = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        printf("%-16s %16.2f %14.2f\n", gcc_weighting_name(types[t]), t_weight, t_frame);
+    }
+    status = STATUS_OK;
+
+cleanup:
+    gcc_ctx_destroy(ctx);
+    free(fft_result);
+    free(weighted);
+    free(cache);
+    free(gcc_result);
+    return status;
+}
+
+status_t benchmark_gcc_band(void)
+{
+    static const float32_t bands[3][2] = { { 0.0f, 0.0f }, { 100.0f, 8000.0f }, { 300.0f, 3400.0f } };
+    static const int lags[2] = { 0, 7 };
+    
+    fft_result_t* fft_result = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    if (fft_result == NULL || gcc_result == NULL || fft_init() != STATUS_OK ||
+        gcc_phat_init() != STATUS_OK) {
+        free(fft_result);
+        free(gcc_result);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    gcc_ctx_t* ctx = gcc_ctx_create();
+    if (ctx == NULL) {
+        free(fft_result);
+        free(gcc_result);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    fill_random((float32_t*)fft_result->data, NUM_CHANNELS * FFT_BINS * 2);
+    
+    printf("\n========== Benchmark: Band-Limited GCC-PHAT (N=%d, %d pairs) ==========\n",
+           FFT_SIZE, NUM_MIC_PAIRS);
+    printf("%-18s %10s %14s %14s\n", "Band (Hz)", "Bins", "Full (us)", "Lag +-7 (us)");
+    
+    for (int b = 0; b < 3; b++) {
+        int bin_lo, bin_hi;
+        gcc_ctx_set_band(ctx, bands[b][0], bands[b][1]);
+        gcc_ctx_get_band(ctx, &bin_lo, &bin_hi);
+        
+        double t[2];
+        for (int l = 0; l < 2; l++) {
+            gcc_ctx_set_max_lag(ctx, lags[l]);
+            for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+                gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+            }
+            
+            long runs = 0;
+            clock_t start = clock();
+            do {
+                gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+                runs++;
+            } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+            t[l] = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        }
+        
+        char label[32];
+        sprintf(label, "%.0f - %.0f", bands[b][0], (bands[b][1] > 0.0f) ? bands[b][1] : SAMPLE_RATE / 2.0f);
+        printf("%-18s %10d %14.2f %14.2f\n", label, bin_hi - bin_lo + 1, t[0], t[1]);
+    }
+    
+    gcc_ctx_destroy(ctx);
+    free(fft_result);
+    free(gcc_result);
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 查表路径: 各对的孔径窗口GCC + 前num_points个网格点的查表累加
+ */
+static void srp_lookup_points(const fft_result_t* whitened, int num_points, int max_lag, float32_t* out)
+{
+    const tau_table_t* tau_table = srp_map_get_tau_table();
+    float32_t lags[2 * MAX_TAU_SAMPLES + 1];
+    
+    memset(out, 0, num_points * sizeof(float32_t));
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        gcc_phat_compute_pair_lags(whitened, pair, max_lag, lags);
+        const int* row = tau_table->tau_indices[pair];
+        for (int i = 0; i < num_points; i++) {
+            int tau = row[i] - GCC_LENGTH / 2;
+            if (tau < -max_lag) tau = -max_lag;
+            if (tau > max_lag) tau = max_lag;
+            out[i] += lags[max_lag + tau];
+        }
+    }
+}
+
+status_t benchmark_srp_engines(void)
+{
+    static const int point_counts[5] = { 1, 4, 16, 64, TAU_TABLE_SIZE };
+    static const float32_t bands[2][2] = { { 300.0f, 3400.0f }, { 100.0f, 8000.0f } };
+    
+    fft_result_t* whitened = (fft_result_t*)malloc(BENCH_SRP_FRAMES * sizeof(fft_result_t));
+    float32_t* tau = (float32_t*)malloc((size_t)NUM_MIC_PAIRS * TAU_TABLE_SIZE * sizeof(float32_t));
+    float32_t* points = (float32_t*)malloc((size_t)NUM_MIC_PAIRS * TAU_TABLE_SIZE * sizeof(float32_t));
+    float32_t* out = (float32_t*)malloc((size_t)BENCH_SRP_FRAMES * TAU_TABLE_SIZE * sizeof(float32_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (whitened == NULL || tau == NULL || points == NULL || out == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    status = srp_map_init(mic_positions);
+    if (status != STATUS_OK) {
+        goto cleanup;
+    }
+    srp_map_compute_frac_tau_table(mic_positions, tau);
+    int max_lag = srp_map_get_aperture_tau();
+    
+    fill_random((float32_t*)whitened, BENCH_SRP_FRAMES * NUM_CHANNELS * FFT_BINS * 2);
+    for (int f = 0; f < BENCH_SRP_FRAMES; f++) {
+        gcc_phat_whiten_spectrum(&whitened[f], &whitened[f]);
+    }
+    
+    printf("\n========== Benchmark: SRP Engines (N=%d, %d pairs, max tau %d) ==========\n",
+           FFT_SIZE, NUM_MIC_PAIRS, max_lag);
+    printf("%-14s %8s %14s %14s %16s %18s %18s\n", "Band (Hz)", "Points", "Lookup (us)",
+           "Freq (us)", "Freq x8 (us/f)", "Auto", "Auto x8");
+    
+    for (int b = 0; b < 2; b++) {
+        int bin_lo, bin_hi;
+        gcc_phat_set_band(bands[b][0], bands[b][1]);
+        gcc_phat_get_band(&bin_lo, &bin_hi);
+        
+        for (int c = 0; c < 5; c++) {
+            int num_points = point_counts[c];
+            for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+                memcpy(points + (size_t)pair * num_points, tau + (size_t)pair * TAU_TABLE_SIZE,
+                       num_points * sizeof(float32_t));
+            }
+            
+            long runs = 0;
+            clock_t start = clock();
+            do {
+                srp_lookup_points(whitened, num_points, max_lag, out);
+                runs++;
+            } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+            double t_lookup = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+            
+            char t_freq[16] = "-", t_batch[16] = "-";
+            srp_freq_plan_t* plan = srp_freq_plan_create(points, num_points, bin_lo, bin_hi);
+            if (plan != NULL) {
+                runs = 0;
+                start = clock();
+                do {
+                    srp_freq_compute(plan, whitened, out);
+                    runs++;
+                } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+                sprintf(t_freq, "%.2f", (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs);
+                
+                runs = 0;
+                start = clock();
+                do {
+                    srp_freq_compute_batch(plan, whitened, BENCH_SRP_FRAMES, out);
+                    runs++;
+                } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+                sprintf(t_batch, "%.2f",
+                        (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs / BENCH_SRP_FRAMES);
+                srp_freq_plan_destroy(plan);
+            }
+            
+            char label[32];
+            sprintf(label, "%.0f - %.0f", bands[b][0], bands[b][1]);
+            printf("%-14s %8d %14.2f %14s %16s %18s %18s\n", label, num_points, t_lookup, t_freq, t_batch,
+                   srp_engine_name(srp_freq_choose_engine(num_points, bin_lo, bin_hi, max_lag, 1)),
+                   srp_engine_name(srp_freq_choose_engine(num_points, bin_lo, bin_hi, max_lag, BENCH_SRP_FRAMES)));
+        }
+    }
+    
+    /* 恢复配置的频带 */
+    gcc_phat_set_band(GCC_BAND_LOW_HZ, GCC_BAND_HIGH_HZ);
+    status = STATUS_OK;
+
+cleanup:
+    free(whitened);
+    free(tau);
+    free(points);
+    free(out);
+    return status;
+}
+
+status_t benchmark_srp_interp(void)
+{
+    static const char* names[3] = { "nearest", "linear", "cubic" };
+    
+    fft_result_t* whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    srp_map_t* srp_result = (srp_map_t*)malloc(sizeof(srp_map_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (whitened == NULL || gcc_result == NULL || srp_result == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    status = srp_map_init(mic_positions);
+    if (status != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    fill_random((float32_t*)whitened->data, NUM_CHANNELS * FFT_BINS * 2);
+    gcc_phat_whiten_spectrum(whitened, whitened);
+    gcc_phat_compute_all_whitened(whitened, gcc_result);
+    
+    srp_interp_t saved = srp_map_get_interp();
+    
+    printf("\n========== Benchmark: SRP Tau Interpolation (%d pairs x %d points) ==========\n",
+           NUM_MIC_PAIRS, TAU_TABLE_SIZE);
+    printf("%-12s %16s %16s\n", "Mode", "Lookup (us)", "Fused (us)");
+    
+    for (int m = 0; m < 3; m++) {
+        srp_map_set_interp((srp_interp_t)m);
+        
+        long runs = 0;
+        clock_t start = clock();
+        do {
+            srp_map_compute(gcc_result, srp_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_lookup = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        runs = 0;
+        start = clock();
+        do {
+            srp_map_compute_fused(whitened, srp_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_fused = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        printf("%-12s %16.2f %16.2f\n", names[m], t_lookup, t_fused);
+    }
+    
+    srp_map_set_interp(saved);
+    status = STATUS_OK;
+
+cleanup:
+    free(whitened);
+    free(gcc_result);
+    free(srp_result);
+    return status;
+}
+
+status_t benchmark_srp_far_field(void)
+{
+    static const struct {
+        const char* name;
+        int far_field;
+        int dedup;
+    } configs[] = {
+        { "near field",         0, 0 },
+        { "near field, dedup",  0, 1 },
+        { "far field",          1, 0 },
+        { "far field, dedup",   1, 1 }
+    };
+    int num_configs = (int)(sizeof(configs) / sizeof(configs[0]));
+    
+    fft_result_t* whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    srp_map_t* srp_result = (srp_map_t*)malloc(sizeof(srp_map_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (whitened == NULL || gcc_result == NULL || srp_result == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    status = srp_map_init(mic_positions);
+    if (status != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    fill_random((float32_t*)whitened->data, NUM_CHANNELS * FFT_BINS * 2);
+    gcc_phat_whiten_spectrum(whitened, whitened);
+    gcc_phat_compute_all_whitened(whitened, gcc_result);
+    
+    int saved_far_field = srp_map_is_far_field();
+    
+    printf("\n========== Benchmark: Far-Field / Tau Dedup SRP (%d pairs x %d points) ==========\n",
+           NUM_MIC_PAIRS, TAU_TABLE_SIZE);
+    printf("%-20s %8s %14s %14s %16s\n", "Mode", "Points", "Lookup (us)", "Fused (us)", "Freq 300-3400");
+    
+    for (int c = 0; c < num_configs; c++) {
+        srp_map_set_far_field(configs[c].far_field);
+        srp_map_set_dedup(configs[c].dedup);
+        int num_points = srp_map_get_num_unique();
+        
+        long runs = 0;
+        clock_t start = clock();
+        do {
+            srp_map_compute(gcc_result, srp_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_lookup = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        runs = 0;
+        start = clock();
+        do {
+            srp_map_compute_fused(whitened, srp_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_fused = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        /* 频域引擎的导向矩阵随实际计算的网格点数缩小 */
+        gcc_phat_set_band(300.0f, 3400.0f);
+        double t_freq = -1.0;
+        if (srp_map_set_engine(SRP_ENGINE_FREQ) == STATUS_OK) {
+            runs = 0;
+            start = clock();
+            do {
+                srp_map_compute_spectrum(whitened, srp_result);
+                runs++;
+            } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+            t_freq = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        }
+        srp_map_set_engine(SRP_ENGINE_LOOKUP);
+        gcc_phat_set_band(GCC_BAND_LOW_HZ, GCC_BAND_HIGH_HZ);
+        
+        printf("%-20s %8d %14.2f %14.2f %16.2f\n", configs[c].name, num_points,
+               t_lookup, t_fused, t_freq);
+    }
+    
+    srp_map_set_far_field(saved_far_field);
+    srp_map_set_dedup(SRP_DEDUP_TAU);
+    status = STATUS_OK;
+
+cleanup:
+    free(whitened);
+    free(gcc_result);
+    free(srp_result);
+    return status;
+}
+
+/**
+ * @brief 生成单个声源的加权频谱: 宽带随机相位声源按各麦克风的传播时延移相，叠加白噪声
+ */
+static void make_source_spectrum(const mic_position_t* mic_positions, float32_t x, float32_t y,
+                                 float32_t z, unsigned int* state, fft_result_t* whitened)
+{
+    float32_t phase[FFT_BINS];
+    for (int k = 0; k < FFT_BINS; k++) {
+        *state = *state * 1664525u + 1013904223u;
+        phase[k] = TWO_PI * (float32_t)(*state >> 8) / 16777216.0f;
+    }
+    
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        float32_t dx = x - mic_positions[ch].x;
+        float32_t dy = y - mic_positions[ch].y;
+        float32_t dz = z - mic_positions[ch].z;
+        float32_t delay = sqrtf(dx * dx + dy * dy + dz * dz) / SPEED_OF_SOUND * SAMPLE_RATE;
+        
+        for (int k = 0; k < FFT_BINS; k++) {
+            float32_t theta = phase[k] - TWO_PI * k * delay / FFT_SIZE;
+            *state = *state * 1664525u + 1013904223u;
+            float32_t nr = (float32_t)(*state >> 8) / 16777216.0f - 0.5f;
+            *state = *state * 1664525u + 1013904223u;
+            float32_t ni = (float32_t)(*state >> 8) / 16777216.0f - 0.5f;
+            whitened->data[ch][k].real = cosf(theta) + nr;
+            whitened->data[ch][k].imag = sinf(theta) + ni;
+        }
+    }
+    
+    gcc_phat_whiten_spectrum(whitened, whitened);
+}
+
+/**
+ * @brief SRP-Map峰值的网格索引
+ */
+static int srp_peak_index(const srp_map_t* srp_result)
+{
+    const float32_t* data = &srp_result->data[0][0][0];
+    int best = 0;
+    for (int i = 1; i < TAU_TABLE_SIZE; i++) {
+        if (data[i] > data[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+status_t benchmark_pair_selection(void)
+{
+    static const struct {
+        const char* name;
+        gcc_pair_select_t method;
+        int max_pairs;
+        int dead_mic;       /* 屏蔽的麦克风 (-1表示无) */
+    } configs[] = {
+        { "all",                GCC_PAIRS_ALL,      0, -1 },
+        { "longest 33",         GCC_PAIRS_LONGEST, 33, -1 },
+        { "greedy 33",          GCC_PAIRS_GREEDY,  33, -1 },
+        { "greedy 22",          GCC_PAIRS_GREEDY,  22, -1 },
+        { "greedy 22, mic 3 off", GCC_PAIRS_GREEDY, 22,  3 }
+    };
+    int num_configs = (int)(sizeof(configs) / sizeof(configs[0]));
+    
+    fft_result_t* sources = (fft_result_t*)malloc(BENCH_PAIR_SOURCES * sizeof(fft_result_t));
+    fft_result_t* fft_result = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    srp_map_t* srp_result = (srp_map_t*)malloc(sizeof(srp_map_t));
+    float32_t* reference = (float32_t*)malloc(BENCH_PAIR_SOURCES * TAU_TABLE_SIZE * sizeof(float32_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (sources == NULL || fft_result == NULL || gcc_result == NULL || srp_result == NULL ||
+        reference == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    status = srp_map_init(mic_positions);
+    if (status != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    /* 声源放在随机网格点上 (网格与srp_map相同)，全部对的SRP-Map为参考 */
+    unsigned int state = 12345u;
+    for (int s = 0; s < BENCH_PAIR_SOURCES; s++) {
+        state = state * 1664525u + 1013904223u;
+        int grid_idx = (int)((state >> 8) % TAU_TABLE_SIZE);
+        int e = grid_idx / (SRP_AZIMUTH_BINS * SRP_RANGE_BINS);
+        int a = grid_idx / SRP_RANGE_BINS % SRP_AZIMUTH_BINS;
+        float32_t elevation = PI * e / (SRP_ELEVATION_BINS - 1);
+        float32_t azimuth = -PI + TWO_PI * a / (SRP_AZIMUTH_BINS - 1);
+        float32_t range = 0.5f * (grid_idx % SRP_RANGE_BINS + 1);
+        make_source_spectrum(mic_positions, range * sinf(elevation) * cosf(azimuth),
+                             range * sinf(elevation) * sinf(azimuth), range * cosf(elevation),
+                             &state, &sources[s]);
+    }
+    
+    fill_random((float32_t*)fft_result->data, NUM_CHANNELS * FFT_BINS * 2);
+    
+    printf("\n========== Benchmark: Microphone Pair Selection (N=%d, %d points) ==========\n",
+           FFT_SIZE, TAU_TABLE_SIZE);
+    printf("%-22s %6s %12s %12s %14s\n", "Pairs", "Count", "GCC (us)", "Fused (us)", "Peak loss (%)");
+    
+    for (int c = 0; c < num_configs; c++) {
+        int mic_mask[NUM_CHANNELS];
+        for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+            mic_mask[ch] = (ch != configs[c].dead_mic);
+        }
+        status = gcc_phat_set_mic_mask(mic_mask);
+        if (status == STATUS_OK) {
+            status = gcc_phat_select_pairs(configs[c].method, mic_positions, configs[c].max_pairs);
+        }
+        if (status != STATUS_OK) {
+            break;
+        }
+        
+        long runs = 0;
+        clock_t start = clock();
+        do {
+            gcc_phat_compute_all(fft_result, gcc_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_gcc = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        runs = 0;
+        start = clock();
+        do {
+            srp_map_compute_fused(&sources[runs % BENCH_PAIR_SOURCES], srp_result);
+            runs++;
+        } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+        double t_fused = (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+        
+        /*
+         * 子集峰值处的全部对SRP比全部对的峰值低多少 (平均)。平面阵列对上下镜像的
+         * 俯仰角无法区分，峰值网格点本身不唯一，因此比较功率而不是网格索引
+         */
+        double loss = 0.0;
+        for (int s = 0; s < BENCH_PAIR_SOURCES; s++) {
+            float32_t* ref = reference + (size_t)s * TAU_TABLE_SIZE;
+            srp_map_compute_fused(&sources[s], srp_result);
+            if (c == 0) {
+                memcpy(ref, &srp_result->data[0][0][0], TAU_TABLE_SIZE * sizeof(float32_t));
+            }
+            
+            float32_t best = ref[0];
+            for (int i = 1; i < TAU_TABLE_SIZE; i++) {
+                best = (ref[i] > best) ? ref[i] : best;
+            }
+            loss += 1.0 - ref[srp_peak_index(srp_result)] / best;
+        }
+        
+        printf("%-22s %6d %12.2f %12.2f %14.2f\n", configs[c].name, gcc_phat_get_active_pairs(NULL),
+               t_gcc, t_fused, 100.0 * loss / BENCH_PAIR_SOURCES);
+    }
+    
+    /* 恢复全部麦克风与麦克风对 */
+    gcc_phat_set_mic_mask(NULL);
+    gcc_phat_select_pairs(GCC_PAIRS_ALL, NULL, 0);
+
+cleanup:
+    free(sources);
+    free(reference);
+    free(fft_result);
+    free(gcc_result);
+    free(srp_result);
+    return status;
+}
+
+/**
+ * @brief 二十面体SRP图单帧耗时 (微秒)
+ */
+static double time_ico_map(srp_ico_plan_t* plan, const gcc_result_t* gcc_result, float32_t* map)
+{
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        srp_ico_map_compute(plan, gcc_result, map);
+    }
+    
+    long runs = 0;
+    clock_t start = clock();
+    do {
+        srp_ico_map_compute(plan, gcc_result, map);
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+}
+
+status_t benchmark_srp_ico_layout(void)
+{
+    int max_points = SRP_ICO_POINTS(SRP_ICO_MAX_RESOLUTION);
+    fft_result_t* whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    float32_t* map_pair = (float32_t*)malloc(max_points * sizeof(float32_t));
+    float32_t* map_grid = (float32_t*)malloc(max_points * sizeof(float32_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    srp_ico_plan_t* plan = NULL;
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (whitened == NULL || gcc_result == NULL || map_pair == NULL || map_grid == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    fill_random((float32_t*)whitened->data, NUM_CHANNELS * FFT_BINS * 2);
+    gcc_phat_whiten_spectrum(whitened, whitened);
+    gcc_phat_compute_all_whitened(whitened, gcc_result);
+    
+    printf("\n========== Benchmark: Icosahedral SRP Tau Layout (%d pairs, %s gather) ==========\n",
+           gcc_phat_get_active_pairs(NULL),
+           (fft_simd_best_engine() == FFT_ENGINE_AVX2) ? "AVX2" : "scalar");
+    printf("%-4s %8s %16s %16s %10s %12s\n",
+           "r", "Points", "Pair-major (us)", "Grid-major (us)", "Speedup", "Max diff");
+    
+    for (int r = 1; r <= SRP_ICO_MAX_RESOLUTION; r++) {
+        plan = srp_ico_plan_create(r, mic_positions);
+        if (plan == NULL) {
+            goto cleanup;
+        }
+        
+        status = srp_ico_plan_set_layout(plan, SRP_ICO_LAYOUT_PAIR_MAJOR);
+        if (status != STATUS_OK) {
+            goto cleanup;
+        }
+        double t_pair = time_ico_map(plan, gcc_result, map_pair);
+        
+        status = srp_ico_plan_set_layout(plan, SRP_ICO_LAYOUT_GRID_MAJOR);
+        if (status != STATUS_OK) {
+            goto cleanup;
+        }
+        double t_grid = time_ico_map(plan, gcc_result, map_grid);
+        
+        int num_points = srp_ico_plan_num_points(plan);
+        float32_t max_diff = 0.0f;
+        for (int g = 0; g < num_points; g++) {
+            float32_t d = fabsf(map_pair[g] - map_grid[g]);
+            max_diff = (d > max_diff) ? d : max_diff;
+        }
+        
+        printf("%-4d %8d %16.2f %16.2f %9.2fx %12.2e\n",
+               r, num_points, t_pair, t_grid, t_pair / t_grid, max_diff);
+        
+        srp_ico_plan_destroy(plan);
+        plan = NULL;
+    }
+    
+    status = STATUS_OK;
+
+cleanup:
+    srp_ico_plan_destroy(plan);
+    free(whitened);
+    free(gcc_result);
+    free(map_pair);
+    free(map_grid);
+    return status;
+}
+
+/**
+ * @brief 计时层次峰值搜索的单帧耗时 (微秒)
+ */
+static double time_ico_search(srp_ico_search_t* search, const gcc_result_t* gcc_result,
+                              srp_ico_peak_t* peak)
+{
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        srp_ico_search_run(search, gcc_result, peak);
+    }
+    
+    long runs = 0;
+    clock_t start = clock();
+    do {
+        srp_ico_search_run(search, gcc_result, peak);
+        runs++;
+    } while ((double)(clock() - start) / CLOCKS_PER_SEC < BENCH_MIN_SECONDS);
+    
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / runs;
+}
+
+status_t benchmark_srp_ico_search(void)
+{
+    static const int top_k[] = { 1, SRP_ICO_SEARCH_TOP_K, 8 };
+    int num_k = (int)(sizeof(top_k) / sizeof(top_k[0]));
+    int max_points = SRP_ICO_POINTS(SRP_ICO_MAX_RESOLUTION);
+    fft_result_t* sources = (fft_result_t*)malloc(BENCH_PAIR_SOURCES * sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    float32_t* map = (float32_t*)malloc(max_points * sizeof(float32_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    srp_ico_plan_t* plan = NULL;
+    srp_ico_search_t* search = NULL;
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    if (sources == NULL || gcc_result == NULL || map == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    /* 声源方向在球面上均匀随机，距离2 m */
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    unsigned int state = 12345u;
+    for (int s = 0; s < BENCH_PAIR_SOURCES; s++) {
+        state = state * 1664525u + 1013904223u;
+        float32_t z = 2.0f * (float32_t)(state >> 8) / 16777216.0f - 1.0f;
+        state = state * 1664525u + 1013904223u;
+        float32_t azimuth = TWO_PI * (float32_t)(state >> 8) / 16777216.0f;
+        float32_t rho = sqrtf(1.0f - z * z);
+        make_source_spectrum(mic_positions, 2.0f * rho * cosf(azimuth), 2.0f * rho * sinf(azimuth),
+                             2.0f * z, &state, &sources[s]);
+    }
+    
+    printf("\n========== Benchmark: Hierarchical Icosahedral Peak Search (%d sources) ==========\n",
+           BENCH_PAIR_SOURCES);
+    printf("%-4s %4s %8s %10s %12s %16s %8s %14s\n", "r", "K", "Points", "Evaluated",
+           "Search (us)", "Exhaustive (us)", "Match", "Peak loss (%)");
+    
+    for (int r = 2; r <= SRP_ICO_MAX_RESOLUTION; r++) {
+        plan = srp_ico_plan_create(r, mic_positions);
+        if (plan == NULL) {
+            goto cleanup;
+        }
+        int num_points = srp_ico_plan_num_points(plan);
+        
+        for (int k = 0; k < num_k; k++) {
+            search = srp_ico_search_create(r, top_k[k], mic_positions);
+            if (search == NULL) {
+                goto cleanup;
+            }
+            
+            /*
+             * 与穷举图的峰值比较功率而不是索引: 平面阵列上下镜像的方向功率相同 (只差累加舍入)，
+             * 峰值网格点不唯一。归一化功率与1相差不到1e-4即视为找到峰值
+             */
+            srp_ico_peak_t peak;
+            int matches = 0;
+            double evaluated = 0.0;
+            double loss = 0.0;
+            for (int s = 0; s < BENCH_PAIR_SOURCES; s++) {
+                gcc_phat_compute_all_whitened(&sources[s], gcc_result);
+                srp_ico_map_compute(plan, gcc_result, map);
+                srp_ico_search_run(search, gcc_result, &peak);
+                
+                matches += (map[peak.index] > 1.0f - 1e-4f);
+                evaluated += peak.evaluated;
+                loss += 1.0 - map[peak.index];
+            }
+            
+            double t_search = time_ico_search(search, gcc_result, &peak);
+            double t_full = time_ico_map(plan, gcc_result, map);
+            
+            printf("%-4d %4d %8d %10.1f %12.2f %16.2f %5d/%-2d %14.2f\n", r, top_k[k], num_points,
+                   evaluated / BENCH_PAIR_SOURCES, t_search, t_full, matches, BENCH_PAIR_SOURCES,
+                   100.0 * loss / BENCH_PAIR_SOURCES);
+            
+            srp_ico_search_destroy(search);
+            search = NULL;
+        }
+        
+        srp_ico_plan_destroy(plan);
+        plan = NULL;
+    }
+    
+    status = STATUS_OK;
+
+cleanup:
+    srp_ico_search_destroy(search);
+    srp_ico_plan_destroy(plan);
+    free(sources);
+    free(gcc_result);
+    free(map);
+    return status;
+}
+
+/**
+ * @brief 计时一次二十面体SRP计划的创建 (微秒)，失败时plan为NULL
+ */
+static double time_ico_plan_create(int r, const mic_position_t* mic_positions,
+                                   srp_ico_plan_t** plan)
+{
+    clock_t start = clock();
+    *plan = srp_ico_plan_create(r, mic_positions);
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6;
+}
+
+status_t benchmark_tau_cache(void)
+{
+    int max_points = SRP_ICO_POINTS(SRP_ICO_MAX_RESOLUTION);
+    fft_result_t* whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    float32_t* map_cold = (float32_t*)malloc(max_points * sizeof(float32_t));
+    float32_t* map_warm = (float32_t*)malloc(max_points * sizeof(float32_t));
+    mic_position_t mic_positions[NUM_CHANNELS];
+    srp_ico_plan_t* cold = NULL;
+    srp_ico_plan_t* warm = NULL;
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    /* 缓存目录在计时期间会被禁用，先保存一份 (原先禁用时命中测试使用TAU_CACHE_DIR) */
+    char cache_dir[256];
+    const char* dir = tau_cache_get_dir();
+    int cache_enabled = (dir != NULL);
+    snprintf(cache_dir, sizeof(cache_dir), "%s", cache_enabled ? dir : TAU_CACHE_DIR);
+    
+    if (whitened == NULL || gcc_result == NULL || map_cold == NULL || map_warm == NULL ||
+        fft_init() != STATUS_OK || gcc_phat_init() != STATUS_OK) {
+        goto cleanup;
+    }
+    
+    test_data_generate_mic_positions(mic_positions, 0.05f);
+    fill_random((float32_t*)whitened->data, NUM_CHANNELS * FFT_BINS * 2);
+    gcc_phat_whiten_spectrum(whitened, whitened);
+    gcc_phat_compute_all_whitened(whitened, gcc_result);
+    
+    printf("\n========== Benchmark: Tau Table Cache (%d pairs, %s) ==========\n",
+           NUM_MIC_PAIRS, cache_dir);
+    printf("%-4s %8s %16s %16s %10s %12s\n",
+           "r", "Points", "Compute (us)", "Cached (us)", "Speedup", "Max diff");
+    
+    for (int r = 1; r <= SRP_ICO_MAX_RESOLUTION; r++) {
+        /* 冷启动: 禁用缓存，逐对逐网格点计算时延 */
+        tau_cache_set_dir(NULL);
+        double t_cold = time_ico_plan_create(r, mic_positions, &cold);
+        tau_cache_set_dir(cache_dir);
+        
+        /* 先创建一次保证缓存文件存在，再计时命中 */
+        srp_ico_plan_destroy(srp_ico_plan_create(r, mic_positions));
+        double t_warm = time_ico_plan_create(r, mic_positions, &warm);
+        if (cold == NULL || warm == NULL) {
+            goto cleanup;
+        }
+        
+        status = srp_ico_map_compute(cold, gcc_result, map_cold);
+        if (status == STATUS_OK) {
+            status = srp_ico_map_compute(warm, gcc_result, map_warm);
+        }
+        if (status != STATUS_OK) {
+            goto cleanup;
+        }
+        
+        int num_points = srp_ico_plan_num_points(cold);
+        float32_t max_diff = 0.0f;
+        for (int g = 0; g < num_points; g++) {
+            float32_t d = fabsf(map_cold[g] - map_warm[g]);
+            max_diff = (d > max_diff) ? d : max_diff;
+        }
+        
+        /* 缓存写不进去 (目录不可写) 时暖启动也是重新计算，不报加速比 */
+        if (srp_ico_plan_is_cache_mapped(warm)) {
+            printf("%-4d %8d %16.1f %16.1f %9.2fx %12.2e\n",
+                   r, num_points, t_cold, t_warm, t_cold / (t_warm > 0.0 ? t_warm : 1.0), max_diff);
+        } else {
+            printf("%-4d %8d %16.1f %16s %10s %12.2e\n",
+                   r, num_points, t_cold, "not mapped", "skipped", max_diff);
+        }
+        
+        srp_ico_plan_destroy(cold);
+        srp_ico_plan_destroy(warm);
+        cold = NULL;
+        warm = NULL;
+    }
+    
+    status = STATUS_OK;
+
+cleanup:
+    tau_cache_set_dir(cache_enabled ? cache_dir : NULL);
+    srp_ico_plan_destroy(cold);
+    srp_ico_plan_destroy(warm);
+    free(whitened);
+    free(gcc_result);
+    free(map_cold);
+    free(map_warm);
+    return status;
+}
+
+status_t benchmark_gcc_parallel(void)
+{
+    fft_result_t* fft_result = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    if (fft_result == NULL || gcc_result == NULL || fft_init() != STATUS_OK ||
+        gcc_phat_init() != STATUS_OK) {
+        free(fft_result);
+        free(gcc_result);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    fill_random((float32_t*)fft_result->data, NUM_CHANNELS * FFT_BINS * 2);
+    
+    gcc_ctx_t* ctx = gcc_ctx_create();
+    if (ctx == NULL) {
+        free(fft_result);
+        free(gcc_result);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    int cpus = thread_pool_cpu_count();
+    printf("\n========== Benchmark: Parallel GCC-PHAT (N=%d, %d pairs, %d CPUs) ==========\n",
+           FFT_SIZE, NUM_MIC_PAIRS, cpus);
+    printf("%-16s %14s %10s\n", "Threads", "Frame (us)", "Speedup");
+    
+    /* 串行基准: 单个上下文 */
+    for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+        gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+    }
+    long runs = 0;
+    double start = wall_seconds();
+    do {
+        gcc_ctx_compute_all(ctx, fft_result, gcc_result);
+        runs++;
+    } while (wall_seconds() - start < BENCH_MIN_SECONDS);
+    double t_serial = (wall_seconds() - start) * 1e6 / runs;
+    printf("%-16s %14.2f %10s\n", "serial", t_serial, "1.00x");
+    gcc_ctx_destroy(ctx);
+    
+    /* 线程数按2的幂增加，最后补上处理器核数 */
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > cpus) {
+            threads = cpus;
+        }
+        
+        gcc_pool_t* pool = gcc_pool_create(threads);
+        if (pool == NULL) {
+            break;
+        }
+        
+        for (int i = 0; i < BENCH_WARMUP_RUNS; i++) {
+            gcc_phat_compute_all_parallel(pool, fft_result, gcc_result);
+        }
+        runs = 0;
+        start = wall_seconds();
+        do {
+            gcc_phat_compute_all_parallel(pool, fft_result, gcc_result);
+            runs++;
+        } while (wall_seconds() - start < BENCH_MIN_SECONDS);
+        double t = (wall_seconds() - start) * 1e6 / runs;
+        
+        char label[32];
+        sprintf(label, "pool x%d", threads);
+        printf("%-16s %14.2f %9.2fx\n", label, t, t_serial / t);
+        gcc_pool_destroy(pool);
+        
+        if (threads == cpus) {
+            break;
+        }
+    }
+    
+    free(fft_result);
+    free(gcc_result);
+    
+    return STATUS_OK;
+}
+
+status_t benchmark_run_all(void)
+{
+    status_t status = benchmark_fft_algorithms();
+    if (status != STATUS_OK) {
+        printf("[ERROR] FFT benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_fft_mixed_radix();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Mixed-radix FFT benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_fft_batch();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Batched FFT benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_fft_lags();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Lag-windowed IFFT benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_gcc_ifft_modes();
+    if (status != STATUS_OK) {
+        printf("[ERROR] GCC inverse transform benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_gcc_weightings();
+    if (status != STATUS_OK) {
+        printf("[ERROR] GCC weighting benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_gcc_band();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Band-limited GCC benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_srp_engines();
+    if (status != STATUS_OK) {
+        printf("[ERROR] SRP engine benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_srp_interp();
+    if (status != STATUS_OK) {
+        printf("[ERROR] SRP interpolation benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_srp_far_field();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Far-field SRP benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_pair_selection();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Pair selection benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_srp_ico_layout();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Icosahedral SRP layout benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_srp_ico_search();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Hierarchical search benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_tau_cache();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Tau cache benchmark failed\n");
+        return status;
+    }
+    
+    status = benchmark_gcc_parallel();
+    if (status != STATUS_OK) {
+        printf("[ERROR] Parallel GCC benchmark failed\n");
+        return status;
+    }
+    
+    return STATUS_OK;
+}
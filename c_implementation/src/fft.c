@@ -4,7 +4,11 @@
  * @author Cross3D C Implementation
  * @date 2024
  * 
- * 采用Cooley-Tukey基2 FFT算法实现
+ * 采用Cooley-Tukey基4 FFT算法实现 (点数为2的奇数次幂时首级为基2)
+ * 可在创建计划时选择位反转变体或Stockham自排序变体
+ * 实数FFT采用N/2点复数FFT + 后处理旋转的打包方式
+ * 所有变换基于FFT计划(fft_plan_t)，旧接口使用FFT_SIZE点的默认计划
+ * x86平台上计划默认使用SIMD引擎 (见fft_simd.c)
  */
 
 #include <stdio.h>
@@ -12,12 +16,13 @@
 #include <string.h>
 #include <math.h>
 #include "fft.h"
+#include "fft_simd.h"
+#include "fft_batch.h"
 
 /*============================================================================
  * 静态变量
  *============================================================================*/
-static complex_t* g_twiddle_factors = NULL;  /* 旋转因子 */
-static int* g_bit_reverse_table = NULL;       /* 位反转表 */
+static fft_plan_t* g_default_plan = NULL;     /* FFT_SIZE点默认计划 */
 static int g_fft_initialized = 0;
 
 /*============================================================================
@@ -92,160 +97,837 @@ static complex_t complex_sub(complex_t a, complex_t b)
 }
 
 /*============================================================================
- * FFT核心函数
+ * FFT计划
  *============================================================================*/
 
-status_t fft_init(void)
+/**
+ * @brief 将n分解为Stockham各级的基
+ * 
+ * 依次尽量取4，再取2、3、5；基4优先使2的幂点数与纯基4变体的级数相同。
+ * 
+ * @param n 变换点数
+ * @param radices 输出各级的基 (至多FFT_MAX_STAGES级)
+ * @return 级数；n含2、3、5以外的因子时返回0
+ */
+static int stockham_factorize(int n, int* radices)
 {
-    if (g_fft_initialized) {
-        return STATUS_OK;
+    static const int candidates[] = {4, 2, 3, 5};
+    int stages = 0;
+    
+    for (int i = 0; i < 4; i++) {
+        int r = candidates[i];
+        while (n % r == 0 && stages < FFT_MAX_STAGES) {
+            radices[stages++] = r;
+            n /= r;
+        }
     }
     
-    int log2n = log2_int(FFT_SIZE);
+    return (n == 1) ? stages : 0;
+}
+
+/**
+ * @brief 生成Stockham逐级旋转因子表
+ * 
+ * 子变换长度L从n开始逐级除以该级的基r，每级存放p < L/r的
+ * (W_L^p, W_L^2p, ..., W_L^(r-1)p)，共 (r-1) * L/r 个元素
+ */
+static status_t stockham_init(fft_plan_t* plan)
+{
+    int n = plan->n;
     
-    /* 分配旋转因子内存 */
-    g_twiddle_factors = (complex_t*)malloc(FFT_SIZE / 2 * sizeof(complex_t));
-    if (g_twiddle_factors == NULL) {
-        return STATUS_ERROR_MEMORY_ALLOC;
+    plan->stockham_stages = stockham_factorize(n, plan->stockham_radix);
+    if (plan->stockham_stages == 0) {
+        return STATUS_ERROR_INVALID_PARAM;
     }
     
-    /* 预计算旋转因子 W_N^k = exp(-j * 2 * pi * k / N) */
-    for (int k = 0; k < FFT_SIZE / 2; k++) {
-        float32_t angle = -TWO_PI * k / FFT_SIZE;
-        g_twiddle_factors[k].real = cosf(angle);
-        g_twiddle_factors[k].imag = sinf(angle);
+    int total = 0;
+    for (int i = 0, len = n; i < plan->stockham_stages; len /= plan->stockham_radix[i], i++) {
+        total += (plan->stockham_radix[i] - 1) * (len / plan->stockham_radix[i]);
     }
     
-    /* 分配位反转表内存 */
-    g_bit_reverse_table = (int*)malloc(FFT_SIZE * sizeof(int));
-    if (g_bit_reverse_table == NULL) {
-        free(g_twiddle_factors);
+    plan->stockham_twiddles = (complex_t*)malloc((total > 0 ? total : 1) * sizeof(complex_t));
+    plan->stockham_work = (complex_t*)malloc(n * sizeof(complex_t));
+    if (plan->stockham_twiddles == NULL || plan->stockham_work == NULL) {
         return STATUS_ERROR_MEMORY_ALLOC;
     }
     
-    /* 预计算位反转索引 */
-    for (int i = 0; i < FFT_SIZE; i++) {
-        g_bit_reverse_table[i] = bit_reverse(i, log2n);
+    complex_t* stage = plan->stockham_twiddles;
+    int len = n;
+    for (int i = 0; i < plan->stockham_stages; i++) {
+        int radix = plan->stockham_radix[i];
+        for (int p = 0; p < len / radix; p++) {
+            for (int r = 1; r < radix; r++) {
+                float32_t angle = -TWO_PI * r * p / len;
+                stage->real = cosf(angle);
+                stage->imag = sinf(angle);
+                stage++;
+            }
+        }
+        len /= radix;
     }
     
-    g_fft_initialized = 1;
-    printf("[INFO] FFT module initialized (N=%d)\n", FFT_SIZE);
-    
     return STATUS_OK;
 }
 
-void fft_cleanup(void)
+/**
+ * @brief 创建n点复数计划 (旋转因子表 + 位反转表，或Stockham旋转因子表)
+ */
+static fft_plan_t* plan_create_complex(int n, fft_engine_t engine, fft_algorithm_t algorithm)
 {
-    if (g_twiddle_factors != NULL) {
-        free(g_twiddle_factors);
-        g_twiddle_factors = NULL;
+    fft_plan_t* plan = (fft_plan_t*)calloc(1, sizeof(fft_plan_t));
+    if (plan == NULL) {
+        return NULL;
     }
-    if (g_bit_reverse_table != NULL) {
-        free(g_bit_reverse_table);
-        g_bit_reverse_table = NULL;
+    
+    plan->n = n;
+    plan->log2n = log2_int(n);
+    plan->engine = engine;
+    plan->algorithm = algorithm;
+    
+    if (algorithm == FFT_ALGO_STOCKHAM) {
+        if (stockham_init(plan) != STATUS_OK) {
+            fft_plan_destroy(plan);
+            return NULL;
+        }
+        return plan;
     }
-    g_fft_initialized = 0;
-}
-
-status_t fft_forward(const float32_t* input, complex_t* output, int n)
-{
-    if (!g_fft_initialized) {
-        return STATUS_ERROR_FFT_FAILED;
+    
+    plan->twiddles = (complex_t*)malloc(n * sizeof(complex_t));
+    plan->bit_reverse = (int*)malloc(n * sizeof(int));
+    if (plan->twiddles == NULL || plan->bit_reverse == NULL) {
+        fft_plan_destroy(plan);
+        return NULL;
     }
     
-    int log2n = log2_int(n);
+    /*
+     * 基4阶段按顺序连续存放: 四分之一蝶形大小为h的阶段占3h个元素，
+     * 第j组为 (W^j, W^2j, W^3j), W = W_{4h}
+     * log2n为奇数时首先执行一级基2阶段 (旋转因子恒为1，无需存储)
+     */
+    complex_t* stage = plan->twiddles;
+    for (int h = (plan->log2n & 1) ? 2 : 1; 4 * h <= n; h <<= 2) {
+        for (int j = 0; j < h; j++) {
+            for (int r = 1; r <= 3; r++) {
+                float32_t angle = -TWO_PI * r * j / (4 * h);
+                stage->real = cosf(angle);
+                stage->imag = sinf(angle);
+                stage++;
+            }
+        }
+    }
     
-    /* 位反转重排 + 实数转复数 */
     for (int i = 0; i < n; i++) {
-        int j = g_bit_reverse_table[i];
-        output[j].real = input[i];
-        output[j].imag = 0.0f;
+        plan->bit_reverse[i] = bit_reverse(i, plan->log2n);
+    }
+    
+    /* SIMD引擎: 准备SoA旋转因子表和工作缓冲区 */
+    if (engine != FFT_ENGINE_SCALAR && fft_simd_plan_init(plan) != STATUS_OK) {
+        fft_plan_destroy(plan);
+        return NULL;
     }
     
-    /* Cooley-Tukey 蝶形运算 */
-    for (int stage = 1; stage <= log2n; stage++) {
-        int m = 1 << stage;          /* 当前阶段的蝶形大小 */
-        int m2 = m >> 1;             /* 半蝶形大小 */
-        int step = FFT_SIZE / m;     /* 旋转因子步长 */
+    return plan;
+}
+
+/**
+ * @brief 对已位反转排列的数据执行基4蝶形运算 (原位)
+ * @param plan 复数计划
+ * @param data 输入/输出复数数据 (plan->n点)
+ * @param inverse 非零时使用共轭旋转因子 (IFFT, 不含归一化)
+ * 
+ * 位反转排列下，每个4h点块依次包含余数为0/2/1/3的四个h点子DFT:
+ *   X[j+qh] = sum_r W_{4h}^(rj) * (-j)^(rq) * F_r[j]
+ * 每个蝶形只需3次复数乘法，±1/±j因子与j=0的单位旋转因子不做乘法。
+ */
+static void plan_butterfly_stages(const fft_plan_t* plan, complex_t* data, int inverse)
+{
+    int n = plan->n;
+    int h = 1;
+    
+    /* log2n为奇数: 首级基2蝶形 (W = 1) */
+    if (plan->log2n & 1) {
+        for (int k = 0; k < n; k += 2) {
+            float32_t ur = data[k].real, ui = data[k].imag;
+            float32_t vr = data[k + 1].real, vi = data[k + 1].imag;
+            data[k].real = ur + vr;
+            data[k].imag = ui + vi;
+            data[k + 1].real = ur - vr;
+            data[k + 1].imag = ui - vi;
+        }
+        h = 2;
+    }
+    
+    /* IFFT时 -j 因子变为 +j，旋转因子取共轭 */
+    float32_t sign = inverse ? -1.0f : 1.0f;
+    const complex_t* stage = plan->twiddles;
+    
+    for (; 4 * h <= n; h <<= 2) {
+        int m = 4 * h;               /* 当前阶段的蝶形大小 */
         
         for (int k = 0; k < n; k += m) {
-            for (int j = 0; j < m2; j++) {
-                complex_t w = g_twiddle_factors[j * step];
-                complex_t t = complex_multiply(w, output[k + j + m2]);
-                complex_t u = output[k + j];
+            complex_t* p0 = data + k;
+            complex_t* p1 = p0 + h;
+            complex_t* p2 = p1 + h;
+            complex_t* p3 = p2 + h;
+            
+            for (int j = 0; j < h; j++) {
+                /* 余数0/2/1/3的子DFT分别位于 p0/p1/p2/p3 */
+                float32_t t0r = p0[j].real, t0i = p0[j].imag;
+                float32_t t2r = p1[j].real, t2i = p1[j].imag;
+                float32_t t1r = p2[j].real, t1i = p2[j].imag;
+                float32_t t3r = p3[j].real, t3i = p3[j].imag;
+                
+                if (j > 0) {
+                    const complex_t* w = stage + 3 * j;
+                    float32_t wr, wi, xr;
+                    
+                    wr = w[0].real; wi = sign * w[0].imag;
+                    xr = t1r * wr - t1i * wi;
+                    t1i = t1r * wi + t1i * wr;
+                    t1r = xr;
+                    
+                    wr = w[1].real; wi = sign * w[1].imag;
+                    xr = t2r * wr - t2i * wi;
+                    t2i = t2r * wi + t2i * wr;
+                    t2r = xr;
+                    
+                    wr = w[2].real; wi = sign * w[2].imag;
+                    xr = t3r * wr - t3i * wi;
+                    t3i = t3r * wi + t3i * wr;
+                    t3r = xr;
+                }
                 
-                output[k + j] = complex_add(u, t);
-                output[k + j + m2] = complex_sub(u, t);
+                float32_t ar = t0r + t2r, ai = t0i + t2i;   /* t0 + t2 */
+                float32_t br = t0r - t2r, bi = t0i - t2i;   /* t0 - t2 */
+                float32_t cr = t1r + t3r, ci = t1i + t3i;   /* t1 + t3 */
+                float32_t dr = t1r - t3r, di = t1i - t3i;   /* t1 - t3 */
+                
+                /* -j * d (正向) 或 +j * d (逆向) */
+                float32_t er = sign * di, ei = -sign * dr;
+                
+                p0[j].real = ar + cr;
+                p0[j].imag = ai + ci;
+                p1[j].real = br + er;
+                p1[j].imag = bi + ei;
+                p2[j].real = ar - cr;
+                p2[j].imag = ai - ci;
+                p3[j].real = br - er;
+                p3[j].imag = bi - ei;
             }
         }
+        
+        stage += 3 * h;
     }
+}
+
+/**
+ * @brief 复数乘法 (旋转因子的虚部已按变换方向取号)
+ */
+#define STOCKHAM_TWIDDLE(dst, tr, ti, wr, wi) \
+    do { \
+        (dst).real = (tr) * (wr) - (ti) * (wi); \
+        (dst).imag = (tr) * (wi) + (ti) * (wr); \
+    } while (0)
+
+/**
+ * @brief Stockham基2级
+ * @param x 本级输入
+ * @param y 本级输出
+ * @param s 步长
+ * @param m 子变换长度L / 2
+ * @param tw 本级旋转因子 (每个p一个元素)
+ * @param sign 正向为1，逆向为-1
+ */
+static void stockham_radix2(const complex_t* x, complex_t* y, int s, int m,
+                            const complex_t* tw, float32_t sign)
+{
+    for (int p = 0; p < m; p++) {
+        const complex_t* a = x + s * p;
+        const complex_t* b = a + s * m;
+        complex_t* y0 = y + s * 2 * p;
+        complex_t* y1 = y0 + s;
+        
+        float32_t w1r = tw[p].real, w1i = sign * tw[p].imag;
+        
+        for (int q = 0; q < s; q++) {
+            float32_t ar = a[q].real, ai = a[q].imag;
+            float32_t br = b[q].real, bi = b[q].imag;
+            y0[q].real = ar + br;
+            y0[q].imag = ai + bi;
+            STOCKHAM_TWIDDLE(y1[q], ar - br, ai - bi, w1r, w1i);
+        }
+    }
+}
+
+/**
+ * @brief Stockham基3级 (参数同stockham_radix2，每个p两个旋转因子)
+ * 
+ * 令 d = b - c, t = a - (b + c)/2，则
+ *   y0 = a + b + c, y1 = t - j*sign*(sqrt(3)/2)*d, y2 = t + j*sign*(sqrt(3)/2)*d
+ */
+static void stockham_radix3(const complex_t* x, complex_t* y, int s, int m,
+                            const complex_t* tw, float32_t sign)
+{
+    const float32_t s3 = sign * 0.86602540378443864676f;   /* sin(2*pi/3) */
     
-    return STATUS_OK;
+    for (int p = 0; p < m; p++) {
+        const complex_t* a = x + s * p;
+        const complex_t* b = a + s * m;
+        const complex_t* c = b + s * m;
+        complex_t* y0 = y + s * 3 * p;
+        complex_t* y1 = y0 + s;
+        complex_t* y2 = y1 + s;
+        
+        float32_t w1r = tw[2 * p].real, w1i = sign * tw[2 * p].imag;
+        float32_t w2r = tw[2 * p + 1].real, w2i = sign * tw[2 * p + 1].imag;
+        
+        for (int q = 0; q < s; q++) {
+            float32_t sr = b[q].real + c[q].real, si = b[q].imag + c[q].imag;
+            float32_t dr = b[q].real - c[q].real, di = b[q].imag - c[q].imag;
+            float32_t tr = a[q].real - 0.5f * sr, ti = a[q].imag - 0.5f * si;
+            
+            /* -j * sign * sin(2*pi/3) * d */
+            float32_t ur = s3 * di, ui = -s3 * dr;
+            
+            y0[q].real = a[q].real + sr;
+            y0[q].imag = a[q].imag + si;
+            STOCKHAM_TWIDDLE(y1[q], tr + ur, ti + ui, w1r, w1i);
+            STOCKHAM_TWIDDLE(y2[q], tr - ur, ti - ui, w2r, w2i);
+        }
+    }
 }
 
-status_t fft_inverse(const complex_t* input, complex_t* output, int n)
+/**
+ * @brief Stockham基4级 (参数同stockham_radix2，每个p三个旋转因子)
+ */
+static void stockham_radix4(const complex_t* x, complex_t* y, int s, int m,
+                            const complex_t* tw, float32_t sign)
 {
-    if (!g_fft_initialized) {
-        return STATUS_ERROR_FFT_FAILED;
+    for (int p = 0; p < m; p++) {
+        const complex_t* a = x + s * p;
+        const complex_t* b = a + s * m;
+        const complex_t* c = b + s * m;
+        const complex_t* d = c + s * m;
+        complex_t* y0 = y + s * 4 * p;
+        complex_t* y1 = y0 + s;
+        complex_t* y2 = y1 + s;
+        complex_t* y3 = y2 + s;
+        
+        float32_t w1r = tw[3 * p].real, w1i = sign * tw[3 * p].imag;
+        float32_t w2r = tw[3 * p + 1].real, w2i = sign * tw[3 * p + 1].imag;
+        float32_t w3r = tw[3 * p + 2].real, w3i = sign * tw[3 * p + 2].imag;
+        
+        for (int q = 0; q < s; q++) {
+            float32_t ar = a[q].real + c[q].real, ai = a[q].imag + c[q].imag;   /* a + c */
+            float32_t br = a[q].real - c[q].real, bi = a[q].imag - c[q].imag;   /* a - c */
+            float32_t cr = b[q].real + d[q].real, ci = b[q].imag + d[q].imag;   /* b + d */
+            float32_t dr = b[q].real - d[q].real, di = b[q].imag - d[q].imag;   /* b - d */
+            
+            /* -j * (b - d) (正向) 或 +j * (b - d) (逆向) */
+            float32_t er = sign * di, ei = -sign * dr;
+            
+            y0[q].real = ar + cr;
+            y0[q].imag = ai + ci;
+            STOCKHAM_TWIDDLE(y1[q], br + er, bi + ei, w1r, w1i);
+            STOCKHAM_TWIDDLE(y2[q], ar - cr, ai - ci, w2r, w2i);
+            STOCKHAM_TWIDDLE(y3[q], br - er, bi - ei, w3r, w3i);
+        }
     }
+}
+
+/**
+ * @brief Stockham基5级 (参数同stockham_radix2，每个p四个旋转因子)
+ * 
+ * 利用 W_5^k 与 W_5^(5-k) 共轭的对称性:
+ *   t1 = b + e, t2 = b - e, t3 = c + d, t4 = c - d
+ *   y1/y4 = a + c1*t1 + c2*t3 -/+ j*sign*(s1*t2 + s2*t4)
+ *   y2/y3 = a + c2*t1 + c1*t3 -/+ j*sign*(s2*t2 - s1*t4)
+ * 其中 c1 = cos(2*pi/5), c2 = cos(4*pi/5), s1 = sin(2*pi/5), s2 = sin(4*pi/5)
+ */
+static void stockham_radix5(const complex_t* x, complex_t* y, int s, int m,
+                            const complex_t* tw, float32_t sign)
+{
+    const float32_t c1 = 0.30901699437494742410f;
+    const float32_t c2 = -0.80901699437494742410f;
+    const float32_t s1 = sign * 0.95105651629515357212f;
+    const float32_t s2 = sign * 0.58778525229247312917f;
     
-    int log2n = log2_int(n);
+    for (int p = 0; p < m; p++) {
+        const complex_t* a = x + s * p;
+        const complex_t* b = a + s * m;
+        const complex_t* c = b + s * m;
+        const complex_t* d = c + s * m;
+        const complex_t* e = d + s * m;
+        complex_t* y0 = y + s * 5 * p;
+        complex_t* y1 = y0 + s;
+        complex_t* y2 = y1 + s;
+        complex_t* y3 = y2 + s;
+        complex_t* y4 = y3 + s;
+        
+        const complex_t* w = tw + 4 * p;
+        float32_t w1r = w[0].real, w1i = sign * w[0].imag;
+        float32_t w2r = w[1].real, w2i = sign * w[1].imag;
+        float32_t w3r = w[2].real, w3i = sign * w[2].imag;
+        float32_t w4r = w[3].real, w4i = sign * w[3].imag;
+        
+        for (int q = 0; q < s; q++) {
+            float32_t ar = a[q].real, ai = a[q].imag;
+            float32_t t1r = b[q].real + e[q].real, t1i = b[q].imag + e[q].imag;
+            float32_t t2r = b[q].real - e[q].real, t2i = b[q].imag - e[q].imag;
+            float32_t t3r = c[q].real + d[q].real, t3i = c[q].imag + d[q].imag;
+            float32_t t4r = c[q].real - d[q].real, t4i = c[q].imag - d[q].imag;
+            
+            float32_t m1r = ar + c1 * t1r + c2 * t3r, m1i = ai + c1 * t1i + c2 * t3i;
+            float32_t m2r = ar + c2 * t1r + c1 * t3r, m2i = ai + c2 * t1i + c1 * t3i;
+            float32_t n1r = s1 * t2r + s2 * t4r, n1i = s1 * t2i + s2 * t4i;
+            float32_t n2r = s2 * t2r - s1 * t4r, n2i = s2 * t2i - s1 * t4i;
+            
+            y0[q].real = ar + t1r + t3r;
+            y0[q].imag = ai + t1i + t3i;
+            
+            /* -j * n = (n.imag, -n.real) */
+            STOCKHAM_TWIDDLE(y1[q], m1r + n1i, m1i - n1r, w1r, w1i);
+            STOCKHAM_TWIDDLE(y4[q], m1r - n1i, m1i + n1r, w4r, w4i);
+            STOCKHAM_TWIDDLE(y2[q], m2r + n2i, m2i - n2r, w2r, w2i);
+            STOCKHAM_TWIDDLE(y3[q], m2r - n2i, m2i + n2r, w3r, w3i);
+        }
+    }
+}
+
+/**
+ * @brief Stockham自排序FFT (混合基频域抽取，不含归一化)
+ * @param plan 复数计划 (FFT_ALGO_STOCKHAM)
+ * @param input 自然顺序输入 (plan->n点)
+ * @param output 自然顺序输出 (plan->n点, 可与input相同)
+ * @param inverse 非零时使用共轭旋转因子
+ * 
+ * 子变换长度为L、步长为s (L*s = n)、基为r的一级, m = L/r:
+ *   y[q + s(rp+k)] = W_L^(kp) * sum_t x[q + s(p+tm)] * W_r^(kt)
+ * 输出直接按自然顺序落位，无需位反转重排；各级在output与stockham_work
+ * 之间交替读写，按级数奇偶选择首级的写入目标，使末级恰好写入output。
+ */
+static void stockham_transform(const fft_plan_t* plan,
+                               const complex_t* input,
+                               complex_t* output,
+                               int inverse)
+{
+    int n = plan->n;
+    int stages = plan->stockham_stages;
+    complex_t* work = plan->stockham_work;
     
-    /* 位反转重排 */
-    for (int i = 0; i < n; i++) {
-        int j = g_bit_reverse_table[i];
-        output[j] = input[i];
+    /* 级数为奇数时首级写入output，原位执行需先把输入移到工作缓冲区 */
+    const complex_t* x = input;
+    if (input == output && (stages & 1)) {
+        memcpy(work, input, n * sizeof(complex_t));
+        x = work;
     }
+    complex_t* y = (stages & 1) ? output : work;
+    
+    float32_t sign = inverse ? -1.0f : 1.0f;
+    const complex_t* stage = plan->stockham_twiddles;
+    int len = n;
+    int s = 1;
     
-    /* IFFT: 使用共轭旋转因子 */
-    for (int stage = 1; stage <= log2n; stage++) {
-        int m = 1 << stage;
-        int m2 = m >> 1;
-        int step = FFT_SIZE / m;
+    for (int i = 0; i < stages; i++) {
+        int radix = plan->stockham_radix[i];
+        int m = len / radix;
         
-        for (int k = 0; k < n; k += m) {
-            for (int j = 0; j < m2; j++) {
-                /* IFFT使用共轭旋转因子 */
-                complex_t w = complex_conjugate(g_twiddle_factors[j * step]);
-                complex_t t = complex_multiply(w, output[k + j + m2]);
-                complex_t u = output[k + j];
-                
-                output[k + j] = complex_add(u, t);
-                output[k + j + m2] = complex_sub(u, t);
+        switch (radix) {
+            case 2:  stockham_radix2(x, y, s, m, stage, sign); break;
+            case 3:  stockham_radix3(x, y, s, m, stage, sign); break;
+            case 4:  stockham_radix4(x, y, s, m, stage, sign); break;
+            default: stockham_radix5(x, y, s, m, stage, sign); break;
+        }
+        
+        stage += (radix - 1) * m;
+        len = m;
+        s *= radix;
+        x = y;
+        y = (y == output) ? work : output;
+    }
+}
+
+fft_plan_t* fft_plan_create(int n)
+{
+    return fft_plan_create_ex(n, NULL);
+}
+
+fft_plan_t* fft_plan_create_ex(int n, const fft_plan_options_t* options)
+{
+    /* 支持 n >= 4 的偶数 2^a * 3^b * 5^c (实数变换需要N/2点子计划) */
+    int radices[FFT_MAX_STAGES];
+    if (n < 4 || (n & 1) != 0 || stockham_factorize(n, radices) == 0) {
+        printf("[ERROR] Unsupported FFT size: %d\n", n);
+        return NULL;
+    }
+    int pow2 = ((n & (n - 1)) == 0);
+    
+    /* 选择执行引擎: 请求的引擎不受支持时退化为可用的最佳引擎 */
+    fft_engine_t best = fft_simd_best_engine();
+    fft_engine_t engine = (options != NULL) ? options->engine : FFT_ENGINE_AUTO;
+    if (engine == FFT_ENGINE_AUTO || engine > best) {
+        engine = best;
+    }
+    
+    /* 非2的幂点数只能使用混合基Stockham变体；Stockham变体目前只有标量实现 */
+    fft_algorithm_t algorithm = (options != NULL) ? options->algorithm : FFT_ALGO_BIT_REVERSE;
+    if (!pow2) {
+        algorithm = FFT_ALGO_STOCKHAM;
+    }
+    if (algorithm == FFT_ALGO_STOCKHAM) {
+        engine = FFT_ENGINE_SCALAR;
+    }
+    
+    fft_plan_t* plan = plan_create_complex(n, engine, algorithm);
+    if (plan == NULL) {
+        return NULL;
+    }
+    
+    int half = n / 2;
+    plan->half = plan_create_complex(half, engine, algorithm);
+    plan->real_twiddles = (complex_t*)malloc(half * sizeof(complex_t));
+    plan->work = (complex_t*)malloc(half * sizeof(complex_t));
+    if (plan->half == NULL || plan->real_twiddles == NULL || plan->work == NULL) {
+        fft_plan_destroy(plan);
+        return NULL;
+    }
+    
+    /* 位反转变体支持多通道批量变换 */
+    if (algorithm == FFT_ALGO_BIT_REVERSE && fft_batch_plan_init(plan) != STATUS_OK) {
+        fft_plan_destroy(plan);
+        return NULL;
+    }
+    
+    /* 实数变换后处理旋转因子 W_N^k = exp(-j * 2 * pi * k / N) */
+    for (int k = 0; k < half; k++) {
+        float32_t angle = -TWO_PI * k / n;
+        plan->real_twiddles[k].real = cosf(angle);
+        plan->real_twiddles[k].imag = sinf(angle);
+    }
+    
+    return plan;
+}
+
+void fft_plan_destroy(fft_plan_t* plan)
+{
+    if (plan == NULL) {
+        return;
+    }
+    
+    fft_plan_destroy(plan->half);
+    fft_simd_plan_free(plan);
+    fft_batch_plan_free(plan);
+    free(plan->twiddles);
+    free(plan->bit_reverse);
+    free(plan->real_twiddles);
+    free(plan->work);
+    free(plan->stockham_twiddles);
+    free(plan->stockham_work);
+    free(plan);
+}
+
+status_t fft_plan_execute(const fft_plan_t* plan,
+                          const complex_t* input,
+                          complex_t* output,
+                          fft_direction_t direction)
+{
+    if (plan == NULL || input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (plan->engine != FFT_ENGINE_SCALAR) {
+        return fft_simd_execute(plan, input, output, direction);
+    }
+    
+    int n = plan->n;
+    int inverse = (direction == FFT_BACKWARD);
+    
+    if (plan->algorithm == FFT_ALGO_STOCKHAM) {
+        /* Stockham自排序: 输出直接为自然顺序 */
+        stockham_transform(plan, input, output, inverse);
+    } else {
+        /* 位反转重排 (原位时两两交换) */
+        if (input == output) {
+            for (int i = 0; i < n; i++) {
+                int j = plan->bit_reverse[i];
+                if (i < j) {
+                    complex_t tmp = output[i];
+                    output[i] = output[j];
+                    output[j] = tmp;
+                }
+            }
+        } else {
+            for (int i = 0; i < n; i++) {
+                output[plan->bit_reverse[i]] = input[i];
             }
         }
+        
+        /* Cooley-Tukey 蝶形运算 (IFFT使用共轭旋转因子) */
+        plan_butterfly_stages(plan, output, inverse);
     }
     
-    /* 归一化 */
-    float32_t scale = 1.0f / n;
-    for (int i = 0; i < n; i++) {
-        output[i].real *= scale;
-        output[i].imag *= scale;
+    /* IFFT归一化 */
+    if (inverse) {
+        float32_t scale = 1.0f / n;
+        for (int i = 0; i < n; i++) {
+            output[i].real *= scale;
+            output[i].imag *= scale;
+        }
     }
     
     return STATUS_OK;
 }
 
-status_t fft_execute_real(const audio_frame_t* frame, fft_result_t* result)
+status_t fft_plan_execute_r2c(const fft_plan_t* plan,
+                              const float32_t* input,
+                              complex_t* output)
 {
-    static complex_t temp_buffer[FFT_SIZE];
+    if (plan == NULL || input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (plan->engine != FFT_ENGINE_SCALAR) {
+        return fft_simd_execute_r2c(plan, input, output);
+    }
+    
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
     
-    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
-        /* 执行FFT */
-        status_t status = fft_forward(frame->data[ch], temp_buffer, FFT_SIZE);
-        if (status != STATUS_OK) {
-            return status;
+    /*
+     * 步骤1: 偶/奇采样打包为N/2点复数序列 z[m] = x[2m] + j*x[2m+1]，
+     * 位反转变体同时按N/2点位反转顺序写入输出缓冲区
+     * 步骤2: N/2点复数FFT (原位)
+     */
+    if (sub->algorithm == FFT_ALGO_STOCKHAM) {
+        for (int m = 0; m < half; m++) {
+            output[m].real = input[2 * m];
+            output[m].imag = input[2 * m + 1];
         }
-        
-        /* 只保留正频率部分 (0 到 N/2) */
-        for (int bin = 0; bin < FFT_BINS; bin++) {
-            result->data[ch][bin] = temp_buffer[bin];
+        stockham_transform(sub, output, output, 0);
+    } else {
+        for (int m = 0; m < half; m++) {
+            int j = sub->bit_reverse[m];
+            output[j].real = input[2 * m];
+            output[j].imag = input[2 * m + 1];
         }
+        plan_butterfly_stages(sub, output, 0);
+    }
+    
+    /*
+     * 步骤3: 后处理旋转，分离偶/奇序列的频谱
+     *   Fe[k] = (Z[k] + conj(Z[N/2-k])) / 2
+     *   Fo[k] = -j * (Z[k] - conj(Z[N/2-k])) / 2
+     *   X[k]      = Fe[k] + W_N^k * Fo[k]
+     *   X[N/2-k]  = conj(Fe[k] - W_N^k * Fo[k])
+     */
+    complex_t z0 = output[0];
+    output[0].real = z0.real + z0.imag;
+    output[0].imag = 0.0f;
+    output[half].real = z0.real - z0.imag;
+    output[half].imag = 0.0f;
+    
+    for (int k = 1; k <= half / 2; k++) {
+        complex_t zk = output[k];
+        complex_t zm = output[half - k];
+        
+        complex_t fe, fo;
+        fe.real = 0.5f * (zk.real + zm.real);
+        fe.imag = 0.5f * (zk.imag - zm.imag);
+        fo.real = 0.5f * (zk.imag + zm.imag);
+        fo.imag = -0.5f * (zk.real - zm.real);
+        
+        complex_t t = complex_multiply(plan->real_twiddles[k], fo);
+        
+        output[k] = complex_add(fe, t);
+        output[half - k] = complex_conjugate(complex_sub(fe, t));
     }
     
     return STATUS_OK;
 }
 
+status_t fft_plan_execute_c2r(const fft_plan_t* plan,
+                              const complex_t* input,
+                              float32_t* output)
+{
+    if (plan == NULL || input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (plan->engine != FFT_ENGINE_SCALAR) {
+        return fft_simd_execute_c2r(plan, input, output);
+    }
+    
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    complex_t* work = plan->work;
+    
+    /*
+     * 步骤1: 前处理旋转，由正频率部分重建偶/奇序列的频谱并打包
+     *   Z[k] = (X[k] + conj(X[N/2-k])) + j * W_N^-k * (X[k] - conj(X[N/2-k]))
+     * (省略的1/2因子并入最后的1/N归一化; DC与Nyquist频点只取实部)
+     * 位反转变体按N/2点位反转顺序写入工作缓冲区，Stockham变体按自然顺序写入
+     */
+    const int* order = (sub->algorithm == FFT_ALGO_STOCKHAM) ? NULL : sub->bit_reverse;
+    float32_t dc = input[0].real;
+    float32_t nyquist = input[half].real;
+    work[0].real = dc + nyquist;
+    work[0].imag = dc - nyquist;
+    
+    for (int k = 1; k < half; k++) {
+        complex_t xk = input[k];
+        complex_t xm = input[half - k];
+        
+        complex_t fe, fo;
+        fe.real = xk.real + xm.real;
+        fe.imag = xk.imag - xm.imag;
+        fo.real = xk.real - xm.real;
+        fo.imag = xk.imag + xm.imag;
+        fo = complex_multiply(complex_conjugate(plan->real_twiddles[k]), fo);
+        
+        /* Z = Fe + j * Fo */
+        int j = (order != NULL) ? order[k] : k;
+        work[j].real = fe.real - fo.imag;
+        work[j].imag = fe.imag + fo.real;
+    }
+    
+    /* 步骤2: N/2点复数IFFT (原位, 共轭旋转因子) */
+    if (order == NULL) {
+        stockham_transform(sub, work, work, 1);
+    } else {
+        plan_butterfly_stages(sub, work, 1);
+    }
+    
+    /* 步骤3: 拆包 x[2m] = Re{z[m]}, x[2m+1] = Im{z[m]}，并归一化 */
+    float32_t scale = 1.0f / plan->n;
+    for (int m = 0; m < half; m++) {
+        output[2 * m] = work[m].real * scale;
+        output[2 * m + 1] = work[m].imag * scale;
+    }
+    
+    return STATUS_OK;
+}
+
+/*============================================================================
+ * FFT核心函数 (基于默认计划的旧接口)
+ *============================================================================*/
+
+status_t fft_init(void)
+{
+    if (g_fft_initialized) {
+        return STATUS_OK;
+    }
+    
+    g_default_plan = fft_plan_create(FFT_SIZE);
+    if (g_default_plan == NULL) {
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    g_fft_initialized = 1;
+    printf("[INFO] FFT module initialized (N=%d, engine=%s)\n",
+           FFT_SIZE, fft_engine_name(g_default_plan->engine));
+    
+    return STATUS_OK;
+}
+
+void fft_cleanup(void)
+{
+    fft_plan_destroy(g_default_plan);
+    g_default_plan = NULL;
+    g_fft_initialized = 0;
+}
+
+const fft_plan_t* fft_get_default_plan(void)
+{
+    return g_default_plan;
+}
+
+/**
+ * @brief 检查旧接口的点数是否与默认计划一致
+ */
+static status_t check_default_plan(int n)
+{
+    if (!g_fft_initialized) {
+        return STATUS_ERROR_FFT_FAILED;
+    }
+    if (n != g_default_plan->n) {
+        printf("[ERROR] FFT size %d does not match default plan (N=%d), "
+               "use fft_plan_create() instead\n", n, g_default_plan->n);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    return STATUS_OK;
+}
+
+status_t fft_forward(const float32_t* input, complex_t* output, int n)
+{
+    status_t status = check_default_plan(n);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /* 实数FFT得到正频率部分，负频率由共轭对称性补齐 */
+    status = fft_plan_execute_r2c(g_default_plan, input, output);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    for (int k = 1; k < n / 2; k++) {
+        output[n - k] = complex_conjugate(output[k]);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_inverse(const complex_t* input, complex_t* output, int n)
+{
+    status_t status = check_default_plan(n);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return fft_plan_execute(g_default_plan, input, output, FFT_BACKWARD);
+}
+
+status_t fft_forward_real(const float32_t* input, complex_t* output, int n)
+{
+    status_t status = check_default_plan(n);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return fft_plan_execute_r2c(g_default_plan, input, output);
+}
+
+status_t fft_inverse_real(const complex_t* input, float32_t* output, int n)
+{
+    status_t status = check_default_plan(n);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return fft_plan_execute_c2r(g_default_plan, input, output);
+}
+
+status_t fft_inverse_real_batch(const complex_t* const* inputs,
+                                float32_t* const* outputs,
+                                int count,
+                                int n)
+{
+    status_t status = check_default_plan(n);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return fft_plan_execute_c2r_batch(g_default_plan, inputs, outputs, count);
+}
+
+status_t fft_execute_real(const audio_frame_t* frame, fft_result_t* result)
+{
+    status_t status = check_default_plan(FFT_SIZE);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /* 全部通道批量变换，直接写入正频率部分 (0 到 N/2) */
+    return fft_plan_execute_frame(g_default_plan, frame, result);
+}
+
 void fft_print_result(const fft_result_t* result, int channel, int num_bins)
 {
     printf("\n=== FFT Result (Channel %d) ===\n", channel);
@@ -253,8 +935,8 @@ void fft_print_result(const fft_result_t* result, int channel, int num_bins)
     
     for (int i = 0; i < num_bins && i < FFT_BINS; i++) {
         float32_t mag = complex_magnitude(result->data[channel][i]);
-        printf("%d\t\t%.4f\t\t%.4f\t\t%.4f\n", 
-               i, 
+        printf("%d\t\t%.4f\t\t%.4f\t\t%.4f\n",
+               i,
                result->data[channel][i].real,
                result->data[channel][i].imag,
                mag);
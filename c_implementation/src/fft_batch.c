@@ -0,0 +1,748 @@
+/**
+ * @file fft_batch.c
+ * @brief 多通道批量FFT实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 批量变换把一组width路数据按 [元素][通道] 交织存放，实部/虚部分离:
+ *   第l路的第e个元素位于 re[e * width + l]
+ * width通常为FFT_BATCH_LANES，组内不超过4路时取4以减少空闲通道。
+ * 蝶形运算沿通道方向向量化 (AVX2: 8路一个向量, SSE: 4路一个向量)，
+ * 每个旋转因子只加载一次并广播到所有通道。
+ * 实数变换沿用N/2点打包方式，打包/后处理阶段同样按通道复用旋转因子。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft_batch.h"
+#include "fft_simd.h"
+
+#define LANES           FFT_BATCH_LANES
+#define BATCH_BLOCK     256     /* 分块执行的元素数 (8路时实部+虚部共16KB) */
+
+/* 满8路且N/2为8的倍数时，打包/后处理使用AVX2转置内核 */
+#if FFT_SIMD_X86
+#define USE_AVX2_TRANSPOSE(plan, lanes) \
+    ((plan)->engine == FFT_ENGINE_AVX2 && (lanes) == 8 && ((plan)->half->n & 7) == 0)
+#else
+#define USE_AVX2_TRANSPOSE(plan, lanes) 0
+#endif
+
+/*============================================================================
+ * 计划资源
+ *============================================================================*/
+
+status_t fft_batch_plan_init(fft_plan_t* plan)
+{
+    size_t count = (size_t)(plan->n / 2) * LANES;
+    
+    plan->batch_re = (float32_t*)malloc(count * sizeof(float32_t));
+    plan->batch_im = (float32_t*)malloc(count * sizeof(float32_t));
+    if (plan->batch_re == NULL || plan->batch_im == NULL) {
+        fft_batch_plan_free(plan);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    return STATUS_OK;
+}
+
+void fft_batch_plan_free(fft_plan_t* plan)
+{
+    free(plan->batch_re);
+    free(plan->batch_im);
+    plan->batch_re = NULL;
+    plan->batch_im = NULL;
+}
+
+/*============================================================================
+ * 蝶形阶段
+ *============================================================================*/
+
+/**
+ * @brief 首级基2蝶形 (W = 1, log2n为奇数时使用)
+ */
+static void batch_radix2_stage(float32_t* re, float32_t* im, int n, int width)
+{
+    for (int k = 0; k < n; k += 2) {
+        float32_t* r0 = re + k * width;
+        float32_t* i0 = im + k * width;
+        float32_t* r1 = r0 + width;
+        float32_t* i1 = i0 + width;
+        
+        for (int l = 0; l < width; l++) {
+            float32_t ur = r0[l], ui = i0[l];
+            float32_t vr = r1[l], vi = i1[l];
+            r0[l] = ur + vr;
+            i0[l] = ui + vi;
+            r1[l] = ur - vr;
+            i1[l] = ui - vi;
+        }
+    }
+}
+
+/**
+ * @brief 标量批量基4阶段 (四分之一蝶形大小h)
+ * @param stage 当前阶段的旋转因子三元组 (W^j, W^2j, W^3j)
+ * @param sign 正向为1，逆向为-1
+ */
+static void batch_radix4_stage_scalar(float32_t* re, float32_t* im, int n, int h, int width,
+                                      const complex_t* stage, float32_t sign)
+{
+    int step = h * width;
+    
+    for (int k = 0; k < n; k += 4 * h) {
+        for (int j = 0; j < h; j++) {
+            /* 余数0/2/1/3的子DFT分别位于 p0/p1/p2/p3 */
+            float32_t* r0 = re + (k + j) * width;
+            float32_t* i0 = im + (k + j) * width;
+            const complex_t* w = stage + 3 * j;
+            float32_t w1r = w[0].real, w1i = sign * w[0].imag;
+            float32_t w2r = w[1].real, w2i = sign * w[1].imag;
+            float32_t w3r = w[2].real, w3i = sign * w[2].imag;
+            
+            for (int l = 0; l < width; l++) {
+                float32_t t0r = r0[l],            t0i = i0[l];
+                float32_t t2r = r0[l + step],     t2i = i0[l + step];
+                float32_t t1r = r0[l + 2 * step], t1i = i0[l + 2 * step];
+                float32_t t3r = r0[l + 3 * step], t3i = i0[l + 3 * step];
+                float32_t xr;
+                
+                xr = t1r * w1r - t1i * w1i; t1i = t1r * w1i + t1i * w1r; t1r = xr;
+                xr = t2r * w2r - t2i * w2i; t2i = t2r * w2i + t2i * w2r; t2r = xr;
+                xr = t3r * w3r - t3i * w3i; t3i = t3r * w3i + t3i * w3r; t3r = xr;
+                
+                float32_t ar = t0r + t2r, ai = t0i + t2i;
+                float32_t br = t0r - t2r, bi = t0i - t2i;
+                float32_t cr = t1r + t3r, ci = t1i + t3i;
+                float32_t dr = t1r - t3r, di = t1i - t3i;
+                float32_t er = sign * di, ei = -sign * dr;
+                
+                r0[l] = ar + cr;                i0[l] = ai + ci;
+                r0[l + step] = br + er;         i0[l + step] = bi + ei;
+                r0[l + 2 * step] = ar - cr;     i0[l + 2 * step] = ai - ci;
+                r0[l + 3 * step] = br - er;     i0[l + 3 * step] = bi - ei;
+            }
+        }
+    }
+}
+
+#if FFT_SIMD_X86
+
+/**
+ * @brief SSE批量基4阶段 (每个元素的width路按4路一个向量处理)
+ */
+FFT_TARGET_SSE
+static void batch_radix4_stage_sse(float32_t* re, float32_t* im, int n, int h, int width,
+                                   const complex_t* stage, float32_t sign)
+{
+    const __m128 vsign = _mm_set1_ps(sign);
+    const __m128 vnsign = _mm_set1_ps(-sign);
+    int step = h * width;
+    
+    for (int k = 0; k < n; k += 4 * h) {
+        for (int j = 0; j < h; j++) {
+            float32_t* r0 = re + (k + j) * width;
+            float32_t* i0 = im + (k + j) * width;
+            const complex_t* w = stage + 3 * j;
+            const __m128 w1r = _mm_set1_ps(w[0].real), w1i = _mm_set1_ps(sign * w[0].imag);
+            const __m128 w2r = _mm_set1_ps(w[1].real), w2i = _mm_set1_ps(sign * w[1].imag);
+            const __m128 w3r = _mm_set1_ps(w[2].real), w3i = _mm_set1_ps(sign * w[2].imag);
+            
+            for (int l = 0; l < width; l += 4) {
+                __m128 t0r = _mm_loadu_ps(r0 + l),            t0i = _mm_loadu_ps(i0 + l);
+                __m128 t2r = _mm_loadu_ps(r0 + l + step),     t2i = _mm_loadu_ps(i0 + l + step);
+                __m128 t1r = _mm_loadu_ps(r0 + l + 2 * step), t1i = _mm_loadu_ps(i0 + l + 2 * step);
+                __m128 t3r = _mm_loadu_ps(r0 + l + 3 * step), t3i = _mm_loadu_ps(i0 + l + 3 * step);
+                __m128 xr;
+                
+                xr = _mm_sub_ps(_mm_mul_ps(t1r, w1r), _mm_mul_ps(t1i, w1i));
+                t1i = _mm_add_ps(_mm_mul_ps(t1r, w1i), _mm_mul_ps(t1i, w1r));
+                t1r = xr;
+                
+                xr = _mm_sub_ps(_mm_mul_ps(t2r, w2r), _mm_mul_ps(t2i, w2i));
+                t2i = _mm_add_ps(_mm_mul_ps(t2r, w2i), _mm_mul_ps(t2i, w2r));
+                t2r = xr;
+                
+                xr = _mm_sub_ps(_mm_mul_ps(t3r, w3r), _mm_mul_ps(t3i, w3i));
+                t3i = _mm_add_ps(_mm_mul_ps(t3r, w3i), _mm_mul_ps(t3i, w3r));
+                t3r = xr;
+                
+                __m128 ar = _mm_add_ps(t0r, t2r), ai = _mm_add_ps(t0i, t2i);
+                __m128 br = _mm_sub_ps(t0r, t2r), bi = _mm_sub_ps(t0i, t2i);
+                __m128 cr = _mm_add_ps(t1r, t3r), ci = _mm_add_ps(t1i, t3i);
+                __m128 dr = _mm_sub_ps(t1r, t3r), di = _mm_sub_ps(t1i, t3i);
+                __m128 er = _mm_mul_ps(vsign, di), ei = _mm_mul_ps(vnsign, dr);
+                
+                _mm_storeu_ps(r0 + l, _mm_add_ps(ar, cr));
+                _mm_storeu_ps(i0 + l, _mm_add_ps(ai, ci));
+                _mm_storeu_ps(r0 + l + step, _mm_add_ps(br, er));
+                _mm_storeu_ps(i0 + l + step, _mm_add_ps(bi, ei));
+                _mm_storeu_ps(r0 + l + 2 * step, _mm_sub_ps(ar, cr));
+                _mm_storeu_ps(i0 + l + 2 * step, _mm_sub_ps(ai, ci));
+                _mm_storeu_ps(r0 + l + 3 * step, _mm_sub_ps(br, er));
+                _mm_storeu_ps(i0 + l + 3 * step, _mm_sub_ps(bi, ei));
+            }
+        }
+    }
+}
+
+/**
+ * @brief AVX2批量基4阶段 (width = 8, 每个元素的8路恰为一个向量, 复数乘法使用FMA)
+ */
+FFT_TARGET_AVX2
+static void batch_radix4_stage_avx2(float32_t* re, float32_t* im, int n, int h,
+                                    const complex_t* stage, float32_t sign)
+{
+    const __m256 vsign = _mm256_set1_ps(sign);
+    const __m256 vnsign = _mm256_set1_ps(-sign);
+    int step = h * 8;
+    
+    for (int k = 0; k < n; k += 4 * h) {
+        for (int j = 0; j < h; j++) {
+            float32_t* r0 = re + (k + j) * 8;
+            float32_t* i0 = im + (k + j) * 8;
+            const complex_t* w = stage + 3 * j;
+            const __m256 w1r = _mm256_set1_ps(w[0].real), w1i = _mm256_set1_ps(sign * w[0].imag);
+            const __m256 w2r = _mm256_set1_ps(w[1].real), w2i = _mm256_set1_ps(sign * w[1].imag);
+            const __m256 w3r = _mm256_set1_ps(w[2].real), w3i = _mm256_set1_ps(sign * w[2].imag);
+            
+            __m256 t0r = _mm256_loadu_ps(r0),            t0i = _mm256_loadu_ps(i0);
+            __m256 t2r = _mm256_loadu_ps(r0 + step),     t2i = _mm256_loadu_ps(i0 + step);
+            __m256 t1r = _mm256_loadu_ps(r0 + 2 * step), t1i = _mm256_loadu_ps(i0 + 2 * step);
+            __m256 t3r = _mm256_loadu_ps(r0 + 3 * step), t3i = _mm256_loadu_ps(i0 + 3 * step);
+            __m256 xr;
+            
+            xr = _mm256_fmsub_ps(t1r, w1r, _mm256_mul_ps(t1i, w1i));
+            t1i = _mm256_fmadd_ps(t1r, w1i, _mm256_mul_ps(t1i, w1r));
+            t1r = xr;
+            
+            xr = _mm256_fmsub_ps(t2r, w2r, _mm256_mul_ps(t2i, w2i));
+            t2i = _mm256_fmadd_ps(t2r, w2i, _mm256_mul_ps(t2i, w2r));
+            t2r = xr;
+            
+            xr = _mm256_fmsub_ps(t3r, w3r, _mm256_mul_ps(t3i, w3i));
+            t3i = _mm256_fmadd_ps(t3r, w3i, _mm256_mul_ps(t3i, w3r));
+            t3r = xr;
+            
+            __m256 ar = _mm256_add_ps(t0r, t2r), ai = _mm256_add_ps(t0i, t2i);
+            __m256 br = _mm256_sub_ps(t0r, t2r), bi = _mm256_sub_ps(t0i, t2i);
+            __m256 cr = _mm256_add_ps(t1r, t3r), ci = _mm256_add_ps(t1i, t3i);
+            __m256 dr = _mm256_sub_ps(t1r, t3r), di = _mm256_sub_ps(t1i, t3i);
+            __m256 er = _mm256_mul_ps(vsign, di), ei = _mm256_mul_ps(vnsign, dr);
+            
+            _mm256_storeu_ps(r0, _mm256_add_ps(ar, cr));
+            _mm256_storeu_ps(i0, _mm256_add_ps(ai, ci));
+            _mm256_storeu_ps(r0 + step, _mm256_add_ps(br, er));
+            _mm256_storeu_ps(i0 + step, _mm256_add_ps(bi, ei));
+            _mm256_storeu_ps(r0 + 2 * step, _mm256_sub_ps(ar, cr));
+            _mm256_storeu_ps(i0 + 2 * step, _mm256_sub_ps(ai, ci));
+            _mm256_storeu_ps(r0 + 3 * step, _mm256_sub_ps(br, er));
+            _mm256_storeu_ps(i0 + 3 * step, _mm256_sub_ps(bi, ei));
+        }
+    }
+}
+
+#endif /* FFT_SIMD_X86 */
+
+/**
+ * @brief 执行一个批量基4阶段 (按引擎与交织宽度选择内核)
+ */
+static void batch_radix4_stage(const fft_plan_t* plan, float32_t* re, float32_t* im,
+                               int n, int h, int width, const complex_t* stage, float32_t sign)
+{
+#if FFT_SIMD_X86
+    if (plan->engine == FFT_ENGINE_AVX2 && width == 8) {
+        batch_radix4_stage_avx2(re, im, n, h, stage, sign);
+    } else if (plan->engine != FFT_ENGINE_SCALAR) {
+        batch_radix4_stage_sse(re, im, n, h, width, stage, sign);
+    } else {
+        batch_radix4_stage_scalar(re, im, n, h, width, stage, sign);
+    }
+#else
+    (void)plan;
+    batch_radix4_stage_scalar(re, im, n, h, width, stage, sign);
+#endif
+}
+
+/**
+ * @brief 对已位反转排列的批量数据执行N/2点子计划的全部蝶形阶段 (不含归一化)
+ * @param plan 顶层计划 (决定执行引擎)
+ * @param width 交织宽度 (FFT_BATCH_LANES，或不足一组时的4)
+ * 
+ * 交织后一组数据为单路的width倍，超出L1缓存。蝶形跨度不超过BATCH_BLOCK的
+ * 前几级按块执行 (每块的全部这些阶段做完再处理下一块)，只有剩余的大跨度阶段
+ * 需要完整遍历整组数据。
+ */
+static void batch_butterfly_stages(const fft_plan_t* plan, float32_t* re, float32_t* im,
+                                   int width, int inverse)
+{
+    const fft_plan_t* sub = plan->half;
+    int n = sub->n;
+    int block = (n < BATCH_BLOCK) ? n : BATCH_BLOCK;
+    int first_h = (sub->log2n & 1) ? 2 : 1;
+    float32_t sign = inverse ? -1.0f : 1.0f;
+    int h;
+    const complex_t* stage;
+    
+    /* 小跨度阶段: 逐块执行 */
+    for (int base = 0; base < n; base += block) {
+        float32_t* block_re = re + base * width;
+        float32_t* block_im = im + base * width;
+        
+        if (sub->log2n & 1) {
+            batch_radix2_stage(block_re, block_im, block, width);
+        }
+        
+        stage = sub->twiddles;
+        for (h = first_h; 4 * h <= block; h <<= 2) {
+            batch_radix4_stage(plan, block_re, block_im, block, h, width, stage, sign);
+            stage += 3 * h;
+        }
+    }
+    
+    /* 大跨度阶段: 完整遍历 */
+    stage = sub->twiddles;
+    for (h = first_h; 4 * h <= block; h <<= 2) {
+        stage += 3 * h;
+    }
+    for (; 4 * h <= n; h <<= 2) {
+        batch_radix4_stage(plan, re, im, n, h, width, stage, sign);
+        stage += 3 * h;
+    }
+}
+
+#if FFT_SIMD_X86
+
+/*============================================================================
+ * 通道交织转换 (AVX2, 一组满8路)
+ * 
+ * 打包/后处理需要在 [通道][元素] 与 [元素][通道] 之间转置，
+ * 逐元素标量搬运的开销会超过蝶形本身；这里以8x8转置块为单位完成。
+ *============================================================================*/
+
+/**
+ * @brief 8x8单精度矩阵转置 (r[i]为第i行)
+ */
+FFT_TARGET_AVX2
+static inline void transpose8_avx2(__m256* r)
+{
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+/**
+ * @brief 实数FFT打包: 每路取 x[2m..2m+7] (即z[m..m+3]) 转置后写入位反转行
+ * 
+ * m与m+N/4的位反转行相邻 (共占一条64字节缓存行)，两者同时处理，
+ * 避免每条缓存行被分两次写入。
+ */
+FFT_TARGET_AVX2
+static void batch_r2c_pack_avx2(const fft_plan_t* plan, const float32_t* const* inputs,
+                                float32_t* re, float32_t* im)
+{
+    const fft_plan_t* sub = plan->half;
+    int quarter = sub->n / 2;
+    
+    for (int m = 0; m < quarter; m += 4) {
+        __m256 a[8], b[8];
+        for (int l = 0; l < 8; l++) {
+            a[l] = _mm256_loadu_ps(inputs[l] + 2 * m);
+            b[l] = _mm256_loadu_ps(inputs[l] + 2 * (m + quarter));
+        }
+        transpose8_avx2(a);
+        transpose8_avx2(b);
+        
+        for (int q = 0; q < 4; q++) {
+            int row_a = sub->bit_reverse[m + q] * 8;
+            int row_b = sub->bit_reverse[m + q + quarter] * 8;
+            _mm256_storeu_ps(re + row_a, a[2 * q]);
+            _mm256_storeu_ps(re + row_b, b[2 * q]);
+            _mm256_storeu_ps(im + row_a, a[2 * q + 1]);
+            _mm256_storeu_ps(im + row_b, b[2 * q + 1]);
+        }
+    }
+}
+
+/**
+ * @brief 实数FFT后处理 (k = 1..N/4): 每次计算4个k及其镜像N/2-k，转置后写回各路
+ */
+FFT_TARGET_AVX2
+static void batch_r2c_post_avx2(const fft_plan_t* plan, const float32_t* re, const float32_t* im,
+                                complex_t* const* outputs)
+{
+    int half = plan->half->n;
+    const __m256 vhalf = _mm256_set1_ps(0.5f);
+    
+    for (int k0 = 1; k0 <= half / 2; k0 += 4) {
+        __m256 lo[8], hi[8];
+        
+        for (int q = 0; q < 4; q++) {
+            int k = k0 + q;
+            __m256 zkr = _mm256_loadu_ps(re + k * 8);
+            __m256 zki = _mm256_loadu_ps(im + k * 8);
+            __m256 zmr = _mm256_loadu_ps(re + (half - k) * 8);
+            __m256 zmi = _mm256_loadu_ps(im + (half - k) * 8);
+            __m256 wr = _mm256_set1_ps(plan->real_twiddles[k].real);
+            __m256 wi = _mm256_set1_ps(plan->real_twiddles[k].imag);
+            
+            __m256 fe_r = _mm256_mul_ps(vhalf, _mm256_add_ps(zkr, zmr));
+            __m256 fe_i = _mm256_mul_ps(vhalf, _mm256_sub_ps(zki, zmi));
+            __m256 fo_r = _mm256_mul_ps(vhalf, _mm256_add_ps(zki, zmi));
+            __m256 fo_i = _mm256_mul_ps(vhalf, _mm256_sub_ps(zmr, zkr));
+            __m256 tr = _mm256_fmsub_ps(wr, fo_r, _mm256_mul_ps(wi, fo_i));
+            __m256 ti = _mm256_fmadd_ps(wr, fo_i, _mm256_mul_ps(wi, fo_r));
+            
+            /* X[k] = Fe + t; X[N/2-k] = conj(Fe - t)，镜像按地址递增顺序排列 */
+            lo[2 * q] = _mm256_add_ps(fe_r, tr);
+            lo[2 * q + 1] = _mm256_add_ps(fe_i, ti);
+            hi[2 * (3 - q)] = _mm256_sub_ps(fe_r, tr);
+            hi[2 * (3 - q) + 1] = _mm256_sub_ps(ti, fe_i);
+        }
+        
+        transpose8_avx2(lo);
+        transpose8_avx2(hi);
+        for (int l = 0; l < 8; l++) {
+            _mm256_storeu_ps((float32_t*)(outputs[l] + k0), lo[l]);
+            _mm256_storeu_ps((float32_t*)(outputs[l] + half - k0 - 3), hi[l]);
+        }
+    }
+}
+
+/**
+ * @brief 实数IFFT前处理 (k = 0..N/2-1): 每次读取各路4个k及其镜像，转置后计算并写入位反转行
+ * (k = 0的DC/Nyquist行由调用者覆盖；与打包相同，k与k+N/4成对处理以写满缓存行)
+ */
+FFT_TARGET_AVX2
+static void batch_c2r_pre_avx2(const fft_plan_t* plan, const complex_t* const* inputs,
+                               float32_t* re, float32_t* im)
+{
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    int quarter = half / 2;
+    
+    for (int k0 = 0; k0 < quarter; k0 += 4) {
+        for (int g = 0; g < 2; g++) {
+            int kb = k0 + g * quarter;
+            __m256 lo[8], hi[8];
+            for (int l = 0; l < 8; l++) {
+                lo[l] = _mm256_loadu_ps((const float32_t*)(inputs[l] + kb));
+                hi[l] = _mm256_loadu_ps((const float32_t*)(inputs[l] + half - kb - 3));
+            }
+            transpose8_avx2(lo);
+            transpose8_avx2(hi);
+            
+            for (int q = 0; q < 4; q++) {
+                int k = kb + q;
+                __m256 xkr = lo[2 * q], xki = lo[2 * q + 1];
+                __m256 xmr = hi[2 * (3 - q)], xmi = hi[2 * (3 - q) + 1];
+                
+                /* 共轭旋转因子 W_N^-k */
+                __m256 wr = _mm256_set1_ps(plan->real_twiddles[k].real);
+                __m256 wi = _mm256_set1_ps(-plan->real_twiddles[k].imag);
+                
+                __m256 fe_r = _mm256_add_ps(xkr, xmr);
+                __m256 fe_i = _mm256_sub_ps(xki, xmi);
+                __m256 dr = _mm256_sub_ps(xkr, xmr);
+                __m256 di = _mm256_add_ps(xki, xmi);
+                __m256 fo_r = _mm256_fmsub_ps(wr, dr, _mm256_mul_ps(wi, di));
+                __m256 fo_i = _mm256_fmadd_ps(wr, di, _mm256_mul_ps(wi, dr));
+                
+                /* Z = Fe + j * Fo */
+                int row = sub->bit_reverse[k] * 8;
+                _mm256_storeu_ps(re + row, _mm256_sub_ps(fe_r, fo_i));
+                _mm256_storeu_ps(im + row, _mm256_add_ps(fe_i, fo_r));
+            }
+        }
+    }
+}
+
+/**
+ * @brief 实数IFFT拆包: 每次取4行z[m..m+3]转置为各路 x[2m..2m+7] 并归一化
+ */
+FFT_TARGET_AVX2
+static void batch_c2r_unpack_avx2(const fft_plan_t* plan, const float32_t* re, const float32_t* im,
+                                  float32_t* const* outputs)
+{
+    int half = plan->half->n;
+    const __m256 vscale = _mm256_set1_ps(1.0f / plan->n);
+    
+    for (int m = 0; m < half; m += 4) {
+        __m256 v[8];
+        for (int q = 0; q < 4; q++) {
+            v[2 * q] = _mm256_loadu_ps(re + (m + q) * 8);
+            v[2 * q + 1] = _mm256_loadu_ps(im + (m + q) * 8);
+        }
+        transpose8_avx2(v);
+        
+        for (int l = 0; l < 8; l++) {
+            _mm256_storeu_ps(outputs[l] + 2 * m, _mm256_mul_ps(v[l], vscale));
+        }
+    }
+}
+
+#endif /* FFT_SIMD_X86 */
+
+/*============================================================================
+ * 实数变换 (一组不超过FFT_BATCH_LANES路)
+ *============================================================================*/
+
+/**
+ * @brief 一组实数FFT: 打包 -> N/2点批量FFT -> 后处理旋转
+ */
+static void batch_r2c_group(const fft_plan_t* plan,
+                            const float32_t* const* inputs,
+                            complex_t* const* outputs,
+                            int lanes)
+{
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    float32_t* re = plan->batch_re;
+    float32_t* im = plan->batch_im;
+    
+    /* 不超过4路时按4路宽度交织，避免整组8路的空转；空闲通道清零 */
+    int width = (lanes <= 4) ? 4 : LANES;
+    if (lanes < width) {
+        memset(re, 0, (size_t)half * width * sizeof(float32_t));
+        memset(im, 0, (size_t)half * width * sizeof(float32_t));
+    }
+    
+    int use_avx2 = USE_AVX2_TRANSPOSE(plan, lanes);
+    
+    /* 步骤1: z[m] = x[2m] + j*x[2m+1]，按N/2点位反转顺序写入 */
+#if FFT_SIMD_X86
+    if (use_avx2) {
+        batch_r2c_pack_avx2(plan, inputs, re, im);
+    }
+#endif
+    for (int m = 0; m < half && !use_avx2; m++) {
+        float32_t* r = re + sub->bit_reverse[m] * width;
+        float32_t* i = im + sub->bit_reverse[m] * width;
+        for (int l = 0; l < lanes; l++) {
+            r[l] = inputs[l][2 * m];
+            i[l] = inputs[l][2 * m + 1];
+        }
+    }
+    
+    /* 步骤2: N/2点批量FFT */
+    batch_butterfly_stages(plan, re, im, width, 0);
+    
+    /* 步骤3: 后处理旋转 (见fft_plan_execute_r2c) */
+    for (int l = 0; l < lanes; l++) {
+        complex_t* out = outputs[l];
+        out[0].real = re[l] + im[l];
+        out[0].imag = 0.0f;
+        out[half].real = re[l] - im[l];
+        out[half].imag = 0.0f;
+    }
+
+#if FFT_SIMD_X86
+    if (use_avx2) {
+        batch_r2c_post_avx2(plan, re, im, outputs);
+    }
+#endif
+    for (int k = 1; k <= half / 2 && !use_avx2; k++) {
+        float32_t wr = plan->real_twiddles[k].real;
+        float32_t wi = plan->real_twiddles[k].imag;
+        const float32_t* zk_re = re + k * width;
+        const float32_t* zk_im = im + k * width;
+        const float32_t* zm_re = re + (half - k) * width;
+        const float32_t* zm_im = im + (half - k) * width;
+        
+        for (int l = 0; l < lanes; l++) {
+            float32_t fe_r = 0.5f * (zk_re[l] + zm_re[l]);
+            float32_t fe_i = 0.5f * (zk_im[l] - zm_im[l]);
+            float32_t fo_r = 0.5f * (zk_im[l] + zm_im[l]);
+            float32_t fo_i = -0.5f * (zk_re[l] - zm_re[l]);
+            float32_t tr = wr * fo_r - wi * fo_i;
+            float32_t ti = wr * fo_i + wi * fo_r;
+            
+            complex_t* out = outputs[l];
+            out[k].real = fe_r + tr;
+            out[k].imag = fe_i + ti;
+            out[half - k].real = fe_r - tr;
+            out[half - k].imag = -(fe_i - ti);
+        }
+    }
+}
+
+/**
+ * @brief 一组实数IFFT: 前处理旋转 -> N/2点批量IFFT -> 拆包并归一化
+ */
+static void batch_c2r_group(const fft_plan_t* plan,
+                            const complex_t* const* inputs,
+                            float32_t* const* outputs,
+                            int lanes)
+{
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    float32_t* re = plan->batch_re;
+    float32_t* im = plan->batch_im;
+    
+    int width = (lanes <= 4) ? 4 : LANES;
+    if (lanes < width) {
+        memset(re, 0, (size_t)half * width * sizeof(float32_t));
+        memset(im, 0, (size_t)half * width * sizeof(float32_t));
+    }
+    
+    int use_avx2 = USE_AVX2_TRANSPOSE(plan, lanes);
+    
+    /* 步骤1: 前处理旋转 (见fft_plan_execute_c2r)，按位反转顺序写入 */
+#if FFT_SIMD_X86
+    if (use_avx2) {
+        batch_c2r_pre_avx2(plan, inputs, re, im);
+    }
+#endif
+    for (int l = 0; l < lanes; l++) {
+        float32_t dc = inputs[l][0].real;
+        float32_t nyquist = inputs[l][half].real;
+        re[l] = dc + nyquist;
+        im[l] = dc - nyquist;
+    }
+    
+    for (int k = 1; k < half && !use_avx2; k++) {
+        /* 共轭旋转因子 W_N^-k */
+        float32_t wr = plan->real_twiddles[k].real;
+        float32_t wi = -plan->real_twiddles[k].imag;
+        float32_t* r = re + sub->bit_reverse[k] * width;
+        float32_t* i = im + sub->bit_reverse[k] * width;
+        
+        for (int l = 0; l < lanes; l++) {
+            complex_t xk = inputs[l][k];
+            complex_t xm = inputs[l][half - k];
+            float32_t fe_r = xk.real + xm.real;
+            float32_t fe_i = xk.imag - xm.imag;
+            float32_t dr = xk.real - xm.real;
+            float32_t di = xk.imag + xm.imag;
+            float32_t fo_r = wr * dr - wi * di;
+            float32_t fo_i = wr * di + wi * dr;
+            
+            /* Z = Fe + j * Fo */
+            r[l] = fe_r - fo_i;
+            i[l] = fe_i + fo_r;
+        }
+    }
+    
+    /* 步骤2: N/2点批量IFFT */
+    batch_butterfly_stages(plan, re, im, width, 1);
+    
+    /* 步骤3: 拆包 x[2m] = Re{z[m]}, x[2m+1] = Im{z[m]}，并归一化 */
+#if FFT_SIMD_X86
+    if (use_avx2) {
+        batch_c2r_unpack_avx2(plan, re, im, outputs);
+    }
+#endif
+    float32_t scale = 1.0f / plan->n;
+    for (int m = 0; m < half && !use_avx2; m++) {
+        const float32_t* r = re + m * width;
+        const float32_t* i = im + m * width;
+        for (int l = 0; l < lanes; l++) {
+            outputs[l][2 * m] = r[l] * scale;
+            outputs[l][2 * m + 1] = i[l] * scale;
+        }
+    }
+}
+
+/*============================================================================
+ * 批量变换接口
+ *============================================================================*/
+
+status_t fft_plan_execute_r2c_batch(const fft_plan_t* plan,
+                                    const float32_t* const* inputs,
+                                    complex_t* const* outputs,
+                                    int count)
+{
+    if (plan == NULL || inputs == NULL || outputs == NULL || count < 0) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 无批量缓冲区 (Stockham计划): 逐路执行 */
+    if (plan->batch_re == NULL) {
+        for (int c = 0; c < count; c++) {
+            status_t status = fft_plan_execute_r2c(plan, inputs[c], outputs[c]);
+            if (status != STATUS_OK) {
+                return status;
+            }
+        }
+        return STATUS_OK;
+    }
+    
+    for (int base = 0; base < count; base += LANES) {
+        int lanes = (count - base < LANES) ? (count - base) : LANES;
+        batch_r2c_group(plan, inputs + base, outputs + base, lanes);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_plan_execute_c2r_batch(const fft_plan_t* plan,
+                                    const complex_t* const* inputs,
+                                    float32_t* const* outputs,
+                                    int count)
+{
+    if (plan == NULL || inputs == NULL || outputs == NULL || count < 0) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    if (plan->batch_re == NULL) {
+        for (int c = 0; c < count; c++) {
+            status_t status = fft_plan_execute_c2r(plan, inputs[c], outputs[c]);
+            if (status != STATUS_OK) {
+                return status;
+            }
+        }
+        return STATUS_OK;
+    }
+    
+    for (int base = 0; base < count; base += LANES) {
+        int lanes = (count - base < LANES) ? (count - base) : LANES;
+        batch_c2r_group(plan, inputs + base, outputs + base, lanes);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_plan_execute_frame(const fft_plan_t* plan,
+                                const audio_frame_t* frame,
+                                fft_result_t* result)
+{
+    if (plan == NULL || frame == NULL || result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (plan->n != FFT_SIZE) {
+        printf("[ERROR] Frame FFT requires an %d-point plan (got %d)\n", FFT_SIZE, plan->n);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const float32_t* inputs[NUM_CHANNELS];
+    complex_t* outputs[NUM_CHANNELS];
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        inputs[ch] = frame->data[ch];
+        outputs[ch] = result->data[ch];
+    }
+    
+    return fft_plan_execute_r2c_batch(plan, inputs, outputs, NUM_CHANNELS);
+}
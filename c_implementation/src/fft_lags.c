@@ -0,0 +1,286 @@
+/**
+ * @file fft_lags.c
+ * @brief 部分时延逆变换实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 完整策略: 实数IFFT (fft_plan_execute_c2r) 后截取 -L..L 窗口。
+ * 
+ * 直接策略: 对正频率部分按定义求和，时延t与-t共用同一组乘积
+ *   x[±t] = (X0 + (-1)^t X_H + 2 * sum_k (Re{X_k} cos(2*pi*k*t/N) ∓ Im{X_k} sin(2*pi*k*t/N))) / N
+ * 每个时延预存一行与输入同样交织的(cos, sin)表，求和成为连续的点积，AVX2引擎下向量化。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft_lags.h"
+#include "fft_simd.h"
+
+/*============================================================================
+ * 代价模型参数
+ * 
+ * 以N/2点频谱上的一次标量乘加为单位，数值由benchmark实测标定:
+ * SIMD FFT每点每级的开销远低于标量的直接求和。
+ *============================================================================*/
+#define LAGS_COST_FFT           0.4f    /* 复数FFT: 每点每级 */
+#define LAGS_COST_PREPROCESS    2.0f    /* 打包前处理: 每个频点 */
+#define LAGS_COST_DIRECT        1.0f    /* 直接DFT: 每个时延每个频点 */
+#define LAGS_COST_DIRECT_AVX2   0.2f    /* 直接DFT (AVX2点积) */
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+static int log2_int(int n)
+{
+    int result = 0;
+    while (n > 1) {
+        n >>= 1;
+        result++;
+    }
+    return result;
+}
+
+/*============================================================================
+ * 策略选择
+ *============================================================================*/
+
+const char* fft_lags_strategy_name(fft_lag_strategy_t strategy)
+{
+    switch (strategy) {
+        case FFT_LAGS_AUTO:   return "auto";
+        case FFT_LAGS_FULL:   return "full";
+        case FFT_LAGS_DIRECT: return "direct";
+        default:              return "unknown";
+    }
+}
+
+/**
+ * @brief 按代价模型选择策略，同时给出估计开销
+ */
+static fft_lag_strategy_t choose_strategy(int n, int max_lag, float32_t* cost_out)
+{
+    int half = n / 2;
+    
+    /* 完整变换: 前处理 + H点FFT (拆包只取窗口，忽略不计) */
+    fft_lag_strategy_t best = FFT_LAGS_FULL;
+    float32_t best_cost = LAGS_COST_PREPROCESS * half + LAGS_COST_FFT * (float32_t)half * log2_int(half);
+    
+    /* 直接DFT: 每个非负时延一次H点乘加 (正负时延共用)；混合基计划为标量引擎，不使用AVX2点积 */
+    float32_t direct_unit = LAGS_COST_DIRECT;
+    if (fft_simd_best_engine() == FFT_ENGINE_AVX2 && (n & (n - 1)) == 0 && (n & 15) == 0) {
+        direct_unit = LAGS_COST_DIRECT_AVX2;
+    }
+    float32_t direct_cost = direct_unit * (float32_t)(max_lag + 1) * half;
+    if (direct_cost < best_cost) {
+        best = FFT_LAGS_DIRECT;
+        best_cost = direct_cost;
+    }
+    
+    *cost_out = best_cost;
+    return best;
+}
+
+fft_lag_strategy_t fft_lags_choose_strategy(int n, int max_lag)
+{
+    float32_t cost;
+    return choose_strategy(n, max_lag, &cost);
+}
+
+float32_t fft_lags_estimate_cost(int n, int max_lag)
+{
+    float32_t cost;
+    choose_strategy(n, max_lag, &cost);
+    return cost;
+}
+
+/*============================================================================
+ * 计划管理
+ *============================================================================*/
+
+fft_lag_plan_t* fft_lag_plan_create(int n, int max_lag, fft_lag_strategy_t strategy)
+{
+    if (n < 8 || (n & 1) != 0 || max_lag < 1 || max_lag >= n / 2) {
+        printf("[ERROR] Invalid lag window: n=%d, max_lag=%d\n", n, max_lag);
+        return NULL;
+    }
+    
+    fft_lag_plan_t* lag_plan = (fft_lag_plan_t*)calloc(1, sizeof(fft_lag_plan_t));
+    if (lag_plan == NULL) {
+        return NULL;
+    }
+    
+    int half = n / 2;
+    lag_plan->n = n;
+    lag_plan->max_lag = max_lag;
+    lag_plan->band_start = 0;
+    lag_plan->band_end = half;
+    
+    lag_plan->strategy = (strategy == FFT_LAGS_AUTO) ? fft_lags_choose_strategy(n, max_lag) : strategy;
+    
+    lag_plan->plan = fft_plan_create(n);
+    if (lag_plan->plan == NULL) {
+        fft_lag_plan_destroy(lag_plan);
+        return NULL;
+    }
+    
+    if (lag_plan->strategy == FFT_LAGS_FULL) {
+        lag_plan->full = (float32_t*)malloc(n * sizeof(float32_t));
+        if (lag_plan->full == NULL) {
+            fft_lag_plan_destroy(lag_plan);
+            return NULL;
+        }
+    } else {
+        lag_plan->lag_table = (float32_t*)malloc((size_t)(max_lag + 1) * n * sizeof(float32_t));
+        if (lag_plan->lag_table == NULL) {
+            fft_lag_plan_destroy(lag_plan);
+            return NULL;
+        }
+        
+        /* k = 0 置零 (DC单独处理)，其余按 k*t mod n 取角度以保持精度 */
+        for (int t = 0; t <= max_lag; t++) {
+            float32_t* row = lag_plan->lag_table + (size_t)t * n;
+            row[0] = 0.0f;
+            row[1] = 0.0f;
+            for (int k = 1; k < half; k++) {
+                double angle = 2.0 * 3.14159265358979323846 * ((k * t) % n) / n;
+                row[2 * k] = (float32_t)cos(angle);
+                row[2 * k + 1] = (float32_t)sin(angle);
+            }
+        }
+    }
+    
+    return lag_plan;
+}
+
+void fft_lag_plan_set_band(fft_lag_plan_t* lag_plan, int bin_lo, int bin_hi)
+{
+    int half = lag_plan->n / 2;
+    int start = (bin_lo < 0) ? 0 : (bin_lo & ~7);
+    int end = (bin_hi + 8) & ~7;
+    
+    lag_plan->band_start = start;
+    lag_plan->band_end = (end > half) ? half : end;
+}
+
+void fft_lag_plan_destroy(fft_lag_plan_t* lag_plan)
+{
+    if (lag_plan == NULL) {
+        return;
+    }
+    
+    fft_plan_destroy(lag_plan->plan);
+    free(lag_plan->lag_table);
+    free(lag_plan->full);
+    free(lag_plan);
+}
+
+/*============================================================================
+ * 执行
+ *============================================================================*/
+
+/**
+ * @brief 交织数据与表行的点积，分别累加偶数项(实部)与奇数项(虚部)
+ */
+static void dot_interleaved_scalar(const float32_t* x, const float32_t* row, int count,
+                                   float32_t* even, float32_t* odd)
+{
+    float32_t c = 0.0f, s = 0.0f;
+    for (int i = 0; i < count; i += 2) {
+        c += x[i] * row[i];
+        s += x[i + 1] * row[i + 1];
+    }
+    *even = c;
+    *odd = s;
+}
+
+#if FFT_SIMD_X86
+/**
+ * @brief AVX2点积 (count为16的倍数)
+ */
+FFT_TARGET_AVX2
+static void dot_interleaved_avx2(const float32_t* x, const float32_t* row, int count,
+                                 float32_t* even, float32_t* odd)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    
+    for (int i = 0; i < count; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(row + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(row + i + 8), acc1);
+    }
+    
+    /* 偶数位置为实部乘积，奇数位置为虚部乘积 */
+    float32_t lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(acc0, acc1));
+    *even = lanes[0] + lanes[2] + lanes[4] + lanes[6];
+    *odd = lanes[1] + lanes[3] + lanes[5] + lanes[7];
+}
+#endif
+
+/**
+ * @brief 直接策略: 对正频率部分直接求部分DFT
+ */
+static void execute_direct(const fft_lag_plan_t* lag_plan, const complex_t* input, float32_t* output)
+{
+    int n = lag_plan->n;
+    int half = n / 2;
+    int max_lag = lag_plan->max_lag;
+    const float32_t* x = (const float32_t*)input;
+    float32_t scale = 1.0f / n;
+    
+    /* 只累加频带内的频点 (频带外的输入为零) */
+    int offset = 2 * lag_plan->band_start;
+    int count = 2 * (lag_plan->band_end - lag_plan->band_start);
+    
+    for (int t = 0; t <= max_lag; t++) {
+        const float32_t* row = lag_plan->lag_table + (size_t)t * n + offset;
+        float32_t c, s;
+
+#if FFT_SIMD_X86
+        if (lag_plan->plan->engine == FFT_ENGINE_AVX2 && (n & 15) == 0) {
+            dot_interleaved_avx2(x + offset, row, count, &c, &s);
+        } else
+#endif
+        {
+            dot_interleaved_scalar(x + offset, row, count, &c, &s);
+        }
+        
+        float32_t base = input[0].real + ((t & 1) ? -input[half].real : input[half].real);
+        output[max_lag + t] = (base + 2.0f * (c - s)) * scale;
+        output[max_lag - t] = (base + 2.0f * (c + s)) * scale;
+    }
+}
+
+status_t fft_lag_plan_execute(const fft_lag_plan_t* lag_plan,
+                              const complex_t* input,
+                              float32_t* output)
+{
+    if (lag_plan == NULL || input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int n = lag_plan->n;
+    int max_lag = lag_plan->max_lag;
+    
+    switch (lag_plan->strategy) {
+        case FFT_LAGS_DIRECT:
+            execute_direct(lag_plan, input, output);
+            break;
+        
+        default: {
+            status_t status = fft_plan_execute_c2r(lag_plan->plan, input, lag_plan->full);
+            if (status != STATUS_OK) {
+                return status;
+            }
+            for (int t = -max_lag; t <= max_lag; t++) {
+                output[max_lag + t] = lag_plan->full[(t + n) % n];
+            }
+            break;
+        }
+    }
+    
+    return STATUS_OK;
+}
@@ -0,0 +1,524 @@
+/**
+ * @file fft_simd.c
+ * @brief SIMD FFT引擎实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 实部/虚部分离(SoA)布局的基4 FFT:
+ * - 四分之一蝶形大小h不小于向量宽度的阶段按j方向向量化 (SSE: 4, AVX2: 8)
+ * - 更小的首级阶段使用标量SoA代码
+ * - AVX2函数通过target属性单独编译，运行时根据CPUID选择
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft_simd.h"
+
+/*============================================================================
+ * CPU特性检测
+ *============================================================================*/
+
+fft_engine_t fft_simd_best_engine(void)
+{
+#if FFT_SIMD_X86
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    
+    __cpuid(info, 1);
+    int has_sse2 = (info[3] >> 26) & 1;
+    int has_fma = (info[2] >> 12) & 1;
+    int has_osxsave = (info[2] >> 27) & 1;
+    int has_avx2 = 0;
+    
+    if (max_leaf >= 7 && has_osxsave && has_fma) {
+        /* 确认操作系统保存YMM寄存器状态 */
+        if ((_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            has_avx2 = (info[1] >> 5) & 1;
+        }
+    }
+    
+    if (has_avx2) {
+        return FFT_ENGINE_AVX2;
+    }
+    if (has_sse2) {
+        return FFT_ENGINE_SSE;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return FFT_ENGINE_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return FFT_ENGINE_SSE;
+    }
+#endif
+#endif
+    return FFT_ENGINE_SCALAR;
+}
+
+const char* fft_engine_name(fft_engine_t engine)
+{
+    switch (engine) {
+        case FFT_ENGINE_AUTO:   return "auto";
+        case FFT_ENGINE_SCALAR: return "scalar";
+        case FFT_ENGINE_SSE:    return "SSE";
+        case FFT_ENGINE_AVX2:   return "AVX2";
+        default:                return "unknown";
+    }
+}
+
+/*============================================================================
+ * 布局转换
+ *============================================================================*/
+
+void fft_split_deinterleave(const complex_t* input, float32_t* re, float32_t* im, int n)
+{
+    for (int i = 0; i < n; i++) {
+        re[i] = input[i].real;
+        im[i] = input[i].imag;
+    }
+}
+
+void fft_split_interleave(const float32_t* re, const float32_t* im, complex_t* output, int n)
+{
+    for (int i = 0; i < n; i++) {
+        output[i].real = re[i];
+        output[i].imag = im[i];
+    }
+}
+
+/*============================================================================
+ * 计划资源
+ *============================================================================*/
+
+status_t fft_simd_plan_init(fft_plan_t* plan)
+{
+    int n = plan->n;
+    
+    plan->simd_twiddles_re = (float32_t*)malloc(n * sizeof(float32_t));
+    plan->simd_twiddles_im = (float32_t*)malloc(n * sizeof(float32_t));
+    plan->split_re = (float32_t*)malloc(n * sizeof(float32_t));
+    plan->split_im = (float32_t*)malloc(n * sizeof(float32_t));
+    if (plan->simd_twiddles_re == NULL || plan->simd_twiddles_im == NULL ||
+        plan->split_re == NULL || plan->split_im == NULL) {
+        fft_simd_plan_free(plan);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    /*
+     * 由交织三元组 (W^j, W^2j, W^3j) 重排为每阶段三段连续数组:
+     * [W^j, j<h][W^2j, j<h][W^3j, j<h]，便于按j方向向量加载
+     */
+    int offset = 0;
+    for (int h = (plan->log2n & 1) ? 2 : 1; 4 * h <= n; h <<= 2) {
+        for (int j = 0; j < h; j++) {
+            for (int r = 0; r < 3; r++) {
+                plan->simd_twiddles_re[offset + r * h + j] = plan->twiddles[offset + 3 * j + r].real;
+                plan->simd_twiddles_im[offset + r * h + j] = plan->twiddles[offset + 3 * j + r].imag;
+            }
+        }
+        offset += 3 * h;
+    }
+    
+    return STATUS_OK;
+}
+
+void fft_simd_plan_free(fft_plan_t* plan)
+{
+    free(plan->simd_twiddles_re);
+    free(plan->simd_twiddles_im);
+    free(plan->split_re);
+    free(plan->split_im);
+    plan->simd_twiddles_re = NULL;
+    plan->simd_twiddles_im = NULL;
+    plan->split_re = NULL;
+    plan->split_im = NULL;
+}
+
+/*============================================================================
+ * 蝶形阶段
+ *============================================================================*/
+
+/**
+ * @brief 标量SoA基4阶段 (四分之一蝶形大小h)
+ * @param sign 正向为1，逆向为-1
+ */
+static void soa_radix4_stage_scalar(float32_t* re, float32_t* im, int n, int h,
+                                    const float32_t* twr, const float32_t* twi,
+                                    float32_t sign)
+{
+    for (int k = 0; k < n; k += 4 * h) {
+        float32_t* r0 = re + k;
+        float32_t* i0 = im + k;
+        
+        for (int j = 0; j < h; j++) {
+            float32_t t0r = r0[j],         t0i = i0[j];
+            float32_t t2r = r0[j + h],     t2i = i0[j + h];
+            float32_t t1r = r0[j + 2 * h], t1i = i0[j + 2 * h];
+            float32_t t3r = r0[j + 3 * h], t3i = i0[j + 3 * h];
+            float32_t wr, wi, xr;
+            
+            wr = twr[j]; wi = sign * twi[j];
+            xr = t1r * wr - t1i * wi; t1i = t1r * wi + t1i * wr; t1r = xr;
+            wr = twr[h + j]; wi = sign * twi[h + j];
+            xr = t2r * wr - t2i * wi; t2i = t2r * wi + t2i * wr; t2r = xr;
+            wr = twr[2 * h + j]; wi = sign * twi[2 * h + j];
+            xr = t3r * wr - t3i * wi; t3i = t3r * wi + t3i * wr; t3r = xr;
+            
+            float32_t ar = t0r + t2r, ai = t0i + t2i;
+            float32_t br = t0r - t2r, bi = t0i - t2i;
+            float32_t cr = t1r + t3r, ci = t1i + t3i;
+            float32_t dr = t1r - t3r, di = t1i - t3i;
+            float32_t er = sign * di, ei = -sign * dr;
+            
+            r0[j] = ar + cr;             i0[j] = ai + ci;
+            r0[j + h] = br + er;         i0[j + h] = bi + ei;
+            r0[j + 2 * h] = ar - cr;     i0[j + 2 * h] = ai - ci;
+            r0[j + 3 * h] = br - er;     i0[j + 3 * h] = bi - ei;
+        }
+    }
+}
+
+#if FFT_SIMD_X86
+
+/**
+ * @brief SSE SoA基4阶段 (h为4的倍数)
+ */
+FFT_TARGET_SSE
+static void soa_radix4_stage_sse(float32_t* re, float32_t* im, int n, int h,
+                                 const float32_t* twr, const float32_t* twi,
+                                 float32_t sign)
+{
+    const __m128 vsign = _mm_set1_ps(sign);
+    const __m128 vnsign = _mm_set1_ps(-sign);
+    
+    for (int k = 0; k < n; k += 4 * h) {
+        float32_t* r0 = re + k;
+        float32_t* i0 = im + k;
+        
+        for (int j = 0; j < h; j += 4) {
+            __m128 t0r = _mm_loadu_ps(r0 + j),         t0i = _mm_loadu_ps(i0 + j);
+            __m128 t2r = _mm_loadu_ps(r0 + j + h),     t2i = _mm_loadu_ps(i0 + j + h);
+            __m128 t1r = _mm_loadu_ps(r0 + j + 2 * h), t1i = _mm_loadu_ps(i0 + j + 2 * h);
+            __m128 t3r = _mm_loadu_ps(r0 + j + 3 * h), t3i = _mm_loadu_ps(i0 + j + 3 * h);
+            __m128 wr, wi, xr;
+            
+            wr = _mm_loadu_ps(twr + j);
+            wi = _mm_mul_ps(vsign, _mm_loadu_ps(twi + j));
+            xr = _mm_sub_ps(_mm_mul_ps(t1r, wr), _mm_mul_ps(t1i, wi));
+            t1i = _mm_add_ps(_mm_mul_ps(t1r, wi), _mm_mul_ps(t1i, wr));
+            t1r = xr;
+            
+            wr = _mm_loadu_ps(twr + h + j);
+            wi = _mm_mul_ps(vsign, _mm_loadu_ps(twi + h + j));
+            xr = _mm_sub_ps(_mm_mul_ps(t2r, wr), _mm_mul_ps(t2i, wi));
+            t2i = _mm_add_ps(_mm_mul_ps(t2r, wi), _mm_mul_ps(t2i, wr));
+            t2r = xr;
+            
+            wr = _mm_loadu_ps(twr + 2 * h + j);
+            wi = _mm_mul_ps(vsign, _mm_loadu_ps(twi + 2 * h + j));
+            xr = _mm_sub_ps(_mm_mul_ps(t3r, wr), _mm_mul_ps(t3i, wi));
+            t3i = _mm_add_ps(_mm_mul_ps(t3r, wi), _mm_mul_ps(t3i, wr));
+            t3r = xr;
+            
+            __m128 ar = _mm_add_ps(t0r, t2r), ai = _mm_add_ps(t0i, t2i);
+            __m128 br = _mm_sub_ps(t0r, t2r), bi = _mm_sub_ps(t0i, t2i);
+            __m128 cr = _mm_add_ps(t1r, t3r), ci = _mm_add_ps(t1i, t3i);
+            __m128 dr = _mm_sub_ps(t1r, t3r), di = _mm_sub_ps(t1i, t3i);
+            __m128 er = _mm_mul_ps(vsign, di), ei = _mm_mul_ps(vnsign, dr);
+            
+            _mm_storeu_ps(r0 + j, _mm_add_ps(ar, cr));
+            _mm_storeu_ps(i0 + j, _mm_add_ps(ai, ci));
+            _mm_storeu_ps(r0 + j + h, _mm_add_ps(br, er));
+            _mm_storeu_ps(i0 + j + h, _mm_add_ps(bi, ei));
+            _mm_storeu_ps(r0 + j + 2 * h, _mm_sub_ps(ar, cr));
+            _mm_storeu_ps(i0 + j + 2 * h, _mm_sub_ps(ai, ci));
+            _mm_storeu_ps(r0 + j + 3 * h, _mm_sub_ps(br, er));
+            _mm_storeu_ps(i0 + j + 3 * h, _mm_sub_ps(bi, ei));
+        }
+    }
+}
+
+/**
+ * @brief AVX2 SoA基4阶段 (h为8的倍数, 复数乘法使用FMA)
+ */
+FFT_TARGET_AVX2
+static void soa_radix4_stage_avx2(float32_t* re, float32_t* im, int n, int h,
+                                  const float32_t* twr, const float32_t* twi,
+                                  float32_t sign)
+{
+    const __m256 vsign = _mm256_set1_ps(sign);
+    const __m256 vnsign = _mm256_set1_ps(-sign);
+    
+    for (int k = 0; k < n; k += 4 * h) {
+        float32_t* r0 = re + k;
+        float32_t* i0 = im + k;
+        
+        for (int j = 0; j < h; j += 8) {
+            __m256 t0r = _mm256_loadu_ps(r0 + j),         t0i = _mm256_loadu_ps(i0 + j);
+            __m256 t2r = _mm256_loadu_ps(r0 + j + h),     t2i = _mm256_loadu_ps(i0 + j + h);
+            __m256 t1r = _mm256_loadu_ps(r0 + j + 2 * h), t1i = _mm256_loadu_ps(i0 + j + 2 * h);
+            __m256 t3r = _mm256_loadu_ps(r0 + j + 3 * h), t3i = _mm256_loadu_ps(i0 + j + 3 * h);
+            __m256 wr, wi, xr;
+            
+            wr = _mm256_loadu_ps(twr + j);
+            wi = _mm256_mul_ps(vsign, _mm256_loadu_ps(twi + j));
+            xr = _mm256_fmsub_ps(t1r, wr, _mm256_mul_ps(t1i, wi));
+            t1i = _mm256_fmadd_ps(t1r, wi, _mm256_mul_ps(t1i, wr));
+            t1r = xr;
+            
+            wr = _mm256_loadu_ps(twr + h + j);
+            wi = _mm256_mul_ps(vsign, _mm256_loadu_ps(twi + h + j));
+            xr = _mm256_fmsub_ps(t2r, wr, _mm256_mul_ps(t2i, wi));
+            t2i = _mm256_fmadd_ps(t2r, wi, _mm256_mul_ps(t2i, wr));
+            t2r = xr;
+            
+            wr = _mm256_loadu_ps(twr + 2 * h + j);
+            wi = _mm256_mul_ps(vsign, _mm256_loadu_ps(twi + 2 * h + j));
+            xr = _mm256_fmsub_ps(t3r, wr, _mm256_mul_ps(t3i, wi));
+            t3i = _mm256_fmadd_ps(t3r, wi, _mm256_mul_ps(t3i, wr));
+            t3r = xr;
+            
+            __m256 ar = _mm256_add_ps(t0r, t2r), ai = _mm256_add_ps(t0i, t2i);
+            __m256 br = _mm256_sub_ps(t0r, t2r), bi = _mm256_sub_ps(t0i, t2i);
+            __m256 cr = _mm256_add_ps(t1r, t3r), ci = _mm256_add_ps(t1i, t3i);
+            __m256 dr = _mm256_sub_ps(t1r, t3r), di = _mm256_sub_ps(t1i, t3i);
+            __m256 er = _mm256_mul_ps(vsign, di), ei = _mm256_mul_ps(vnsign, dr);
+            
+            _mm256_storeu_ps(r0 + j, _mm256_add_ps(ar, cr));
+            _mm256_storeu_ps(i0 + j, _mm256_add_ps(ai, ci));
+            _mm256_storeu_ps(r0 + j + h, _mm256_add_ps(br, er));
+            _mm256_storeu_ps(i0 + j + h, _mm256_add_ps(bi, ei));
+            _mm256_storeu_ps(r0 + j + 2 * h, _mm256_sub_ps(ar, cr));
+            _mm256_storeu_ps(i0 + j + 2 * h, _mm256_sub_ps(ai, ci));
+            _mm256_storeu_ps(r0 + j + 3 * h, _mm256_sub_ps(br, er));
+            _mm256_storeu_ps(i0 + j + 3 * h, _mm256_sub_ps(bi, ei));
+        }
+    }
+}
+
+#endif /* FFT_SIMD_X86 */
+
+/**
+ * @brief 对已位反转排列的SoA数据执行全部蝶形阶段 (原位, 不含归一化)
+ */
+static void soa_butterfly_stages(const fft_plan_t* plan, float32_t* re, float32_t* im, int inverse)
+{
+    int n = plan->n;
+    int h = 1;
+    float32_t sign = inverse ? -1.0f : 1.0f;
+    
+    /* log2n为奇数: 首级基2蝶形 (W = 1) */
+    if (plan->log2n & 1) {
+        for (int k = 0; k < n; k += 2) {
+            float32_t ur = re[k], ui = im[k];
+            float32_t vr = re[k + 1], vi = im[k + 1];
+            re[k] = ur + vr;
+            im[k] = ui + vi;
+            re[k + 1] = ur - vr;
+            im[k + 1] = ui - vi;
+        }
+        h = 2;
+    }
+    
+    int offset = 0;
+    for (; 4 * h <= n; h <<= 2) {
+        const float32_t* twr = plan->simd_twiddles_re + offset;
+        const float32_t* twi = plan->simd_twiddles_im + offset;
+
+#if FFT_SIMD_X86
+        if (plan->engine == FFT_ENGINE_AVX2 && (h & 7) == 0) {
+            soa_radix4_stage_avx2(re, im, n, h, twr, twi, sign);
+        } else if (plan->engine != FFT_ENGINE_SCALAR && (h & 3) == 0) {
+            soa_radix4_stage_sse(re, im, n, h, twr, twi, sign);
+        } else {
+            soa_radix4_stage_scalar(re, im, n, h, twr, twi, sign);
+        }
+#else
+        soa_radix4_stage_scalar(re, im, n, h, twr, twi, sign);
+#endif
+        
+        offset += 3 * h;
+    }
+}
+
+/*============================================================================
+ * 变换接口
+ *============================================================================*/
+
+status_t fft_simd_execute_split(const fft_plan_t* plan,
+                                float32_t* re,
+                                float32_t* im,
+                                fft_direction_t direction)
+{
+    if (plan == NULL || plan->split_re == NULL || re == NULL || im == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int n = plan->n;
+    
+    /* 原位位反转重排 */
+    for (int i = 0; i < n; i++) {
+        int j = plan->bit_reverse[i];
+        if (i < j) {
+            float32_t tr = re[i], ti = im[i];
+            re[i] = re[j];
+            im[i] = im[j];
+            re[j] = tr;
+            im[j] = ti;
+        }
+    }
+    
+    int inverse = (direction == FFT_BACKWARD);
+    soa_butterfly_stages(plan, re, im, inverse);
+    
+    if (inverse) {
+        float32_t scale = 1.0f / n;
+        for (int i = 0; i < n; i++) {
+            re[i] *= scale;
+            im[i] *= scale;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_simd_execute(const fft_plan_t* plan,
+                          const complex_t* input,
+                          complex_t* output,
+                          fft_direction_t direction)
+{
+    if (plan == NULL || plan->split_re == NULL || input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int n = plan->n;
+    float32_t* re = plan->split_re;
+    float32_t* im = plan->split_im;
+    
+    /* 转换为SoA布局，同时完成位反转重排 */
+    for (int i = 0; i < n; i++) {
+        int j = plan->bit_reverse[i];
+        re[j] = input[i].real;
+        im[j] = input[i].imag;
+    }
+    
+    int inverse = (direction == FFT_BACKWARD);
+    soa_butterfly_stages(plan, re, im, inverse);
+    
+    /* 转换回交织布局，同时完成IFFT归一化 */
+    float32_t scale = inverse ? 1.0f / n : 1.0f;
+    for (int i = 0; i < n; i++) {
+        output[i].real = re[i] * scale;
+        output[i].imag = im[i] * scale;
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_simd_execute_r2c(const fft_plan_t* plan,
+                              const float32_t* input,
+                              complex_t* output)
+{
+    if (plan == NULL || plan->half == NULL || plan->half->split_re == NULL ||
+        input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    float32_t* re = sub->split_re;
+    float32_t* im = sub->split_im;
+    
+    /* 偶/奇采样直接分别作为实部/虚部，按位反转顺序写入 */
+    for (int m = 0; m < half; m++) {
+        int j = sub->bit_reverse[m];
+        re[j] = input[2 * m];
+        im[j] = input[2 * m + 1];
+    }
+    
+    soa_butterfly_stages(sub, re, im, 0);
+    
+    /* 后处理旋转 (与标量路径相同)，结果写入交织布局输出 */
+    output[0].real = re[0] + im[0];
+    output[0].imag = 0.0f;
+    output[half].real = re[0] - im[0];
+    output[half].imag = 0.0f;
+    
+    for (int k = 1; k <= half / 2; k++) {
+        int m = half - k;
+        float32_t fer = 0.5f * (re[k] + re[m]);
+        float32_t fei = 0.5f * (im[k] - im[m]);
+        float32_t for_ = 0.5f * (im[k] + im[m]);
+        float32_t foi = -0.5f * (re[k] - re[m]);
+        
+        float32_t wr = plan->real_twiddles[k].real;
+        float32_t wi = plan->real_twiddles[k].imag;
+        float32_t tr = wr * for_ - wi * foi;
+        float32_t ti = wr * foi + wi * for_;
+        
+        output[k].real = fer + tr;
+        output[k].imag = fei + ti;
+        output[m].real = fer - tr;
+        output[m].imag = -(fei - ti);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fft_simd_execute_c2r(const fft_plan_t* plan,
+                              const complex_t* input,
+                              float32_t* output)
+{
+    if (plan == NULL || plan->half == NULL || plan->half->split_re == NULL ||
+        input == NULL || output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const fft_plan_t* sub = plan->half;
+    int half = sub->n;
+    float32_t* re = sub->split_re;
+    float32_t* im = sub->split_im;
+    
+    /* 前处理旋转 (与标量路径相同)，按位反转顺序写入SoA缓冲区 */
+    float32_t dc = input[0].real;
+    float32_t nyquist = input[half].real;
+    re[0] = dc + nyquist;
+    im[0] = dc - nyquist;
+    
+    for (int k = 1; k < half; k++) {
+        complex_t xk = input[k];
+        complex_t xm = input[half - k];
+        
+        float32_t fer = xk.real + xm.real;
+        float32_t fei = xk.imag - xm.imag;
+        float32_t dr = xk.real - xm.real;
+        float32_t di = xk.imag + xm.imag;
+        
+        /* Fo = D * conj(W_N^k) */
+        float32_t wr = plan->real_twiddles[k].real;
+        float32_t wi = plan->real_twiddles[k].imag;
+        float32_t for_ = dr * wr + di * wi;
+        float32_t foi = di * wr - dr * wi;
+        
+        int j = sub->bit_reverse[k];
+        re[j] = fer - foi;
+        im[j] = fei + for_;
+    }
+    
+    soa_butterfly_stages(sub, re, im, 1);
+    
+    /* 拆包: 实部为偶数采样，虚部为奇数采样 */
+    float32_t scale = 1.0f / plan->n;
+    for (int m = 0; m < half; m++) {
+        output[2 * m] = re[m] * scale;
+        output[2 * m + 1] = im[m] * scale;
+    }
+    
+    return STATUS_OK;
+}
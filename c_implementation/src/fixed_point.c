@@ -0,0 +1,784 @@
+/**
+ * @file fixed_point.c
+ * @brief 定点处理链实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 块浮点FFT: 每级蝶形前扫描块内最大分量，若超过BFP_STAGE_LIMIT则整块右移，
+ * 保证 a ± W*b 不溢出 (|a ± W*b| <= (1 + sqrt(2)) * max)，右移位数累加到块指数。
+ * 
+ * 近似倒数平方根: |c|^2先规格化到[2^28, 2^31)，取高7位查表得到初值 (Q14)，
+ * 再做一次牛顿迭代 y = y * (3 - u * y^2) / 2，相对误差约1e-3。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fixed_point.h"
+#include "audio_reader.h"
+#include "gcc_phat.h"
+#include "srp_map.h"
+#include "test_data.h"
+
+/*============================================================================
+ * 定点参数
+ *============================================================================*/
+#define FIXED_HALF          (FFT_SIZE / 2)      /* 打包复数FFT点数 */
+#define BFP_STAGE_LIMIT     13572               /* 32767 / (1 + sqrt(2)) */
+#define RSQRT_LUT_BITS      7                   /* 查找表索引位数 */
+#define RSQRT_LUT_SIZE      (1 << RSQRT_LUT_BITS)
+
+/*============================================================================
+ * 静态变量
+ *============================================================================*/
+static complex_q15_t g_twiddle_rom[FIXED_HALF];     /* W_N^k, k < N/2 */
+static int g_bit_reverse[FIXED_HALF];               /* N/2点位反转表 */
+static uint16_t g_rsqrt_lut[RSQRT_LUT_SIZE];        /* 1/sqrt(u), Q14 */
+static int g_fixed_initialized = 0;
+static int g_band_lo = 0;                           /* GCC频带 (频点，含两端) */
+static int g_band_hi = FFT_BINS - 1;
+
+/* 工作缓冲区 */
+static complex_q15_t g_work[FIXED_HALF];
+static int32_t g_wide[FIXED_HALF + 1][2];
+static q15_t g_ifft_result[FFT_SIZE];
+static complex_q15_t g_phat_spectrum[FFT_BINS];
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+static int log2_int(int n)
+{
+    int result = 0;
+    while (n > 1) {
+        n >>= 1;
+        result++;
+    }
+    return result;
+}
+
+/**
+ * @brief 饱和到16位
+ */
+static q15_t saturate_q15(int32_t value)
+{
+    if (value > 32767) {
+        return 32767;
+    }
+    if (value < -32768) {
+        return -32768;
+    }
+    return (q15_t)value;
+}
+
+/**
+ * @brief 带舍入的算术右移 (shift <= 0 时左移)
+ */
+static int64_t shift_round(int64_t value, int shift)
+{
+    if (shift <= 0) {
+        return value * ((int64_t)1 << -shift);
+    }
+    return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief Q15乘法 (舍入)
+ */
+static int32_t mul_q15(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b + (1 << 14)) >> 15);
+}
+
+/**
+ * @brief 块内最大分量绝对值
+ */
+static int32_t block_max(const complex_q15_t* data, int n)
+{
+    int32_t max_val = 0;
+    for (int i = 0; i < n; i++) {
+        int32_t re = abs(data[i].real);
+        int32_t im = abs(data[i].imag);
+        if (re > max_val) max_val = re;
+        if (im > max_val) max_val = im;
+    }
+    return max_val;
+}
+
+/**
+ * @brief 32位中间结果规格化为Q15块，返回右移位数
+ */
+static int normalize_wide(int32_t (*wide)[2], complex_q15_t* output, int n)
+{
+    int32_t max_val = 0;
+    for (int i = 0; i < n; i++) {
+        int32_t re = abs(wide[i][0]);
+        int32_t im = abs(wide[i][1]);
+        if (re > max_val) max_val = re;
+        if (im > max_val) max_val = im;
+    }
+    
+    int shift = 0;
+    while (shift_round(max_val, shift) > 32767) {
+        shift++;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        output[i].real = saturate_q15((int32_t)shift_round(wide[i][0], shift));
+        output[i].imag = saturate_q15((int32_t)shift_round(wide[i][1], shift));
+    }
+    
+    return shift;
+}
+
+/**
+ * @brief N/2点块浮点复数FFT (原位, 自然顺序输入/输出)
+ * @param inverse 0为正变换，1为逆变换 (不含1/N归一化)
+ * @return 累计右移位数 (结果 = data * 2^返回值)
+ */
+static int fixed_fft_complex(complex_q15_t* data, int inverse)
+{
+    /* 位反转重排 */
+    for (int i = 0; i < FIXED_HALF; i++) {
+        int j = g_bit_reverse[i];
+        if (j > i) {
+            complex_q15_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+    
+    int total_shift = 0;
+    
+    for (int len = 2; len <= FIXED_HALF; len <<= 1) {
+        /* 块浮点: 按当前块最大值决定本级输入的右移位数 */
+        int32_t max_val = block_max(data, FIXED_HALF);
+        int shift = 0;
+        while ((max_val >> shift) > BFP_STAGE_LIMIT) {
+            shift++;
+        }
+        total_shift += shift;
+        
+        int half = len / 2;
+        int step = 2 * (FIXED_HALF / len);     /* W_{N/2}^j = W_N^(2j) */
+        
+        for (int k = 0; k < FIXED_HALF; k += len) {
+            for (int j = 0; j < half; j++) {
+                complex_q15_t* pa = &data[k + j];
+                complex_q15_t* pb = &data[k + j + half];
+                complex_q15_t w = g_twiddle_rom[j * step];
+                int32_t wr = w.real;
+                int32_t wi = inverse ? -w.imag : w.imag;
+                
+                int32_t ar = (int32_t)shift_round(pa->real, shift);
+                int32_t ai = (int32_t)shift_round(pa->imag, shift);
+                int32_t br = (int32_t)shift_round(pb->real, shift);
+                int32_t bi = (int32_t)shift_round(pb->imag, shift);
+                
+                /* t = W * b */
+                int32_t tr = (int32_t)(((int64_t)br * wr - (int64_t)bi * wi + (1 << 14)) >> 15);
+                int32_t ti = (int32_t)(((int64_t)br * wi + (int64_t)bi * wr + (1 << 14)) >> 15);
+                
+                pa->real = saturate_q15(ar + tr);
+                pa->imag = saturate_q15(ai + ti);
+                pb->real = saturate_q15(ar - tr);
+                pb->imag = saturate_q15(ai - ti);
+            }
+        }
+    }
+    
+    return total_shift;
+}
+
+/**
+ * @brief 近似倒数平方根: 返回 2^14 / sqrt(p / 2^30)，p规格化在[2^28, 2^31)
+ */
+static int32_t rsqrt_q14(uint32_t p)
+{
+    /* 查表初值 */
+    int32_t y = g_rsqrt_lut[p >> (31 - RSQRT_LUT_BITS)];
+    
+    /* 牛顿迭代: y = y * (3 - u * y^2) / 2，u = p / 2^30 */
+    int64_t y2 = (int64_t)y * y;                            /* Q28 */
+    int64_t t = ((int64_t)3 << 58) - (int64_t)p * y2;       /* Q58 */
+    return (int32_t)(((int64_t)y * (t >> 28)) >> 31);       /* Q14 */
+}
+
+/**
+ * @brief PHAT加权: c / |c|，输出Q15单位复数 (c为0时输出0)
+ */
+static complex_q15_t phat_normalize(int64_t cr, int64_t ci)
+{
+    complex_q15_t result = {0, 0};
+    
+    int64_t mag = llabs(cr) > llabs(ci) ? llabs(cr) : llabs(ci);
+    if (mag == 0) {
+        return result;
+    }
+    
+    /* 规格化: 最大分量落在[2^14, 2^15) */
+    int shift = 0;
+    while ((mag >> shift) >= (1 << 15)) {
+        shift++;
+    }
+    while (shift <= 0 && (mag << -shift) < (1 << 14)) {
+        shift--;
+    }
+    int32_t nr = (int32_t)(shift >= 0 ? cr >> shift : cr * ((int64_t)1 << -shift));
+    int32_t ni = (int32_t)(shift >= 0 ? ci >> shift : ci * ((int64_t)1 << -shift));
+    
+    uint32_t p = (uint32_t)((int64_t)nr * nr + (int64_t)ni * ni);
+    int32_t y = rsqrt_q14(p);
+    
+    result.real = saturate_q15((nr * y + (1 << 13)) >> 14);
+    result.imag = saturate_q15((ni * y + (1 << 13)) >> 14);
+    return result;
+}
+
+/*============================================================================
+ * 模块管理
+ *============================================================================*/
+
+status_t fixed_point_init(void)
+{
+    if (g_fixed_initialized) {
+        return STATUS_OK;
+    }
+    
+    /* 定点FFT为基2实现，FRAME_LENGTH为混合基点数时不可用 */
+    if ((FFT_SIZE & (FFT_SIZE - 1)) != 0) {
+        printf("[ERROR] Fixed-point FFT requires a power-of-two FFT_SIZE (%d)\n", FFT_SIZE);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 旋转因子ROM: W_N^k = cos(2*pi*k/N) - j*sin(2*pi*k/N) */
+    for (int k = 0; k < FIXED_HALF; k++) {
+        double angle = 2.0 * 3.14159265358979323846 * k / FFT_SIZE;
+        g_twiddle_rom[k].real = saturate_q15((int32_t)lround(cos(angle) * 32768.0));
+        g_twiddle_rom[k].imag = saturate_q15((int32_t)lround(-sin(angle) * 32768.0));
+    }
+    
+    /* N/2点位反转表 */
+    int bits = log2_int(FIXED_HALF);
+    for (int i = 0; i < FIXED_HALF; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        g_bit_reverse[i] = r;
+    }
+    
+    /* 倒数平方根表: 索引i对应u = (i + 0.5) / 2^(RSQRT_LUT_BITS - 1) */
+    for (int i = 0; i < RSQRT_LUT_SIZE; i++) {
+        double u = (i + 0.5) / (1 << (RSQRT_LUT_BITS - 1));
+        double y = 16384.0 / sqrt(u);
+        g_rsqrt_lut[i] = (uint16_t)(y > 65535.0 ? 65535 : lround(y));
+    }
+    
+    /* GCC频带与浮点处理链一致，频带外的PHAT频谱保持为0 */
+    memset(g_phat_spectrum, 0, sizeof(g_phat_spectrum));
+    status_t status = gcc_phat_band_to_bins(GCC_BAND_LOW_HZ, GCC_BAND_HIGH_HZ, &g_band_lo, &g_band_hi);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    g_fixed_initialized = 1;
+    printf("[INFO] Fixed-point module initialized (Q15, block floating point)\n");
+    
+    return STATUS_OK;
+}
+
+void fixed_point_cleanup(void)
+{
+    g_fixed_initialized = 0;
+}
+
+status_t fixed_gcc_set_band(float32_t f_lo, float32_t f_hi)
+{
+    int bin_lo, bin_hi;
+    status_t status = gcc_phat_band_to_bins(f_lo, f_hi, &bin_lo, &bin_hi);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    g_band_lo = bin_lo;
+    g_band_hi = bin_hi;
+    memset(g_phat_spectrum, 0, sizeof(g_phat_spectrum));
+    
+    return STATUS_OK;
+}
+
+/*============================================================================
+ * 定点FFT
+ *============================================================================*/
+
+status_t fixed_fft_real(const float32_t* input, complex_q15_t* output, int* exponent)
+{
+    if (!g_fixed_initialized || input == NULL || output == NULL || exponent == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 输入块浮点量化: 值 = q / 2^15 * 2^input_exp */
+    float32_t max_abs = 0.0f;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        float32_t a = fabsf(input[i]);
+        if (a > max_abs) max_abs = a;
+    }
+    int input_exp = 0;
+    if (max_abs > 0.0f) {
+        frexpf(max_abs, &input_exp);
+    }
+    float32_t scale = ldexpf(32768.0f, -input_exp);
+    
+    /* 偶/奇采样打包为N/2点复数序列 */
+    for (int m = 0; m < FIXED_HALF; m++) {
+        g_work[m].real = saturate_q15((int32_t)lroundf(input[2 * m] * scale));
+        g_work[m].imag = saturate_q15((int32_t)lroundf(input[2 * m + 1] * scale));
+    }
+    
+    int fft_shift = fixed_fft_complex(g_work, 0);
+    
+    /*
+     * 后处理 (32位, 结果为2*X[k]):
+     *   2*Fe[k] = Z[k] + conj(Z[N/2-k])
+     *   2*Fo[k] = -j * (Z[k] - conj(Z[N/2-k]))
+     *   2*X[k]  = 2*Fe[k] + W_N^k * 2*Fo[k]
+     */
+    g_wide[0][0] = 2 * ((int32_t)g_work[0].real + g_work[0].imag);
+    g_wide[0][1] = 0;
+    g_wide[FIXED_HALF][0] = 2 * ((int32_t)g_work[0].real - g_work[0].imag);
+    g_wide[FIXED_HALF][1] = 0;
+    
+    for (int k = 1; k < FIXED_HALF; k++) {
+        complex_q15_t zk = g_work[k];
+        complex_q15_t zm = g_work[FIXED_HALF - k];
+        
+        int32_t fe_r = (int32_t)zk.real + zm.real;
+        int32_t fe_i = (int32_t)zk.imag - zm.imag;
+        int32_t fo_r = (int32_t)zk.imag + zm.imag;
+        int32_t fo_i = (int32_t)zm.real - zk.real;
+        
+        int32_t wr = g_twiddle_rom[k].real;
+        int32_t wi = g_twiddle_rom[k].imag;
+        
+        g_wide[k][0] = fe_r + mul_q15(fo_r, wr) - mul_q15(fo_i, wi);
+        g_wide[k][1] = fe_i + mul_q15(fo_r, wi) + mul_q15(fo_i, wr);
+    }
+    
+    int out_shift = normalize_wide(g_wide, output, FFT_BINS);
+    
+    /* 2*X的右移位数减1得到X的指数 */
+    *exponent = input_exp + fft_shift + out_shift - 1;
+    
+    return STATUS_OK;
+}
+
+status_t fixed_fft_execute_real(const audio_frame_t* frame, fft_result_q15_t* fft_result)
+{
+    if (frame == NULL || fft_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        status_t status = fixed_fft_real(frame->data[ch], fft_result->data[ch],
+                                         &fft_result->exponent[ch]);
+        if (status != STATUS_OK) {
+            printf("[ERROR] Fixed-point FFT failed for channel %d\n", ch);
+            return status;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+void fixed_fft_quantize(const fft_result_t* fft_result, fft_result_q15_t* fixed_result)
+{
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        float32_t max_abs = 0.0f;
+        for (int k = 0; k < FFT_BINS; k++) {
+            float32_t re = fabsf(fft_result->data[ch][k].real);
+            float32_t im = fabsf(fft_result->data[ch][k].imag);
+            if (re > max_abs) max_abs = re;
+            if (im > max_abs) max_abs = im;
+        }
+        
+        int exponent = 0;
+        if (max_abs > 0.0f) {
+            frexpf(max_abs, &exponent);
+        }
+        float32_t scale = ldexpf(32768.0f, -exponent);
+        
+        for (int k = 0; k < FFT_BINS; k++) {
+            fixed_result->data[ch][k].real =
+                saturate_q15((int32_t)lroundf(fft_result->data[ch][k].real * scale));
+            fixed_result->data[ch][k].imag =
+                saturate_q15((int32_t)lroundf(fft_result->data[ch][k].imag * scale));
+        }
+        fixed_result->exponent[ch] = exponent;
+    }
+}
+
+void fixed_fft_to_float(const fft_result_q15_t* fixed_result, fft_result_t* fft_result)
+{
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        float32_t scale = ldexpf(1.0f, fixed_result->exponent[ch] - 15);
+        for (int k = 0; k < FFT_BINS; k++) {
+            fft_result->data[ch][k].real = fixed_result->data[ch][k].real * scale;
+            fft_result->data[ch][k].imag = fixed_result->data[ch][k].imag * scale;
+        }
+    }
+}
+
+/*============================================================================
+ * 定点GCC-PHAT
+ *============================================================================*/
+
+status_t fixed_gcc_compute_pair(const complex_q15_t* fft_ch1,
+                                const complex_q15_t* fft_ch2,
+                                q15_t* gcc_output)
+{
+    if (!g_fixed_initialized || fft_ch1 == NULL || fft_ch2 == NULL || gcc_output == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 步骤1: 互功率谱 X1 * conj(X2) 与PHAT加权 (只计算GCC频带内的频点) */
+    for (int k = g_band_lo; k <= g_band_hi; k++) {
+        int64_t ar = fft_ch1[k].real, ai = fft_ch1[k].imag;
+        int64_t br = fft_ch2[k].real, bi = fft_ch2[k].imag;
+        g_phat_spectrum[k] = phat_normalize(ar * br + ai * bi, ai * br - ar * bi);
+    }
+    
+    /*
+     * 步骤2: 逆变换前处理 (32位)，得到打包频谱
+     *   Z[k] = Fe[k] + j * Fo[k]
+     *   Fe[k] = X[k] + conj(X[N/2-k]),  Fo[k] = (X[k] - conj(X[N/2-k])) * conj(W_N^k)
+     */
+    const complex_q15_t* x = g_phat_spectrum;
+    g_wide[0][0] = (int32_t)x[0].real + x[FIXED_HALF].real;
+    g_wide[0][1] = (int32_t)x[0].real - x[FIXED_HALF].real;
+    
+    for (int k = 1; k < FIXED_HALF; k++) {
+        complex_q15_t xk = x[k];
+        complex_q15_t xm = x[FIXED_HALF - k];
+        
+        int32_t fe_r = (int32_t)xk.real + xm.real;
+        int32_t fe_i = (int32_t)xk.imag - xm.imag;
+        int32_t dr = (int32_t)xk.real - xm.real;
+        int32_t di = (int32_t)xk.imag + xm.imag;
+        
+        int32_t wr = g_twiddle_rom[k].real;
+        int32_t wi = g_twiddle_rom[k].imag;
+        int32_t fo_r = mul_q15(dr, wr) + mul_q15(di, wi);
+        int32_t fo_i = mul_q15(di, wr) - mul_q15(dr, wi);
+        
+        g_wide[k][0] = fe_r - fo_i;
+        g_wide[k][1] = fe_i + fo_r;
+    }
+    
+    int pre_shift = normalize_wide(g_wide, g_work, FIXED_HALF);
+    
+    /* 步骤3: N/2点块浮点逆变换 */
+    int ifft_shift = fixed_fft_complex(g_work, 1);
+    
+    /* 步骤4: 拆包并除以N，x[2m] = Re{z[m]}, x[2m+1] = Im{z[m]} */
+    int shift = log2_int(FFT_SIZE) - pre_shift - ifft_shift;
+    for (int m = 0; m < FIXED_HALF; m++) {
+        g_ifft_result[2 * m] = saturate_q15((int32_t)shift_round(g_work[m].real, shift));
+        g_ifft_result[2 * m + 1] = saturate_q15((int32_t)shift_round(g_work[m].imag, shift));
+    }
+    
+    /* fftshift: 将零时延移到中心 */
+    int half = FFT_SIZE / 2;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        gcc_output[(i + half) % FFT_SIZE] = g_ifft_result[i];
+    }
+    
+    return STATUS_OK;
+}
+
+status_t fixed_gcc_compute_all(const fft_result_q15_t* fft_result,
+                               gcc_result_q15_t* gcc_result)
+{
+    if (fft_result == NULL || gcc_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 麦克风对顺序与gcc_phat_init_mic_pairs一致 */
+    int pair = 0;
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+        for (int j = i + 1; j < NUM_CHANNELS; j++) {
+            status_t status = fixed_gcc_compute_pair(fft_result->data[i], fft_result->data[j],
+                                                     gcc_result->data[pair]);
+            if (status != STATUS_OK) {
+                printf("[ERROR] Fixed-point GCC-PHAT failed for pair %d\n", pair);
+                return status;
+            }
+            pair++;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+void fixed_gcc_to_float(const gcc_result_q15_t* fixed_result, gcc_result_t* gcc_result)
+{
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < GCC_LENGTH; i++) {
+            gcc_result->data[pair][i] = fixed_result->data[pair][i] / 32768.0f;
+        }
+    }
+}
+
+/*============================================================================
+ * 定点SRP-Map
+ *============================================================================*/
+
+status_t fixed_srp_compute(const gcc_result_q15_t* gcc_result,
+                           const tau_table_t* tau_table,
+                           srp_map_q31_t* srp_result)
+{
+    if (gcc_result == NULL || tau_table == NULL || srp_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int e = 0; e < SRP_ELEVATION_BINS; e++) {
+        for (int a = 0; a < SRP_AZIMUTH_BINS; a++) {
+            for (int r = 0; r < SRP_RANGE_BINS; r++) {
+                int grid_idx = e * SRP_AZIMUTH_BINS * SRP_RANGE_BINS +
+                               a * SRP_RANGE_BINS + r;
+                q31_t sum = 0;
+                
+                for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+                    sum += gcc_result->data[pair][tau_table->tau_indices[pair][grid_idx]];
+                }
+                
+                srp_result->data[e][a][r] = sum;
+            }
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+/*============================================================================
+ * 精度报告
+ *============================================================================*/
+
+/**
+ * @brief 误差统计: SQNR (dB) 与最大绝对误差
+ */
+static double compute_sqnr(const float32_t* reference, const float32_t* test, int count,
+                           float32_t* max_error)
+{
+    double signal = 0.0, noise = 0.0;
+    float32_t max_err = 0.0f;
+    
+    for (int i = 0; i < count; i++) {
+        double d = (double)test[i] - reference[i];
+        signal += (double)reference[i] * reference[i];
+        noise += d * d;
+        if (fabs(d) > max_err) {
+            max_err = (float32_t)fabs(d);
+        }
+    }
+    
+    *max_error = max_err;
+    if (noise <= 0.0) {
+        return 999.0;
+    }
+    return 10.0 * log10(signal / noise);
+}
+
+static int argmax(const float32_t* data, int count)
+{
+    int best = 0;
+    for (int i = 1; i < count; i++) {
+        if (data[i] > data[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief GCC峰值位置一致的麦克风对数
+ */
+static int count_gcc_peak_matches(const gcc_result_t* reference, const gcc_result_t* test)
+{
+    int matches = 0;
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        if (argmax(reference->data[pair], GCC_LENGTH) == argmax(test->data[pair], GCC_LENGTH)) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief 比较GCC/SRP阶段并打印一行报告
+ */
+static void report_gcc_srp(const char* label,
+                           const gcc_result_t* gcc_reference,
+                           const gcc_result_t* gcc_test,
+                           const srp_map_t* srp_reference,
+                           const srp_map_t* srp_test)
+{
+    float32_t max_err;
+    double sqnr = compute_sqnr((const float32_t*)gcc_reference->data,
+                               (const float32_t*)gcc_test->data,
+                               NUM_MIC_PAIRS * GCC_LENGTH, &max_err);
+    printf("%-24s %-8s %10.2f %12.3e   peak %d/%d pairs\n", label, "GCC", sqnr, max_err,
+           count_gcc_peak_matches(gcc_reference, gcc_test), NUM_MIC_PAIRS);
+    
+    if (srp_reference != NULL) {
+        const float32_t* ref = (const float32_t*)srp_reference->data;
+        const float32_t* test = (const float32_t*)srp_test->data;
+        sqnr = compute_sqnr(ref, test, TAU_TABLE_SIZE, &max_err);
+        printf("%-24s %-8s %10.2f %12.3e   argmax %d (ref %d)\n", label, "SRP", sqnr, max_err,
+               argmax(test, TAU_TABLE_SIZE), argmax(ref, TAU_TABLE_SIZE));
+    }
+}
+
+static void srp_to_float(const srp_map_q31_t* fixed_result, srp_map_t* srp_result)
+{
+    const q31_t* src = (const q31_t*)fixed_result->data;
+    float32_t* dst = (float32_t*)srp_result->data;
+    for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+        dst[i] = src[i] / 32768.0f;
+    }
+}
+
+status_t fixed_point_accuracy_report(const char* output_dir)
+{
+    char path[512];
+    status_t status = fixed_point_init();
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    fft_result_t* fft_reference = (fft_result_t*)malloc(sizeof(fft_result_t));
+    fft_result_t* fft_test = (fft_result_t*)malloc(sizeof(fft_result_t));
+    gcc_result_t* gcc_reference = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    gcc_result_t* gcc_test = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    fft_result_q15_t* fft_fixed = (fft_result_q15_t*)malloc(sizeof(fft_result_q15_t));
+    gcc_result_q15_t* gcc_fixed = (gcc_result_q15_t*)malloc(sizeof(gcc_result_q15_t));
+    audio_frame_t* frame = (audio_frame_t*)malloc(sizeof(audio_frame_t));
+    srp_map_t srp_reference, srp_test;
+    srp_map_q31_t srp_fixed;
+    srp_map_t* srp_ref_ptr = &srp_reference;
+    float32_t** audio_data = NULL;
+    
+    if (!fft_reference || !fft_test || !gcc_reference || !gcc_test ||
+        !fft_fixed || !gcc_fixed || !frame) {
+        printf("[ERROR] Memory allocation failed\n");
+        status = STATUS_ERROR_MEMORY_ALLOC;
+        goto cleanup;
+    }
+    
+    /* 浮点参考结果 */
+    snprintf(path, sizeof(path), "%s/fft_result.bin", output_dir);
+    status = test_data_load_fft(path, fft_reference);
+    if (status != STATUS_OK) goto cleanup;
+    
+    snprintf(path, sizeof(path), "%s/gcc_result.bin", output_dir);
+    status = test_data_load_gcc(path, gcc_reference);
+    if (status != STATUS_OK) goto cleanup;
+    
+    /* SRP比较需要同一次运行保存的Tau Table */
+    snprintf(path, sizeof(path), "%s/srp_result.bin", output_dir);
+    if (test_data_load_srp(path, &srp_reference) == STATUS_OK) {
+        snprintf(path, sizeof(path), "%s/tau_table.bin", output_dir);
+        if (srp_map_load_tau_table(path) != STATUS_OK) {
+            srp_ref_ptr = NULL;
+        }
+    } else {
+        srp_ref_ptr = NULL;
+    }
+    const tau_table_t* tau_table = srp_map_get_tau_table();
+    
+    printf("\n========== Fixed-Point Accuracy Report (Q15, BFP) ==========\n");
+    printf("%-24s %-8s %10s %12s\n", "Input", "Stage", "SQNR (dB)", "Max error");
+    
+    /* 参考FFT量化后进入定点GCC/SRP: 评估GCC-PHAT与SRP阶段 */
+    fixed_fft_quantize(fft_reference, fft_fixed);
+    fixed_fft_to_float(fft_fixed, fft_test);
+    float32_t max_err;
+    double sqnr = compute_sqnr((const float32_t*)fft_reference->data,
+                               (const float32_t*)fft_test->data,
+                               NUM_CHANNELS * FFT_BINS * 2, &max_err);
+    printf("%-24s %-8s %10.2f %12.3e\n", "Quantized float FFT", "FFT", sqnr, max_err);
+    
+    status = fixed_gcc_compute_all(fft_fixed, gcc_fixed);
+    if (status != STATUS_OK) goto cleanup;
+    fixed_gcc_to_float(gcc_fixed, gcc_test);
+    fixed_srp_compute(gcc_fixed, tau_table, &srp_fixed);
+    srp_to_float(&srp_fixed, &srp_test);
+    report_gcc_srp("Quantized float FFT", gcc_reference, gcc_test, srp_ref_ptr, &srp_test);
+    
+    /* 由原始音频第0帧计算定点FFT: 评估FFT阶段与端到端误差 */
+    snprintf(path, sizeof(path), "%s/audio_data.bin", output_dir);
+    FILE* fp = fopen(path, "rb");
+    if (fp != NULL) {
+        fclose(fp);
+        int num_channels = 0, num_samples = 0;
+        status = test_data_load_audio(path, &audio_data, &num_channels, &num_samples);
+        if (status != STATUS_OK) goto cleanup;
+        
+        if (num_channels != NUM_CHANNELS) {
+            printf("[ERROR] Audio file has %d channels, expected %d\n", num_channels, NUM_CHANNELS);
+            status = STATUS_ERROR_INVALID_PARAM;
+            goto cleanup;
+        }
+        
+        status = audio_get_frame(audio_data, num_samples, 0, frame);
+        if (status != STATUS_OK) goto cleanup;
+        audio_apply_hanning_window(frame);
+        
+        status = fixed_fft_execute_real(frame, fft_fixed);
+        if (status != STATUS_OK) goto cleanup;
+        fixed_fft_to_float(fft_fixed, fft_test);
+        sqnr = compute_sqnr((const float32_t*)fft_reference->data,
+                            (const float32_t*)fft_test->data,
+                            NUM_CHANNELS * FFT_BINS * 2, &max_err);
+        printf("%-24s %-8s %10.2f %12.3e\n", "Audio frame 0", "FFT", sqnr, max_err);
+        
+        status = fixed_gcc_compute_all(fft_fixed, gcc_fixed);
+        if (status != STATUS_OK) goto cleanup;
+        fixed_gcc_to_float(gcc_fixed, gcc_test);
+        fixed_srp_compute(gcc_fixed, tau_table, &srp_fixed);
+        srp_to_float(&srp_fixed, &srp_test);
+        report_gcc_srp("Audio frame 0", gcc_reference, gcc_test, srp_ref_ptr, &srp_test);
+    } else {
+        printf("[INFO] %s not found, FFT stage skipped\n", path);
+    }
+    
+    /* 定点实现的存储需求 (字节) */
+    printf("\nFixed-point storage (bytes):\n");
+    printf("  Twiddle ROM (N/2 x Q15 complex):   %d\n", (int)sizeof(g_twiddle_rom));
+    printf("  Rsqrt LUT (%d x 16 bit):          %d\n", RSQRT_LUT_SIZE, (int)sizeof(g_rsqrt_lut));
+    printf("  FFT work buffer (N/2 x Q15):       %d\n", (int)sizeof(g_work));
+    printf("  Post-processing buffer (32 bit):   %d\n", (int)sizeof(g_wide));
+    printf("  Spectrum per frame (Q15 + exp):    %d\n", (int)sizeof(fft_result_q15_t));
+    printf("  GCC per frame (Q15):               %d\n", (int)sizeof(gcc_result_q15_t));
+    printf("  Float equivalents:                 %d / %d\n",
+           (int)sizeof(fft_result_t), (int)sizeof(gcc_result_t));
+    printf("==============================================================\n");
+    
+    status = STATUS_OK;
+
+cleanup:
+    if (audio_data != NULL) {
+        test_data_free_audio(audio_data, NUM_CHANNELS);
+    }
+    free(fft_reference);
+    free(fft_test);
+    free(gcc_reference);
+    free(gcc_test);
+    free(fft_fixed);
+    free(gcc_fixed);
+    free(frame);
+    
+    return status;
+}
@@ -6,6 +6,17 @@
  * 
  * 实现广义互相关-相位变换算法
  * GCC-PHAT(f) = IFFT{ X1(f) * conj(X2(f)) / |X1(f) * conj(X2(f))| }
+ * 
+ * 由 |X1 * conj(X2)| = |X1| * |X2|，PHAT加权等价于先把每个通道的频谱白化
+ * (X / |X|)，再对白化频谱求互功率谱。批量接口每帧只白化NUM_CHANNELS个通道，
+ * 各麦克风对只剩一次复数乘法。
+ * 
+ * 所有工作缓冲区与FFT计划都归GCC上下文(gcc_ctx_t)所有，不同上下文可在不同线程
+ * 中同时使用；gcc_phat_*接口使用模块的默认上下文。麦克风对表在gcc_phat_init中
+ * 生成后只读。并行接口把麦克风对分发给线程池，每个工作线程使用自己的上下文。
+ * 
+ * 各计算路径按启用列表 (g_active_pairs) 遍历麦克风对，列表由对的选取标志与麦克风的
+ * 屏蔽标志求交得到，修改任一标志时重建。
  */
 
 #include <stdio.h>
@@ -14,6 +25,49 @@
 #include <math.h>
 #include "gcc_phat.h"
 #include "fft.h"
+#include "fft_lags.h"
+#include "gcc_weight.h"
+#include "thread_pool.h"
+
+/*============================================================================
+ * 上下文结构
+ *============================================================================*/
+struct gcc_ctx {
+    fft_plan_t* plan;                           /* 私有FFT_SIZE点计划 (含工作缓冲区) */
+    fft_lag_plan_t* lag_plan;                   /* 时延窗口计划 (NULL表示计算完整GCC) */
+    fft_lag_plan_t* pair_plan;                  /* 逐对时延窗口计划 (按max_lag按需创建) */
+    gcc_ifft_mode_t ifft_mode;                  /* 完整GCC的逆变换方式 */
+    gcc_weight_t weight;                        /* 频域加权 */
+    gcc_weight_cache_t cache;                   /* 各通道自功率谱 (SCOT平滑状态) */
+    int bin_lo;                                 /* GCC频带 [bin_lo, bin_hi] */
+    int bin_hi;
+    int use_mask;                               /* 是否对互功率谱逐频点加权 */
+    float32_t mask[FFT_BINS];                   /* 频点权重 */
+    
+    fft_result_t whitened;                      /* 加权频谱 */
+    float32_t power[FFT_BINS];                  /* 单对接口的自功率谱缓冲区 */
+    complex_t cross[FFT_BATCH_LANES][FFT_BINS]; /* 互功率谱 (一组批量IFFT) */
+    float32_t ifft_result[FFT_SIZE];            /* 单对IFFT结果 */
+    complex_t packed[FFT_SIZE];                 /* 两对合一的N点复数缓冲区 */
+};
+
+/**
+ * @brief 并行GCC: 线程池与每个工作线程的上下文
+ */
+struct gcc_pool {
+    thread_pool_t* threads;
+    int num_workers;
+    gcc_ctx_t** ctx;                            /* ctx[worker] */
+    fft_result_t* whitened;                     /* 共享加权频谱 (加权阶段写入，之后只读) */
+    gcc_weight_t weight;                        /* 频域加权 */
+    gcc_weight_cache_t* cache;                  /* 各通道自功率谱 (每个任务只写自己的通道) */
+    
+    /* 当前批次参数 */
+    const fft_result_t* fft_result;
+    gcc_result_t* gcc_result;
+    int pairs_per_task;
+    status_t* status;                           /* status[worker]: 各工作线程只写自己的一项，运行后汇总 */
+};
 
 /*============================================================================
  * 静态变量
@@ -21,9 +75,310 @@
 static mic_pair_t g_mic_pairs[NUM_MIC_PAIRS];
 static int g_gcc_initialized = 0;
 
-/* 用于IFFT的临时缓冲区 */
-static complex_t g_cross_spectrum[FFT_SIZE];
-static complex_t g_ifft_result[FFT_SIZE];
+/* 启用的麦克风对 */
+static int g_pair_selected[NUM_MIC_PAIRS];      /* 选取标志 */
+static int g_mic_alive[NUM_CHANNELS];           /* 麦克风正常标志 */
+static int g_active_pairs[NUM_MIC_PAIRS];       /* 启用的对索引 (升序) */
+static int g_num_active = 0;
+static int g_channel_used[NUM_CHANNELS];        /* 通道是否被启用的对使用 */
+
+/* gcc_phat_*接口使用的默认上下文 */
+static gcc_ctx_t* g_ctx = NULL;
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+/**
+ * @brief 加权频谱的互功率谱 W1(f) * conj(W2(f)) (已含频域加权)
+ * 
+ * 只计算频带 [bin_lo, bin_hi] 内的频点，频带外的输出保持为零 (设置频带时清零)。
+ */
+static void compute_whitened_cross(const gcc_ctx_t* ctx,
+                                   const complex_t* white_ch1,
+                                   const complex_t* white_ch2,
+                                   complex_t* cross_spectrum,
+                                   int bin_hi)
+{
+    if (ctx->use_mask) {
+        for (int bin = ctx->bin_lo; bin <= bin_hi; bin++) {
+            float32_t ar = white_ch1[bin].real, ai = white_ch1[bin].imag;
+            float32_t br = white_ch2[bin].real, bi = white_ch2[bin].imag;
+            cross_spectrum[bin].real = (ar * br + ai * bi) * ctx->mask[bin];
+            cross_spectrum[bin].imag = (ai * br - ar * bi) * ctx->mask[bin];
+        }
+        return;
+    }
+    
+    for (int bin = ctx->bin_lo; bin <= bin_hi; bin++) {
+        float32_t ar = white_ch1[bin].real, ai = white_ch1[bin].imag;
+        float32_t br = white_ch2[bin].real, bi = white_ch2[bin].imag;
+        cross_spectrum[bin].real = ar * br + ai * bi;
+        cross_spectrum[bin].imag = ai * br - ar * bi;
+    }
+}
+
+/**
+ * @brief 两个麦克风对的互功率谱打包为一个N点Hermitian组合 Z = A + jB
+ * 
+ * A、B为实信号的频谱 (A[N-k] = conj(A[k]))，故
+ *   Z[k]   = A[k] + j*B[k]
+ *   Z[N-k] = conj(A[k]) + j*conj(B[k])
+ * DC与Nyquist频点只取实部，与实数IFFT的约定一致。
+ * 逆变换原位覆盖打包缓冲区，频带外的频点每次直接置零，不计算互功率谱。
+ */
+static void pack_cross_pair(const gcc_ctx_t* ctx,
+                            const complex_t* white_a1, const complex_t* white_a2,
+                            const complex_t* white_b1, const complex_t* white_b2,
+                            complex_t* packed)
+{
+    int half = FFT_SIZE / 2;
+    int lo = ctx->bin_lo;
+    int hi = ctx->bin_hi;
+    
+    /* 频带外: 低端 Z[0..lo) 与 Z[N-lo+1..N)，高端 Z[hi+1..N-hi-1] 置零 */
+    if (lo > 0) {
+        memset(packed, 0, lo * sizeof(complex_t));
+        memset(packed + FFT_SIZE - lo + 1, 0, (lo - 1) * sizeof(complex_t));
+    }
+    if (hi < half) {
+        memset(packed + hi + 1, 0, (FFT_SIZE - 2 * hi - 1) * sizeof(complex_t));
+    }
+    
+    for (int k = lo; k <= hi; k++) {
+        /* A = Wa1 * conj(Wa2), B = Wb1 * conj(Wb2)，再乘频点权重 (未设置时为1) */
+        float32_t m = ctx->mask[k];
+        float32_t ar = (white_a1[k].real * white_a2[k].real + white_a1[k].imag * white_a2[k].imag) * m;
+        float32_t ai = (white_a1[k].imag * white_a2[k].real - white_a1[k].real * white_a2[k].imag) * m;
+        float32_t br = (white_b1[k].real * white_b2[k].real + white_b1[k].imag * white_b2[k].imag) * m;
+        float32_t bi = (white_b1[k].imag * white_b2[k].real - white_b1[k].real * white_b2[k].imag) * m;
+        
+        if (k == 0 || k == half) {
+            packed[k].real = ar;
+            packed[k].imag = br;
+            continue;
+        }
+        
+        packed[k].real = ar - bi;
+        packed[k].imag = ai + br;
+        packed[FFT_SIZE - k].real = ar + bi;
+        packed[FFT_SIZE - k].imag = br - ai;
+    }
+}
+
+/**
+ * @brief 两对合一: 一次N点复数IFFT得到两个麦克风对的GCC (实部/虚部，已fftshift)
+ */
+static status_t compute_pair_packed(gcc_ctx_t* ctx, const fft_result_t* spec1, const fft_result_t* spec2,
+                                    int pair_a, int pair_b, float32_t* gcc_a, float32_t* gcc_b)
+{
+    const mic_pair_t* a = &g_mic_pairs[pair_a];
+    const mic_pair_t* b = &g_mic_pairs[pair_b];
+    complex_t* packed = ctx->packed;
+    int half = FFT_SIZE / 2;
+    
+    pack_cross_pair(ctx, spec1->data[a->mic1], spec2->data[a->mic2],
+                    spec1->data[b->mic1], spec2->data[b->mic2], packed);
+    
+    status_t status = fft_plan_execute(ctx->plan, packed, packed, FFT_BACKWARD);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /* 拆分并fftshift: 实部为A的GCC，虚部为B的GCC */
+    for (int i = 0; i < half; i++) {
+        gcc_a[i + half] = packed[i].real;
+        gcc_b[i + half] = packed[i].imag;
+        gcc_a[i] = packed[i + half].real;
+        gcc_b[i] = packed[i + half].imag;
+    }
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 原位fftshift: 交换前后两半，将零时延移到中心
+ */
+static void fftshift_inplace(float32_t* data)
+{
+    int half = FFT_SIZE / 2;
+    for (int i = 0; i < half; i++) {
+        float32_t tmp = data[i];
+        data[i] = data[i + half];
+        data[i + half] = tmp;
+    }
+}
+
+/**
+ * @brief 计算启用列表中第 [first, first + count) 个麦克风对的GCC (批量接口与并行任务共用)
+ * 
+ * spec1为各对第一个通道使用的加权频谱，spec2为第二个通道使用的频谱
+ * (对称加权时与spec1相同，ROTH为原始频谱)。
+ */
+static status_t ctx_compute_pairs(gcc_ctx_t* ctx, const fft_result_t* spec1, const fft_result_t* spec2,
+                                  int first, int count, gcc_result_t* gcc_result)
+{
+    int end = first + count;
+    
+    /* 时延窗口: 逐对计算中心 ±max_lag 部分，窗口外的值不更新 */
+    if (ctx->lag_plan != NULL) {
+        int offset = GCC_LENGTH / 2 - ctx->lag_plan->max_lag;
+        
+        for (int i = first; i < end; i++) {
+            int pair = g_active_pairs[i];
+            int mic1 = g_mic_pairs[pair].mic1;
+            int mic2 = g_mic_pairs[pair].mic2;
+            
+            compute_whitened_cross(ctx, spec1->data[mic1], spec2->data[mic2], ctx->cross[0], ctx->bin_hi);
+            
+            status_t status = fft_lag_plan_execute(ctx->lag_plan, ctx->cross[0],
+                                                   gcc_result->data[pair] + offset);
+            if (status != STATUS_OK) {
+                printf("[ERROR] GCC-PHAT failed for pair %d\n", pair);
+                return status;
+            }
+        }
+        
+        return STATUS_OK;
+    }
+    
+    /* 两对合一: 每两个麦克风对一次N点复数IFFT，对数为奇数时末对单独计算 */
+    if (ctx->ifft_mode == GCC_IFFT_PAIRED) {
+        int i = first;
+        for (; i + 1 < end; i += 2) {
+            int pair = g_active_pairs[i];
+            int other = g_active_pairs[i + 1];
+            status_t status = compute_pair_packed(ctx, spec1, spec2, pair, other,
+                                                  gcc_result->data[pair], gcc_result->data[other]);
+            if (status != STATUS_OK) {
+                printf("[ERROR] GCC-PHAT failed for pairs %d-%d\n", pair, other);
+                return status;
+            }
+        }
+        
+        /* 剩下的一对用N点实数IFFT */
+        if (i < end) {
+            int pair = g_active_pairs[i];
+            int mic1 = g_mic_pairs[pair].mic1;
+            int mic2 = g_mic_pairs[pair].mic2;
+            
+            compute_whitened_cross(ctx, spec1->data[mic1], spec2->data[mic2], ctx->cross[0], ctx->bin_hi);
+            status_t status = fft_plan_execute_c2r(ctx->plan, ctx->cross[0], gcc_result->data[pair]);
+            if (status != STATUS_OK) {
+                printf("[ERROR] GCC-PHAT failed for pair %d\n", pair);
+                return status;
+            }
+            fftshift_inplace(gcc_result->data[pair]);
+        }
+        
+        return STATUS_OK;
+    }
+    
+    /* 每FFT_BATCH_LANES个麦克风对为一组，批量执行实数IFFT */
+    for (int base = first; base < end; base += FFT_BATCH_LANES) {
+        int lanes = end - base;
+        if (lanes > FFT_BATCH_LANES) {
+            lanes = FFT_BATCH_LANES;
+        }
+        
+        const complex_t* inputs[FFT_BATCH_LANES];
+        float32_t* outputs[FFT_BATCH_LANES];
+        
+        for (int l = 0; l < lanes; l++) {
+            int pair = g_active_pairs[base + l];
+            int mic1 = g_mic_pairs[pair].mic1;
+            int mic2 = g_mic_pairs[pair].mic2;
+            
+            compute_whitened_cross(ctx, spec1->data[mic1], spec2->data[mic2], ctx->cross[l], ctx->bin_hi);
+            inputs[l] = ctx->cross[l];
+            outputs[l] = gcc_result->data[pair];
+        }
+        
+        status_t status = fft_plan_execute_c2r_batch(ctx->plan, inputs, outputs, lanes);
+        if (status != STATUS_OK) {
+            printf("[ERROR] GCC-PHAT failed for pairs %d-%d\n",
+                   g_active_pairs[base], g_active_pairs[base + lanes - 1]);
+            return status;
+        }
+        
+        /* fftshift: 将零时延移到中心 */
+        for (int l = 0; l < lanes; l++) {
+            fftshift_inplace(outputs[l]);
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 由选取标志与麦克风屏蔽标志重建启用列表
+ * @return 状态码 (没有任何可用对时不修改当前列表)
+ */
+static status_t update_active_pairs(const int* selected, const int* alive)
+{
+    int count = 0;
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        if (selected[pair] && alive[g_mic_pairs[pair].mic1] && alive[g_mic_pairs[pair].mic2]) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        printf("[ERROR] No active microphone pair left\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 调用者可直接传入当前的标志数组 */
+    memmove(g_pair_selected, selected, sizeof(g_pair_selected));
+    memmove(g_mic_alive, alive, sizeof(g_mic_alive));
+    memset(g_channel_used, 0, sizeof(g_channel_used));
+    
+    g_num_active = 0;
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        const mic_pair_t* mp = &g_mic_pairs[pair];
+        if (g_pair_selected[pair] && g_mic_alive[mp->mic1] && g_mic_alive[mp->mic2]) {
+            g_active_pairs[g_num_active++] = pair;
+            g_channel_used[mp->mic1] = 1;
+            g_channel_used[mp->mic2] = 1;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 麦克风对的基线向量 p1 - p2 (双精度)
+ */
+static void pair_baseline(const mic_position_t* mic_positions, int pair, float64_t b[3])
+{
+    const mic_position_t* p1 = &mic_positions[g_mic_pairs[pair].mic1];
+    const mic_position_t* p2 = &mic_positions[g_mic_pairs[pair].mic2];
+    b[0] = (float64_t)p1->x - p2->x;
+    b[1] = (float64_t)p1->y - p2->y;
+    b[2] = (float64_t)p1->z - p2->z;
+}
+
+/**
+ * @brief 3x3对称矩阵求逆 (伴随矩阵法)
+ */
+static void invert_sym3(const float64_t m[3][3], float64_t inv[3][3])
+{
+    inv[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    inv[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    inv[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    inv[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    inv[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    inv[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    inv[1][0] = inv[0][1];
+    inv[2][0] = inv[0][2];
+    inv[2][1] = inv[1][2];
+    
+    float64_t det = m[0][0] * inv[0][0] + m[0][1] * inv[1][0] + m[0][2] * inv[2][0];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            inv[i][j] /= det;
+        }
+    }
+}
 
 /*============================================================================
  * 函数实现
@@ -51,10 +406,26 @@ status_t gcc_phat_init(void)
         return STATUS_OK;
     }
     
-    /* 初始化麦克风对 */
+    /* 初始化麦克风对，默认全部启用 */
     gcc_phat_init_mic_pairs();
     
+    int selected[NUM_MIC_PAIRS], alive[NUM_CHANNELS];
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        selected[pair] = 1;
+    }
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        alive[ch] = 1;
+    }
+    update_active_pairs(selected, alive);
     g_gcc_initialized = 1;
+    
+    /* 默认上下文 */
+    g_ctx = gcc_ctx_create();
+    if (g_ctx == NULL) {
+        g_gcc_initialized = 0;
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
     printf("[INFO] GCC-PHAT module initialized\n");
     
     return STATUS_OK;
@@ -62,97 +433,854 @@ status_t gcc_phat_init(void)
 
 void gcc_phat_cleanup(void)
 {
+    gcc_ctx_destroy(g_ctx);
+    g_ctx = NULL;
     g_gcc_initialized = 0;
 }
 
-void gcc_phat_get_mic_pair(int pair_index, int* mic1, int* mic2)
+/*============================================================================
+ * GCC上下文
+ *============================================================================*/
+
+gcc_ctx_t* gcc_ctx_create(void)
 {
-    if (pair_index >= 0 && pair_index < NUM_MIC_PAIRS) {
-        *mic1 = g_mic_pairs[pair_index].mic1;
-        *mic2 = g_mic_pairs[pair_index].mic2;
-    } else {
-        *mic1 = -1;
-        *mic2 = -1;
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return NULL;
     }
+    
+    gcc_ctx_t* ctx = (gcc_ctx_t*)calloc(1, sizeof(gcc_ctx_t));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    
+    ctx->ifft_mode = GCC_IFFT_REAL;
+    gcc_weight_init(&ctx->weight, GCC_WEIGHT_PHAT, 0.0f);
+    ctx->bin_lo = 0;
+    ctx->bin_hi = FFT_BINS - 1;
+    for (int bin = 0; bin < FFT_BINS; bin++) {
+        ctx->mask[bin] = 1.0f;
+    }
+    ctx->plan = fft_plan_create(FFT_SIZE);
+    if (ctx->plan == NULL) {
+        gcc_ctx_destroy(ctx);
+        return NULL;
+    }
+    
+    return ctx;
 }
 
-status_t gcc_phat_compute_pair(const complex_t* fft_ch1,
-                                const complex_t* fft_ch2,
-                                float32_t* gcc_output,
-                                int num_bins)
+void gcc_ctx_destroy(gcc_ctx_t* ctx)
 {
-    const float32_t epsilon = 1e-10f;  /* 防止除零 */
+    if (ctx == NULL) {
+        return;
+    }
     
-    /* 
-     * 步骤1: 计算互功率谱 X1(f) * conj(X2(f))
-     * 步骤2: PHAT加权 (归一化)
-     */
+    fft_plan_destroy(ctx->plan);
+    fft_lag_plan_destroy(ctx->lag_plan);
+    fft_lag_plan_destroy(ctx->pair_plan);
+    free(ctx);
+}
+
+status_t gcc_ctx_set_max_lag(gcc_ctx_t* ctx, int max_lag)
+{
+    if (ctx == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (max_lag >= GCC_LENGTH / 2) {
+        printf("[ERROR] GCC lag window %d exceeds half length %d\n", max_lag, GCC_LENGTH / 2);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
     
-    /* 清零交叉谱缓冲区 */
-    memset(g_cross_spectrum, 0, FFT_SIZE * sizeof(complex_t));
+    fft_lag_plan_destroy(ctx->lag_plan);
+    ctx->lag_plan = NULL;
     
-    /* 计算正频率部分 */
-    for (int bin = 0; bin < num_bins; bin++) {
-        /* 互功率谱: X1 * conj(X2) */
-        complex_t conj_ch2 = complex_conjugate(fft_ch2[bin]);
-        complex_t cross = complex_multiply(fft_ch1[bin], conj_ch2);
-        
-        /* PHAT加权: 归一化 */
-        float32_t magnitude = complex_magnitude(cross);
-        if (magnitude > epsilon) {
-            g_cross_spectrum[bin].real = cross.real / magnitude;
-            g_cross_spectrum[bin].imag = cross.imag / magnitude;
-        } else {
-            g_cross_spectrum[bin].real = 0.0f;
-            g_cross_spectrum[bin].imag = 0.0f;
+    if (max_lag <= 0) {
+        return STATUS_OK;
+    }
+    
+    fft_lag_plan_t* lag_plan = fft_lag_plan_create(FFT_SIZE, max_lag, FFT_LAGS_AUTO);
+    if (lag_plan == NULL) {
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    /* 代价模型选择完整变换时，批量IFFT更快，不启用窗口 */
+    if (lag_plan->strategy == FFT_LAGS_FULL) {
+        fft_lag_plan_destroy(lag_plan);
+        return STATUS_OK;
+    }
+    
+    fft_lag_plan_set_band(lag_plan, ctx->bin_lo, ctx->bin_hi);
+    ctx->lag_plan = lag_plan;
+    return STATUS_OK;
+}
+
+status_t gcc_ctx_set_ifft_mode(gcc_ctx_t* ctx, gcc_ifft_mode_t mode)
+{
+    if (ctx == NULL || (mode != GCC_IFFT_REAL && mode != GCC_IFFT_PAIRED)) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    ctx->ifft_mode = mode;
+    return STATUS_OK;
+}
+
+status_t gcc_ctx_set_weighting(gcc_ctx_t* ctx, gcc_weighting_t type, float32_t param)
+{
+    if (ctx == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 参数无效时保留原加权 */
+    gcc_weight_t weight;
+    status_t status = gcc_weight_init(&weight, type, param);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    ctx->weight = weight;
+    gcc_weight_cache_reset(&ctx->cache);
+    
+    return STATUS_OK;
+}
+
+gcc_weighting_t gcc_ctx_get_weighting(const gcc_ctx_t* ctx)
+{
+    return (ctx != NULL) ? ctx->weight.type : GCC_WEIGHT_PHAT;
+}
+
+status_t gcc_ctx_weight_spectrum(gcc_ctx_t* ctx, const fft_result_t* fft_result,
+                                 fft_result_t* weighted)
+{
+    if (ctx == NULL || fft_result == NULL || weighted == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (!gcc_weight_is_symmetric(&ctx->weight)) {
+        printf("[ERROR] %s weighting needs the raw spectrum, use gcc_ctx_compute_all\n",
+               gcc_weighting_name(ctx->weight.type));
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        if (!g_channel_used[ch]) {
+            continue;
         }
+        gcc_weight_apply_channel(&ctx->weight, &ctx->cache, ch, fft_result->data[ch], weighted->data[ch],
+                                 ctx->bin_lo, ctx->bin_hi - ctx->bin_lo + 1);
     }
     
-    /* 利用共轭对称性填充负频率部分 */
-    for (int bin = 1; bin < num_bins - 1; bin++) {
-        g_cross_spectrum[FFT_SIZE - bin] = complex_conjugate(g_cross_spectrum[bin]);
+    return STATUS_OK;
+}
+
+status_t gcc_ctx_set_band(gcc_ctx_t* ctx, float32_t f_lo, float32_t f_hi)
+{
+    int bin_lo, bin_hi;
+    if (ctx == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
     }
     
-    /* 步骤3: IFFT得到GCC */
-    status_t status = fft_inverse(g_cross_spectrum, g_ifft_result, FFT_SIZE);
+    status_t status = gcc_phat_band_to_bins(f_lo, f_hi, &bin_lo, &bin_hi);
     if (status != STATUS_OK) {
         return status;
     }
     
-    /* 提取实部作为GCC结果，并进行fftshift */
-    int half = FFT_SIZE / 2;
-    for (int i = 0; i < FFT_SIZE; i++) {
-        /* fftshift: 将零时延移到中心 */
-        int shifted_idx = (i + half) % FFT_SIZE;
-        gcc_output[shifted_idx] = g_ifft_result[i].real;
+    /* 互功率谱缓冲区只写入频带内的频点，频带外在此一次性清零 */
+    ctx->bin_lo = bin_lo;
+    ctx->bin_hi = bin_hi;
+    memset(ctx->cross, 0, sizeof(ctx->cross));
+    
+    if (ctx->lag_plan != NULL) {
+        fft_lag_plan_set_band(ctx->lag_plan, bin_lo, bin_hi);
+    }
+    if (ctx->pair_plan != NULL) {
+        fft_lag_plan_set_band(ctx->pair_plan, bin_lo, bin_hi);
     }
     
     return STATUS_OK;
 }
 
-status_t gcc_phat_compute_all(const fft_result_t* fft_result, 
-                               gcc_result_t* gcc_result)
+status_t gcc_ctx_set_band_mask(gcc_ctx_t* ctx, const float32_t* mask)
 {
-    if (!g_gcc_initialized) {
-        printf("[ERROR] GCC-PHAT module not initialized\n");
+    if (ctx == NULL) {
         return STATUS_ERROR_INVALID_PARAM;
     }
     
-    /* 遍历所有麦克风对 */
-    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
-        int mic1 = g_mic_pairs[pair].mic1;
-        int mic2 = g_mic_pairs[pair].mic2;
-        
-        status_t status = gcc_phat_compute_pair(
-            fft_result->data[mic1],
-            fft_result->data[mic2],
-            gcc_result->data[pair],
-            FFT_BINS
-        );
-        
+    ctx->use_mask = (mask != NULL);
+    for (int bin = 0; bin < FFT_BINS; bin++) {
+        ctx->mask[bin] = (mask != NULL) ? mask[bin] : 1.0f;
+    }
+    
+    return STATUS_OK;
+}
+
+void gcc_ctx_get_band(const gcc_ctx_t* ctx, int* bin_lo, int* bin_hi)
+{
+    *bin_lo = (ctx != NULL) ? ctx->bin_lo : 0;
+    *bin_hi = (ctx != NULL) ? ctx->bin_hi : FFT_BINS - 1;
+}
+
+const float32_t* gcc_ctx_get_band_mask(const gcc_ctx_t* ctx)
+{
+    return (ctx != NULL && ctx->use_mask) ? ctx->mask : NULL;
+}
+
+status_t gcc_ctx_execute_fft(gcc_ctx_t* ctx, const audio_frame_t* frame, fft_result_t* fft_result)
+{
+    if (ctx == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    return fft_plan_execute_frame(ctx->plan, frame, fft_result);
+}
+
+status_t gcc_ctx_compute_all(gcc_ctx_t* ctx, const fft_result_t* fft_result,
+                             gcc_result_t* gcc_result)
+{
+    if (ctx == NULL || fft_result == NULL || gcc_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 每帧只加权各通道一次，互功率谱退化为纯复数乘法 (跳过未被启用的对使用的通道) */
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        if (!g_channel_used[ch]) {
+            continue;
+        }
+        gcc_weight_apply_channel(&ctx->weight, &ctx->cache, ch, fft_result->data[ch],
+                                 ctx->whitened.data[ch], ctx->bin_lo, ctx->bin_hi - ctx->bin_lo + 1);
+    }
+    
+    const fft_result_t* spec2 = gcc_weight_is_symmetric(&ctx->weight) ? &ctx->whitened : fft_result;
+    return ctx_compute_pairs(ctx, &ctx->whitened, spec2, 0, g_num_active, gcc_result);
+}
+
+status_t gcc_ctx_compute_all_whitened(gcc_ctx_t* ctx, const fft_result_t* whitened,
+                                      gcc_result_t* gcc_result)
+{
+    if (ctx == NULL || whitened == NULL || gcc_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    return ctx_compute_pairs(ctx, whitened, whitened, 0, g_num_active, gcc_result);
+}
+
+status_t gcc_ctx_compute_pair_lags(gcc_ctx_t* ctx, const fft_result_t* whitened,
+                                   int pair, int max_lag, float32_t* lags)
+{
+    if (ctx == NULL || whitened == NULL || lags == NULL || pair < 0 || pair >= NUM_MIC_PAIRS) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 时延范围变化时重建计划 (策略由代价模型选择，含完整IFFT后截取) */
+    if (ctx->pair_plan == NULL || ctx->pair_plan->max_lag != max_lag) {
+        fft_lag_plan_destroy(ctx->pair_plan);
+        ctx->pair_plan = fft_lag_plan_create(FFT_SIZE, max_lag, FFT_LAGS_AUTO);
+        if (ctx->pair_plan == NULL) {
+            return STATUS_ERROR_MEMORY_ALLOC;
+        }
+        fft_lag_plan_set_band(ctx->pair_plan, ctx->bin_lo, ctx->bin_hi);
+    }
+    
+    int mic1 = g_mic_pairs[pair].mic1;
+    int mic2 = g_mic_pairs[pair].mic2;
+    compute_whitened_cross(ctx, whitened->data[mic1], whitened->data[mic2], ctx->cross[0], ctx->bin_hi);
+    
+    return fft_lag_plan_execute(ctx->pair_plan, ctx->cross[0], lags);
+}
+
+/*============================================================================
+ * 并行GCC
+ *============================================================================*/
+
+/**
+ * @brief 加权任务: 每个任务一个通道
+ */
+static void pool_whiten_task(void* arg, int task, int worker)
+{
+    gcc_pool_t* pool = (gcc_pool_t*)arg;
+    (void)worker;
+    const gcc_ctx_t* ctx = pool->ctx[0];
+    if (!g_channel_used[task]) {
+        return;
+    }
+    gcc_weight_apply_channel(&pool->weight, pool->cache, task, pool->fft_result->data[task],
+                             pool->whitened->data[task], ctx->bin_lo, ctx->bin_hi - ctx->bin_lo + 1);
+}
+
+/**
+ * @brief 麦克风对任务: 每个任务为启用列表中的pairs_per_task个麦克风对，使用工作线程自己的上下文
+ */
+static void pool_pairs_task(void* arg, int task, int worker)
+{
+    gcc_pool_t* pool = (gcc_pool_t*)arg;
+    int first = task * pool->pairs_per_task;
+    int count = g_num_active - first;
+    if (count > pool->pairs_per_task) {
+        count = pool->pairs_per_task;
+    }
+    
+    const fft_result_t* spec2 = gcc_weight_is_symmetric(&pool->weight) ? pool->whitened : pool->fft_result;
+    status_t status = ctx_compute_pairs(pool->ctx[worker], pool->whitened, spec2, first, count,
+                                        pool->gcc_result);
+    if (status != STATUS_OK) {
+        pool->status[worker] = status;
+    }
+}
+
+gcc_pool_t* gcc_pool_create(int num_threads)
+{
+    gcc_pool_t* pool = (gcc_pool_t*)calloc(1, sizeof(gcc_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    
+    pool->threads = thread_pool_create(num_threads);
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    
+    pool->num_workers = thread_pool_size(pool->threads);
+    pool->ctx = (gcc_ctx_t**)calloc(pool->num_workers, sizeof(gcc_ctx_t*));
+    pool->whitened = (fft_result_t*)malloc(sizeof(fft_result_t));
+    pool->cache = (gcc_weight_cache_t*)calloc(1, sizeof(gcc_weight_cache_t));
+    pool->status = (status_t*)calloc(pool->num_workers, sizeof(status_t));
+    gcc_weight_init(&pool->weight, GCC_WEIGHT_PHAT, 0.0f);
+    if (pool->ctx == NULL || pool->whitened == NULL || pool->cache == NULL || pool->status == NULL) {
+        gcc_pool_destroy(pool);
+        return NULL;
+    }
+    
+    for (int w = 0; w < pool->num_workers; w++) {
+        pool->ctx[w] = gcc_ctx_create();
+        if (pool->ctx[w] == NULL) {
+            gcc_pool_destroy(pool);
+            return NULL;
+        }
+    }
+    
+    return pool;
+}
+
+void gcc_pool_destroy(gcc_pool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    
+    thread_pool_destroy(pool->threads);
+    if (pool->ctx != NULL) {
+        for (int w = 0; w < pool->num_workers; w++) {
+            gcc_ctx_destroy(pool->ctx[w]);
+        }
+    }
+    free(pool->ctx);
+    free(pool->whitened);
+    free(pool->cache);
+    free(pool->status);
+    free(pool);
+}
+
+int gcc_pool_size(const gcc_pool_t* pool)
+{
+    return (pool != NULL) ? pool->num_workers : 0;
+}
+
+status_t gcc_pool_set_max_lag(gcc_pool_t* pool, int max_lag)
+{
+    if (pool == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int w = 0; w < pool->num_workers; w++) {
+        status_t status = gcc_ctx_set_max_lag(pool->ctx[w], max_lag);
+        if (status != STATUS_OK) {
+            return status;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+status_t gcc_pool_set_band(gcc_pool_t* pool, float32_t f_lo, float32_t f_hi)
+{
+    if (pool == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int w = 0; w < pool->num_workers; w++) {
+        status_t status = gcc_ctx_set_band(pool->ctx[w], f_lo, f_hi);
+        if (status != STATUS_OK) {
+            return status;
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+status_t gcc_pool_set_band_mask(gcc_pool_t* pool, const float32_t* mask)
+{
+    if (pool == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int w = 0; w < pool->num_workers; w++) {
+        gcc_ctx_set_band_mask(pool->ctx[w], mask);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t gcc_pool_set_weighting(gcc_pool_t* pool, gcc_weighting_t type, float32_t param)
+{
+    if (pool == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 参数无效时保留原加权 */
+    gcc_weight_t weight;
+    status_t status = gcc_weight_init(&weight, type, param);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    pool->weight = weight;
+    gcc_weight_cache_reset(pool->cache);
+    
+    return STATUS_OK;
+}
+
+status_t gcc_phat_compute_all_parallel(gcc_pool_t* pool,
+                                       const fft_result_t* fft_result,
+                                       gcc_result_t* gcc_result)
+{
+    if (pool == NULL || fft_result == NULL || gcc_result == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    pool->fft_result = fft_result;
+    pool->gcc_result = gcc_result;
+    for (int w = 0; w < pool->num_workers; w++) {
+        pool->status[w] = STATUS_OK;
+    }
+    
+    /* 阶段1: 各通道加权 */
+    status_t status = thread_pool_run(pool->threads, pool_whiten_task, pool, NUM_CHANNELS);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /*
+     * 阶段2: 麦克风对分发给工作线程。完整GCC按批量IFFT的一组为一个任务，
+     * 时延窗口逐对计算，任务粒度取1对以便均衡
+     */
+    pool->pairs_per_task = (pool->ctx[0]->lag_plan != NULL) ? 1 : FFT_BATCH_LANES;
+    int num_tasks = (g_num_active + pool->pairs_per_task - 1) / pool->pairs_per_task;
+    
+    status = thread_pool_run(pool->threads, pool_pairs_task, pool, num_tasks);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /* 任一工作线程失败即整批失败 */
+    for (int w = 0; w < pool->num_workers; w++) {
+        if (pool->status[w] != STATUS_OK) {
+            return pool->status[w];
+        }
+    }
+    
+    return STATUS_OK;
+}
+
+/*============================================================================
+ * 默认上下文接口
+ *============================================================================*/
+
+status_t gcc_phat_set_max_lag(int max_lag)
+{
+    return gcc_ctx_set_max_lag(g_ctx, max_lag);
+}
+
+status_t gcc_phat_set_ifft_mode(gcc_ifft_mode_t mode)
+{
+    return gcc_ctx_set_ifft_mode(g_ctx, mode);
+}
+
+status_t gcc_phat_set_weighting(gcc_weighting_t type, float32_t param)
+{
+    return gcc_ctx_set_weighting(g_ctx, type, param);
+}
+
+status_t gcc_phat_band_to_bins(float32_t f_lo, float32_t f_hi, int* bin_lo, int* bin_hi)
+{
+    float32_t nyquist = SAMPLE_RATE / 2.0f;
+    if (f_hi <= 0.0f) {
+        f_hi = nyquist;
+    }
+    
+    if (bin_lo == NULL || bin_hi == NULL || f_lo < 0.0f || f_hi > nyquist || f_lo >= f_hi) {
+        printf("[ERROR] Invalid GCC band %.1f - %.1f Hz (Nyquist %.1f Hz)\n", f_lo, f_hi, nyquist);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 频点k的频率为 k * fs / N，只保留完全落在频带内的频点 */
+    int lo = (int)ceilf(f_lo * FFT_SIZE / SAMPLE_RATE);
+    int hi = (int)floorf(f_hi * FFT_SIZE / SAMPLE_RATE);
+    if (hi > FFT_BINS - 1) {
+        hi = FFT_BINS - 1;
+    }
+    if (lo > hi) {
+        printf("[ERROR] GCC band %.1f - %.1f Hz contains no FFT bin\n", f_lo, f_hi);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    *bin_lo = lo;
+    *bin_hi = hi;
+    return STATUS_OK;
+}
+
+status_t gcc_phat_set_band(float32_t f_lo, float32_t f_hi)
+{
+    status_t status = gcc_ctx_set_band(g_ctx, f_lo, f_hi);
+    if (status == STATUS_OK && DEBUG_PRINT) {
+        printf("[INFO] GCC band: bins %d-%d of %d\n", g_ctx->bin_lo, g_ctx->bin_hi, FFT_BINS);
+    }
+    return status;
+}
+
+status_t gcc_phat_set_band_mask(const float32_t* mask)
+{
+    return gcc_ctx_set_band_mask(g_ctx, mask);
+}
+
+void gcc_phat_get_band(int* bin_lo, int* bin_hi)
+{
+    gcc_ctx_get_band(g_ctx, bin_lo, bin_hi);
+}
+
+const float32_t* gcc_phat_get_band_mask(void)
+{
+    return gcc_ctx_get_band_mask(g_ctx);
+}
+
+gcc_weighting_t gcc_phat_get_weighting(void)
+{
+    return gcc_ctx_get_weighting(g_ctx);
+}
+
+status_t gcc_phat_weight_spectrum(const fft_result_t* fft_result, fft_result_t* weighted)
+{
+    return gcc_ctx_weight_spectrum(g_ctx, fft_result, weighted);
+}
+
+gcc_ifft_mode_t gcc_phat_get_ifft_mode(void)
+{
+    return (g_ctx != NULL) ? g_ctx->ifft_mode : GCC_IFFT_REAL;
+}
+
+int gcc_phat_get_max_lag(void)
+{
+    return (g_ctx != NULL && g_ctx->lag_plan != NULL) ? g_ctx->lag_plan->max_lag : 0;
+}
+
+const char* gcc_phat_lag_strategy_name(void)
+{
+    const fft_lag_plan_t* lag_plan = (g_ctx != NULL) ? g_ctx->lag_plan : NULL;
+    return fft_lags_strategy_name((lag_plan != NULL) ? lag_plan->strategy : FFT_LAGS_FULL);
+}
+
+void gcc_phat_get_mic_pair(int pair_index, int* mic1, int* mic2)
+{
+    if (pair_index >= 0 && pair_index < NUM_MIC_PAIRS) {
+        *mic1 = g_mic_pairs[pair_index].mic1;
+        *mic2 = g_mic_pairs[pair_index].mic2;
+    } else {
+        *mic1 = -1;
+        *mic2 = -1;
+    }
+}
+
+status_t gcc_phat_select_pairs(gcc_pair_select_t method, const mic_position_t* mic_positions,
+                               int max_pairs)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (method != GCC_PAIRS_ALL && method != GCC_PAIRS_LONGEST && method != GCC_PAIRS_GREEDY) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 候选: 两个麦克风都正常的对 */
+    int candidate[NUM_MIC_PAIRS];
+    int num_candidates = 0;
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        candidate[pair] = g_mic_alive[g_mic_pairs[pair].mic1] && g_mic_alive[g_mic_pairs[pair].mic2];
+        num_candidates += candidate[pair];
+    }
+    
+    int selected[NUM_MIC_PAIRS];
+    if (method == GCC_PAIRS_ALL || max_pairs <= 0 || max_pairs >= num_candidates) {
+        for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+            selected[pair] = 1;
+        }
+        return update_active_pairs(selected, g_mic_alive);
+    }
+    if (mic_positions == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    float64_t baseline[NUM_MIC_PAIRS][3];
+    float64_t max_len2 = 0.0;
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        float64_t* b = baseline[pair];
+        pair_baseline(mic_positions, pair, b);
+        float64_t len2 = b[0] * b[0] + b[1] * b[1] + b[2] * b[2];
+        if (len2 > max_len2) {
+            max_len2 = len2;
+        }
+    }
+    
+    /* F = eps*I + sum b*b^T，eps使平面阵列等退化几何下F仍可逆 */
+    float64_t fisher[3][3] = { { 0.0 } };
+    float64_t inv[3][3];
+    for (int i = 0; i < 3; i++) {
+        fisher[i][i] = 1e-3 * max_len2;
+    }
+    
+    memset(selected, 0, sizeof(selected));
+    for (int n = 0; n < max_pairs; n++) {
+        invert_sym3(fisher, inv);
+        
+        /* 得分相同时取索引小的对 */
+        int best = -1;
+        float64_t best_score = -1.0;
+        for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+            if (!candidate[pair] || selected[pair]) {
+                continue;
+            }
+            
+            const float64_t* b = baseline[pair];
+            float64_t score = b[0] * b[0] + b[1] * b[1] + b[2] * b[2];
+            if (method == GCC_PAIRS_GREEDY) {
+                score = 0.0;
+                for (int i = 0; i < 3; i++) {
+                    score += b[i] * (inv[i][0] * b[0] + inv[i][1] * b[1] + inv[i][2] * b[2]);
+                }
+            }
+            /* 相对容差避免舍入误差打乱等长基线的顺序 */
+            if (score > best_score * (1.0 + 1e-9)) {
+                best_score = score;
+                best = pair;
+            }
+        }
+        
+        selected[best] = 1;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                fisher[i][j] += baseline[best][i] * baseline[best][j];
+            }
+        }
+    }
+    
+    status_t status = update_active_pairs(selected, g_mic_alive);
+    if (status == STATUS_OK && DEBUG_PRINT) {
+        printf("[INFO] Selected %d of %d microphone pairs (%s)\n", g_num_active, NUM_MIC_PAIRS,
+               (method == GCC_PAIRS_GREEDY) ? "greedy" : "longest baselines");
+    }
+    
+    return status;
+}
+
+status_t gcc_phat_set_pair_mask(const int* mask)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int selected[NUM_MIC_PAIRS];
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        selected[pair] = (mask == NULL || mask[pair] != 0);
+    }
+    
+    return update_active_pairs(selected, g_mic_alive);
+}
+
+status_t gcc_phat_set_mic_mask(const int* mask)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int alive[NUM_CHANNELS];
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        alive[ch] = (mask == NULL || mask[ch] != 0);
+    }
+    
+    status_t status = update_active_pairs(g_pair_selected, alive);
+    if (status == STATUS_OK && DEBUG_PRINT) {
+        printf("[INFO] Microphone mask applied: %d active pairs\n", g_num_active);
+    }
+    
+    return status;
+}
+
+int gcc_phat_get_active_pairs(const int** pairs)
+{
+    if (pairs != NULL) {
+        *pairs = g_active_pairs;
+    }
+    return g_num_active;
+}
+
+int gcc_phat_pair_is_active(int pair_index)
+{
+    if (pair_index < 0 || pair_index >= NUM_MIC_PAIRS) {
+        return 0;
+    }
+    
+    const mic_pair_t* mp = &g_mic_pairs[pair_index];
+    return g_pair_selected[pair_index] && g_mic_alive[mp->mic1] && g_mic_alive[mp->mic2];
+}
+
+status_t gcc_phat_compute_pair(const complex_t* fft_ch1,
+                                const complex_t* fft_ch2,
+                                float32_t* gcc_output,
+                                int num_bins)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    if (num_bins < 0 || num_bins > FFT_BINS) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    complex_t* cross_spectrum = g_ctx->cross[0];
+    complex_t* spec1 = g_ctx->cross[1];
+    complex_t* spec2 = g_ctx->cross[2];
+    float32_t* ifft_result = g_ctx->ifft_result;
+    
+    /* 步骤1: 在GCC频带内按当前加权缩放两个通道 (ROTH的第二个通道不加权) */
+    int lo = g_ctx->bin_lo;
+    int hi = (g_ctx->bin_hi < num_bins - 1) ? g_ctx->bin_hi : num_bins - 1;
+    if (hi >= lo) {
+        int n = hi - lo + 1;
+        gcc_weight_apply(&g_ctx->weight, fft_ch1 + lo, g_ctx->power, spec1 + lo, n);
+        if (gcc_weight_is_symmetric(&g_ctx->weight)) {
+            gcc_weight_apply(&g_ctx->weight, fft_ch2 + lo, g_ctx->power, spec2 + lo, n);
+        } else {
+            memcpy(spec2 + lo, fft_ch2 + lo, n * sizeof(complex_t));
+        }
+    }
+    
+    /* 步骤2: 互功率谱 W1(f) * conj(W2(f))，频带内未提供的高频点清零 */
+    compute_whitened_cross(g_ctx, spec1, spec2, cross_spectrum, hi);
+    if (hi < g_ctx->bin_hi) {
+        int from = (hi >= lo) ? hi + 1 : lo;
+        memset(cross_spectrum + from, 0, (g_ctx->bin_hi - from + 1) * sizeof(complex_t));
+    }
+    
+    /* 启用时延窗口时只计算中心 ±max_lag 部分 */
+    if (g_ctx->lag_plan != NULL) {
+        return fft_lag_plan_execute(g_ctx->lag_plan, cross_spectrum,
+                                    gcc_output + GCC_LENGTH / 2 - g_ctx->lag_plan->max_lag);
+    }
+    
+    /* 步骤3: 实数IFFT得到GCC (负频率由共轭对称性隐含) */
+    status_t status = fft_plan_execute_c2r(g_ctx->plan, cross_spectrum, ifft_result);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    /* fftshift: 将零时延移到中心 */
+    int half = FFT_SIZE / 2;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        int shifted_idx = (i + half) % FFT_SIZE;
+        gcc_output[shifted_idx] = ifft_result[i];
+    }
+    
+    return STATUS_OK;
+}
+
+status_t gcc_phat_whiten_spectrum(const fft_result_t* fft_result,
+                                  fft_result_t* whitened)
+{
+    if (fft_result == NULL || whitened == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* PHAT与各上下文的加权设置无关，使用局部加权配置 */
+    gcc_weight_t phat;
+    float32_t power[FFT_BINS];
+    gcc_weight_init(&phat, GCC_WEIGHT_PHAT, 0.0f);
+    
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        gcc_weight_apply(&phat, fft_result->data[ch], power, whitened->data[ch], FFT_BINS);
+    }
+    
+    return STATUS_OK;
+}
+
+status_t gcc_phat_compute_all(const fft_result_t* fft_result, 
+                               gcc_result_t* gcc_result)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    return gcc_ctx_compute_all(g_ctx, fft_result, gcc_result);
+}
+
+status_t gcc_phat_compute_all_whitened(const fft_result_t* whitened,
+                                       gcc_result_t* gcc_result)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    return gcc_ctx_compute_all_whitened(g_ctx, whitened, gcc_result);
+}
+
+status_t gcc_phat_compact_init(gcc_compact_t* compact, int max_lag)
+{
+    if (compact == NULL || max_lag < 1 || max_lag > MAX_TAU_SAMPLES || max_lag >= GCC_LENGTH / 2) {
+        printf("[ERROR] Invalid compact GCC lag range: %d\n", max_lag);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    compact->max_lag = max_lag;
+    compact->width = 2 * max_lag + 1;
+    memset(compact->data, 0, sizeof(compact->data));
+    
+    return STATUS_OK;
+}
+
+status_t gcc_phat_compute_pair_lags(const fft_result_t* whitened,
+                                    int pair,
+                                    int max_lag,
+                                    float32_t* lags)
+{
+    if (!g_gcc_initialized) {
+        printf("[ERROR] GCC-PHAT module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    return gcc_ctx_compute_pair_lags(g_ctx, whitened, pair, max_lag, lags);
+}
+
+status_t gcc_phat_compute_compact(const fft_result_t* whitened,
+                                  gcc_compact_t* compact)
+{
+    if (compact == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int i = 0; i < g_num_active; i++) {
+        int pair = g_active_pairs[i];
+        status_t status = gcc_phat_compute_pair_lags(whitened, pair, compact->max_lag,
+                                                     compact->data + pair * compact->width);
         if (status != STATUS_OK) {
-            printf("[ERROR] GCC-PHAT failed for pair %d (mic %d, %d)\n", 
-                   pair, mic1, mic2);
+            printf("[ERROR] Compact GCC-PHAT failed for pair %d\n", pair);
             return status;
         }
     }
@@ -0,0 +1,357 @@
+/**
+ * @file gcc_weight.c
+ * @brief GCC频域加权函数实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 每种加权由一个自功率谱内核和一个缩放内核组成:
+ * - 自功率谱: |X|^2 (或SCOT的递归平滑)
+ * - 缩放: 1/sqrt(P) (PHAT/SCOT)、1/P (ROTH)、P^(-β/2) (PHAT-β)
+ * AVX2内核每次处理8个频点，剩余频点交给标量内核。PHAT内核与标量版本逐位一致；
+ * PHAT-β的AVX2内核用多项式近似log2/exp2代替powf，相对误差约1e-7。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "gcc_weight.h"
+#include "fft_simd.h"
+
+/*============================================================================
+ * 常量定义
+ *============================================================================*/
+#define PHAT_EPSILON    1e-10f      /* 幅度低于该值的频点置零 (防止除零) */
+#define POWER_EPSILON   1e-20f      /* 对应的自功率谱阈值 */
+
+/*============================================================================
+ * 标量内核
+ *============================================================================*/
+
+static void power_scalar(const complex_t* x, float32_t* power, float32_t alpha, int n)
+{
+    (void)alpha;
+    for (int k = 0; k < n; k++) {
+        power[k] = x[k].real * x[k].real + x[k].imag * x[k].imag;
+    }
+}
+
+static void smooth_scalar(const complex_t* x, float32_t* power, float32_t alpha, int n)
+{
+    float32_t gain = 1.0f - alpha;
+    for (int k = 0; k < n; k++) {
+        float32_t p = x[k].real * x[k].real + x[k].imag * x[k].imag;
+        power[k] = alpha * power[k] + gain * p;
+    }
+}
+
+/**
+ * @brief s = 1/sqrt(P): PHAT与SCOT
+ */
+static void scale_rsqrt_scalar(const complex_t* x, const float32_t* power,
+                               float32_t exponent, complex_t* w, int n)
+{
+    (void)exponent;
+    for (int k = 0; k < n; k++) {
+        float32_t magnitude = sqrtf(power[k]);
+        float32_t inv = (magnitude > PHAT_EPSILON) ? 1.0f / magnitude : 0.0f;
+        w[k].real = x[k].real * inv;
+        w[k].imag = x[k].imag * inv;
+    }
+}
+
+/**
+ * @brief s = 1/P: ROTH
+ */
+static void scale_recip_scalar(const complex_t* x, const float32_t* power,
+                               float32_t exponent, complex_t* w, int n)
+{
+    (void)exponent;
+    for (int k = 0; k < n; k++) {
+        float32_t inv = (power[k] > POWER_EPSILON) ? 1.0f / power[k] : 0.0f;
+        w[k].real = x[k].real * inv;
+        w[k].imag = x[k].imag * inv;
+    }
+}
+
+/**
+ * @brief s = P^exponent: PHAT-β (exponent = -β/2)
+ */
+static void scale_pow_scalar(const complex_t* x, const float32_t* power,
+                             float32_t exponent, complex_t* w, int n)
+{
+    for (int k = 0; k < n; k++) {
+        float32_t s = (power[k] > POWER_EPSILON) ? powf(power[k], exponent) : 0.0f;
+        w[k].real = x[k].real * s;
+        w[k].imag = x[k].imag * s;
+    }
+}
+
+/*============================================================================
+ * AVX2内核
+ *============================================================================*/
+#if FFT_SIMD_X86
+
+/**
+ * @brief 8个交织复数的 |x|^2 (按频点顺序)
+ */
+FFT_TARGET_AVX2
+static inline __m256 power8_avx2(const complex_t* x)
+{
+    const float32_t* xf = (const float32_t*)x;
+    __m256 a = _mm256_loadu_ps(xf);
+    __m256 b = _mm256_loadu_ps(xf + 8);
+    
+    /* hadd结果为 p0 p1 p4 p5 | p2 p3 p6 p7，按64位交换中间两组 */
+    __m256 h = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(h), 0xD8));
+}
+
+/**
+ * @brief 8个频点的缩放因子分别乘到交织复数的实部与虚部
+ */
+FFT_TARGET_AVX2
+static inline void scale8_avx2(const complex_t* x, __m256 s, complex_t* w)
+{
+    const float32_t* xf = (const float32_t*)x;
+    float32_t* wf = (float32_t*)w;
+    __m256 a = _mm256_loadu_ps(xf);
+    __m256 b = _mm256_loadu_ps(xf + 8);
+    
+    __m256 lo = _mm256_unpacklo_ps(s, s);      /* s0 s0 s1 s1 | s4 s4 s5 s5 */
+    __m256 hi = _mm256_unpackhi_ps(s, s);      /* s2 s2 s3 s3 | s6 s6 s7 s7 */
+    _mm256_storeu_ps(wf, _mm256_mul_ps(a, _mm256_permute2f128_ps(lo, hi, 0x20)));
+    _mm256_storeu_ps(wf + 8, _mm256_mul_ps(b, _mm256_permute2f128_ps(lo, hi, 0x31)));
+}
+
+/**
+ * @brief log2近似 (p为正规格化数): 尾数移到 [sqrt(1/2), sqrt(2))，atanh级数展开到7次
+ */
+FFT_TARGET_AVX2
+static inline __m256 log2_avx2(__m256 p)
+{
+    __m256i bits = _mm256_castps_si256(p);
+    __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+    
+    __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+    e = _mm256_sub_epi32(e, _mm256_castps_si256(big));
+    
+    /* log2(m) = 2/ln2 * (t + t^3/3 + t^5/5 + t^7/7), t = (m-1)/(m+1) */
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 poly = _mm256_set1_ps(0.41219858f);                         /* 2/ln2 / 7 */
+    poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(0.57707802f));    /* 2/ln2 / 5 */
+    poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(0.96179669f));    /* 2/ln2 / 3 */
+    poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(2.88539008f));    /* 2/ln2 */
+    
+    return _mm256_fmadd_ps(poly, t, _mm256_cvtepi32_ps(e));
+}
+
+/**
+ * @brief exp2近似: 整数部分直接写入指数位，小数部分 (|f| <= 0.5) 用6次泰勒多项式
+ */
+FFT_TARGET_AVX2
+static inline __m256 exp2_avx2(__m256 y)
+{
+    y = _mm256_max_ps(_mm256_min_ps(y, _mm256_set1_ps(126.0f)), _mm256_set1_ps(-126.0f));
+    __m256 n = _mm256_round_ps(y, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 u = _mm256_mul_ps(_mm256_sub_ps(y, n), _mm256_set1_ps(0.69314718f));
+    
+    __m256 poly = _mm256_set1_ps(1.0f / 720.0f);
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(1.0f / 120.0f));
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(1.0f / 24.0f));
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(1.0f / 6.0f));
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(0.5f));
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(1.0f));
+    poly = _mm256_fmadd_ps(poly, u, _mm256_set1_ps(1.0f));
+    
+    __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(poly, _mm256_castsi256_ps(scale));
+}
+
+FFT_TARGET_AVX2
+static void power_avx2(const complex_t* x, float32_t* power, float32_t alpha, int n)
+{
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        _mm256_storeu_ps(power + k, power8_avx2(x + k));
+    }
+    power_scalar(x + k, power + k, alpha, n - k);
+}
+
+FFT_TARGET_AVX2
+static void smooth_avx2(const complex_t* x, float32_t* power, float32_t alpha, int n)
+{
+    __m256 va = _mm256_set1_ps(alpha);
+    __m256 vg = _mm256_set1_ps(1.0f - alpha);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256 p = _mm256_mul_ps(vg, power8_avx2(x + k));
+        _mm256_storeu_ps(power + k, _mm256_add_ps(_mm256_mul_ps(va, _mm256_loadu_ps(power + k)), p));
+    }
+    smooth_scalar(x + k, power + k, alpha, n - k);
+}
+
+FFT_TARGET_AVX2
+static void scale_rsqrt_avx2(const complex_t* x, const float32_t* power,
+                             float32_t exponent, complex_t* w, int n)
+{
+    __m256 eps = _mm256_set1_ps(PHAT_EPSILON);
+    __m256 one = _mm256_set1_ps(1.0f);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256 magnitude = _mm256_sqrt_ps(_mm256_loadu_ps(power + k));
+        __m256 mask = _mm256_cmp_ps(magnitude, eps, _CMP_GT_OQ);
+        scale8_avx2(x + k, _mm256_and_ps(_mm256_div_ps(one, magnitude), mask), w + k);
+    }
+    scale_rsqrt_scalar(x + k, power + k, exponent, w + k, n - k);
+}
+
+FFT_TARGET_AVX2
+static void scale_recip_avx2(const complex_t* x, const float32_t* power,
+                             float32_t exponent, complex_t* w, int n)
+{
+    __m256 eps = _mm256_set1_ps(POWER_EPSILON);
+    __m256 one = _mm256_set1_ps(1.0f);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256 p = _mm256_loadu_ps(power + k);
+        __m256 mask = _mm256_cmp_ps(p, eps, _CMP_GT_OQ);
+        scale8_avx2(x + k, _mm256_and_ps(_mm256_div_ps(one, p), mask), w + k);
+    }
+    scale_recip_scalar(x + k, power + k, exponent, w + k, n - k);
+}
+
+FFT_TARGET_AVX2
+static void scale_pow_avx2(const complex_t* x, const float32_t* power,
+                           float32_t exponent, complex_t* w, int n)
+{
+    __m256 eps = _mm256_set1_ps(POWER_EPSILON);
+    __m256 ve = _mm256_set1_ps(exponent);
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256 p = _mm256_loadu_ps(power + k);
+        __m256 mask = _mm256_cmp_ps(p, eps, _CMP_GT_OQ);
+        __m256 s = exp2_avx2(_mm256_mul_ps(ve, log2_avx2(p)));
+        scale8_avx2(x + k, _mm256_and_ps(s, mask), w + k);
+    }
+    scale_pow_scalar(x + k, power + k, exponent, w + k, n - k);
+}
+
+#endif /* FFT_SIMD_X86 */
+
+/*============================================================================
+ * 函数实现
+ *============================================================================*/
+
+status_t gcc_weight_init(gcc_weight_t* weight, gcc_weighting_t type, float32_t param)
+{
+    if (weight == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    memset(weight, 0, sizeof(gcc_weight_t));
+    weight->type = type;
+    weight->symmetric = 1;
+    weight->power_fn = power_scalar;
+    weight->smooth_fn = smooth_scalar;
+
+#if FFT_SIMD_X86
+    int avx2 = (fft_simd_best_engine() == FFT_ENGINE_AVX2);
+    if (avx2) {
+        weight->power_fn = power_avx2;
+        weight->smooth_fn = smooth_avx2;
+    }
+#define SELECT_SCALE(name)  (avx2 ? scale_##name##_avx2 : scale_##name##_scalar)
+#else
+#define SELECT_SCALE(name)  scale_##name##_scalar
+#endif
+    
+    switch (type) {
+        case GCC_WEIGHT_PHAT:
+            weight->scale_fn = SELECT_SCALE(rsqrt);
+            break;
+        
+        case GCC_WEIGHT_PHAT_BETA:
+            if (param < 0.0f || param > 2.0f) {
+                printf("[ERROR] PHAT-beta exponent %.3f out of range [0, 2]\n", param);
+                return STATUS_ERROR_INVALID_PARAM;
+            }
+            weight->param = param;
+            weight->exponent = -0.5f * param;
+            weight->scale_fn = SELECT_SCALE(pow);
+            break;
+        
+        case GCC_WEIGHT_SCOT:
+            if (param < 0.0f || param >= 1.0f) {
+                printf("[ERROR] SCOT smoothing factor %.3f out of range [0, 1)\n", param);
+                return STATUS_ERROR_INVALID_PARAM;
+            }
+            weight->param = param;
+            weight->alpha = param;
+            weight->scale_fn = SELECT_SCALE(rsqrt);
+            break;
+        
+        case GCC_WEIGHT_ROTH:
+            weight->symmetric = 0;
+            weight->scale_fn = SELECT_SCALE(recip);
+            break;
+        
+        default:
+            printf("[ERROR] Unknown GCC weighting %d\n", (int)type);
+            return STATUS_ERROR_INVALID_PARAM;
+    }
+#undef SELECT_SCALE
+    
+    return STATUS_OK;
+}
+
+int gcc_weight_is_symmetric(const gcc_weight_t* weight)
+{
+    return weight->symmetric;
+}
+
+void gcc_weight_cache_reset(gcc_weight_cache_t* cache)
+{
+    memset(cache->primed, 0, sizeof(cache->primed));
+}
+
+void gcc_weight_apply_channel(const gcc_weight_t* weight, gcc_weight_cache_t* cache,
+                              int channel, const complex_t* x, complex_t* w,
+                              int first_bin, int num_bins)
+{
+    float32_t* power = cache->power[channel] + first_bin;
+    x += first_bin;
+    w += first_bin;
+    
+    /* SCOT从第二帧起递归平滑，首帧直接使用瞬时自功率谱 */
+    if (weight->alpha > 0.0f && cache->primed[channel]) {
+        weight->smooth_fn(x, power, weight->alpha, num_bins);
+    } else {
+        weight->power_fn(x, power, 0.0f, num_bins);
+    }
+    cache->primed[channel] = 1;
+    
+    weight->scale_fn(x, power, weight->exponent, w, num_bins);
+}
+
+void gcc_weight_apply(const gcc_weight_t* weight, const complex_t* x,
+                      float32_t* power, complex_t* w, int n)
+{
+    weight->power_fn(x, power, 0.0f, n);
+    weight->scale_fn(x, power, weight->exponent, w, n);
+}
+
+const char* gcc_weighting_name(gcc_weighting_t type)
+{
+    switch (type) {
+        case GCC_WEIGHT_PHAT:       return "PHAT";
+        case GCC_WEIGHT_PHAT_BETA:  return "PHAT-beta";
+        case GCC_WEIGHT_SCOT:       return "SCOT";
+        case GCC_WEIGHT_ROTH:       return "ROTH";
+        default:                    return "Unknown";
+    }
+}
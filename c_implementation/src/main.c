@@ -11,6 +11,9 @@
  * 4. GCC-PHAT计算
  * 5. SRP-Map投影
  * 6. 保存所有中间结果
+ * 
+ * 以 --bench 参数运行时只执行性能基准测试 (见benchmark.c)
+ * 以 --fixed 参数运行时只生成定点处理链的精度报告 (见fixed_point.c)
  */
 
 #include <stdio.h>
@@ -24,7 +27,10 @@
 #include "fft.h"
 #include "gcc_phat.h"
 #include "srp_map.h"
+#include "srp_ico.h"
 #include "test_data.h"
+#include "benchmark.h"
+#include "fixed_point.h"
 
 /*============================================================================
  * 输出文件路径
@@ -35,6 +41,7 @@
 #define GCC_FILE                OUTPUT_DIR "/gcc_result.bin"
 #define SRP_FILE                OUTPUT_DIR "/srp_result.bin"
 #define TAU_TABLE_FILE          OUTPUT_DIR "/tau_table.bin"
+#define SRP_ICO_FILE            OUTPUT_DIR "/srp_ico_map.bin"
 #define AUDIO_TEXT_FILE         OUTPUT_DIR "/audio_data.txt"
 #define FFT_TEXT_FILE           OUTPUT_DIR "/fft_result.txt"
 #define GCC_TEXT_FILE           OUTPUT_DIR "/gcc_result.txt"
@@ -61,6 +68,16 @@ int main(int argc, char* argv[])
     print_banner();
     print_config();
     
+    /* 基准测试模式 */
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return (benchmark_run_all() == STATUS_OK) ? 0 : -1;
+    }
+    
+    /* 定点精度报告模式: 以output目录中的浮点结果为参考 */
+    if (argc > 1 && strcmp(argv[1], "--fixed") == 0) {
+        return (fixed_point_accuracy_report(OUTPUT_DIR) == STATUS_OK) ? 0 : -1;
+    }
+    
     /* 创建输出目录 */
     status = create_output_dir();
     if (status != STATUS_OK) {
@@ -89,10 +106,26 @@ int main(int argc, char* argv[])
         return -1;
     }
     
+    /* GCC频带: 频带外的频点不参与加权与互功率谱计算 */
+    status = gcc_phat_set_band(GCC_BAND_LOW_HZ, GCC_BAND_HIGH_HZ);
+    if (status != STATUS_OK) {
+        gcc_phat_cleanup();
+        fft_cleanup();
+        return -1;
+    }
+    
     /* 生成麦克风位置并初始化SRP模块 */
     mic_position_t mic_positions[NUM_CHANNELS];
     test_data_generate_mic_positions(mic_positions, 0.05f);  /* 5cm半径 */
     
+    /* 麦克风对子集: GCC_MAX_PAIRS为0时启用全部对 */
+    status = gcc_phat_select_pairs(GCC_PAIRS_GREEDY, mic_positions, GCC_MAX_PAIRS);
+    if (status != STATUS_OK) {
+        gcc_phat_cleanup();
+        fft_cleanup();
+        return -1;
+    }
+    
     status = srp_map_init(mic_positions);
     if (status != STATUS_OK) {
         printf("[ERROR] SRP-Map initialization failed\n");
@@ -101,6 +134,15 @@ int main(int argc, char* argv[])
         return -1;
     }
     
+    /* 逐帧处理的SRP路径: 按代价模型在融合查表与频域引擎之间选择 */
+    status = srp_map_set_engine(SRP_ENGINE_AUTO);
+    if (status != STATUS_OK) {
+        srp_map_cleanup();
+        gcc_phat_cleanup();
+        fft_cleanup();
+        return -1;
+    }
+    
     end_time = clock();
     print_processing_time("Initialization", start_time, end_time);
     
@@ -152,10 +194,14 @@ int main(int argc, char* argv[])
     /* 分配结果内存 */
     audio_frame_t* frame = (audio_frame_t*)malloc(sizeof(audio_frame_t));
     fft_result_t* fft_result = (fft_result_t*)malloc(sizeof(fft_result_t));
-    gcc_result_t* gcc_result = (gcc_result_t*)malloc(sizeof(gcc_result_t));
+    gcc_result_t* gcc_result = (gcc_result_t*)calloc(1, sizeof(gcc_result_t));    /* 停用对的行保持为0 */
     srp_map_t* srp_result = (srp_map_t*)malloc(sizeof(srp_map_t));
+    float32_t* ico_map = (float32_t*)malloc(SRP_ICO_POINTS(SRP_ICO_RESOLUTION) * sizeof(float32_t));
+    srp_ico_plan_t* ico_plan = NULL;
+    srp_ico_search_t* ico_search = NULL;
+    int ico_argmax = 0;
     
-    if (!frame || !fft_result || !gcc_result || !srp_result) {
+    if (!frame || !fft_result || !gcc_result || !srp_result || !ico_map) {
         printf("[ERROR] Memory allocation failed for results\n");
         test_data_free_audio(audio_data, NUM_CHANNELS);
         srp_map_cleanup();
@@ -189,7 +235,7 @@ int main(int argc, char* argv[])
     
     end_time = clock();
     print_processing_time("Windowing", start_time, end_time);
-    
+
 #if DEBUG_PRINT
     audio_print_frame_info(frame);
 #endif
@@ -206,7 +252,7 @@ int main(int argc, char* argv[])
     
     end_time = clock();
     print_processing_time("FFT", start_time, end_time);
-    
+
 #if DEBUG_PRINT
     fft_print_result(fft_result, 0, 10);  /* 打印通道0的前10个频点 */
 #endif
@@ -228,7 +274,7 @@ int main(int argc, char* argv[])
     
     end_time = clock();
     print_processing_time("GCC-PHAT", start_time, end_time);
-    
+
 #if DEBUG_PRINT
     gcc_phat_print_result(gcc_result, 0, 20);  /* 打印第一对麦克风的结果 */
 #endif
@@ -250,7 +296,7 @@ int main(int argc, char* argv[])
     
     end_time = clock();
     print_processing_time("SRP-Map", start_time, end_time);
-    
+
 #if DEBUG_PRINT
     srp_map_print_result(srp_result);
 #endif
@@ -261,6 +307,77 @@ int main(int argc, char* argv[])
     srp_map_save_tau_table(TAU_TABLE_FILE);
 #endif
     
+    /* 3.6 二十面体SRP图 (icoCNN输入布局) */
+    printf("\n--- 3.6 Icosahedral SRP Map ---\n");
+    start_time = clock();
+    
+    ico_plan = srp_ico_plan_create(SRP_ICO_RESOLUTION, mic_positions);
+    if (ico_plan == NULL) {
+        printf("[ERROR] Icosahedral SRP plan failed\n");
+        status = STATUS_ERROR_MEMORY_ALLOC;
+        goto cleanup;
+    }
+    
+    status = srp_ico_map_compute(ico_plan, gcc_result, ico_map);
+    if (status != STATUS_OK) {
+        printf("[ERROR] Icosahedral SRP map failed\n");
+        goto cleanup;
+    }
+    
+    end_time = clock();
+    print_processing_time("Icosahedral SRP", start_time, end_time);
+    
+    {
+        int width = SRP_ICO_WIDTH(SRP_ICO_RESOLUTION);
+        int height = SRP_ICO_HEIGHT(SRP_ICO_RESOLUTION);
+        for (int g = 1; g < SRP_ICO_POINTS(SRP_ICO_RESOLUTION); g++) {
+            if (ico_map[g] > ico_map[ico_argmax]) {
+                ico_argmax = g;
+            }
+        }
+        printf("[INFO] Icosahedral peak: chart %d, h %d, w %d\n",
+               ico_argmax / (height * width), (ico_argmax / width) % height, ico_argmax % width);
+    }
+
+#if SAVE_INTERMEDIATE
+    srp_ico_save_map(SRP_ICO_FILE, ico_plan, ico_map);
+#endif
+    
+    /* 3.7 层次峰值搜索 (只需要声源方向时代替整张图，结果是近似的) */
+    printf("\n--- 3.7 Hierarchical DOA Search ---\n");
+
+#if SRP_ICO_RESOLUTION < SRP_ICO_SEARCH_MIN_RES
+    printf("[INFO] Skipped: r=%d grid has only %d points, the exhaustive map above is cheaper (search needs r >= %d)\n",
+           SRP_ICO_RESOLUTION, SRP_ICO_POINTS(SRP_ICO_RESOLUTION), SRP_ICO_SEARCH_MIN_RES);
+#else
+    ico_search = srp_ico_search_create(SRP_ICO_RESOLUTION, SRP_ICO_SEARCH_TOP_K, mic_positions);
+    if (ico_search == NULL) {
+        printf("[ERROR] Hierarchical search creation failed\n");
+        status = STATUS_ERROR_MEMORY_ALLOC;
+        goto cleanup;
+    }
+    
+    start_time = clock();
+    
+    srp_ico_peak_t ico_peak;
+    status = srp_ico_search_run(ico_search, gcc_result, &ico_peak);
+    if (status != STATUS_OK) {
+        printf("[ERROR] Hierarchical search failed\n");
+        goto cleanup;
+    }
+    
+    end_time = clock();
+    print_processing_time("Hierarchical search", start_time, end_time);
+    
+    printf("[INFO] Hierarchical peak: chart %d, h %d, w %d, direction (%.3f, %.3f, %.3f)\n",
+           ico_peak.chart, ico_peak.h, ico_peak.w,
+           ico_peak.direction[0], ico_peak.direction[1], ico_peak.direction[2]);
+    printf("[INFO] Evaluated %d of %d grid points, %.4f of the exhaustive peak\n",
+           ico_peak.evaluated, SRP_ICO_POINTS(SRP_ICO_RESOLUTION), ico_map[ico_peak.index]);
+    printf("[INFO] The search is approximate: %s the exhaustive argmax (grid point %d)\n",
+           (ico_peak.index == ico_argmax) ? "same point as" : "differs from", ico_argmax);
+#endif
+    
     /*========================================================================
      * 步骤4: 保存文本格式结果（便于查看）
      *========================================================================*/
@@ -278,6 +395,9 @@ int main(int argc, char* argv[])
      *========================================================================*/
     printf("\n========== Step 5: Process All Frames ==========\n");
     
+    /* SRP只读取孔径范围内的时延: 逐对计算该窗口并立即累加到SRP网格 */
+    printf("[INFO] Fused GCC-SRP: +/-%d lags per pair\n", srp_map_get_aperture_tau());
+    
     start_time = clock();
     
     int processed_frames = 0;
@@ -292,11 +412,11 @@ int main(int argc, char* argv[])
         /* FFT */
         fft_execute_real(frame, fft_result);
         
-        /* GCC-PHAT */
-        gcc_phat_compute_all(fft_result, gcc_result);
+        /* 频域加权 (原位，只处理GCC频带内的频点) */
+        gcc_phat_weight_spectrum(fft_result, fft_result);
         
-        /* SRP-Map */
-        srp_map_compute(gcc_result, srp_result);
+        /* GCC-PHAT + SRP-Map (融合查表或频域引擎) */
+        srp_map_compute_spectrum(fft_result, srp_result);
         
         processed_frames++;
         
@@ -331,15 +451,19 @@ int main(int argc, char* argv[])
     printf("  GCC result: %s\n", GCC_FILE);
     printf("  SRP result: %s\n", SRP_FILE);
     printf("  Tau table:  %s\n", TAU_TABLE_FILE);
+    printf("  Ico map:    %s\n", SRP_ICO_FILE);
     
     status = STATUS_OK;
-    
+
 cleanup:
     /* 释放内存 */
     free(frame);
     free(fft_result);
     free(gcc_result);
     free(srp_result);
+    free(ico_map);
+    srp_ico_plan_destroy(ico_plan);
+    srp_ico_search_destroy(ico_search);
     test_data_free_audio(audio_data, NUM_CHANNELS);
     
     /* 清理模块 */
@@ -378,8 +502,18 @@ static void print_config(void)
     printf("  FFT Size:        %d\n", FFT_SIZE);
     printf("  FFT Bins:        %d\n", FFT_BINS);
     printf("  Mic Pairs:       %d\n", NUM_MIC_PAIRS);
+    if (GCC_MAX_PAIRS > 0) {
+        printf("  Active Pairs:    <= %d (greedy)\n", GCC_MAX_PAIRS);
+    }
+    printf("  GCC Band:        %.0f - %.0f Hz\n", GCC_BAND_LOW_HZ,
+           (GCC_BAND_HIGH_HZ > 0.0f) ? GCC_BAND_HIGH_HZ : SAMPLE_RATE / 2.0f);
     printf("  SRP Grid:        %d x %d x %d\n", 
            SRP_ELEVATION_BINS, SRP_AZIMUTH_BINS, SRP_RANGE_BINS);
+    printf("  SRP Mode:        %s\n", SRP_FAR_FIELD ? "far field (direction only)" : "near field");
+    printf("  Ico Grid:        r=%d, %d x %d x %d\n", SRP_ICO_RESOLUTION,
+           SRP_ICO_CHARTS, SRP_ICO_HEIGHT(SRP_ICO_RESOLUTION), SRP_ICO_WIDTH(SRP_ICO_RESOLUTION));
+    printf("  Ico Search:      top-%d per level (demo for r >= %d)\n",
+           SRP_ICO_SEARCH_TOP_K, SRP_ICO_SEARCH_MIN_RES);
     printf("\n");
 }
 
@@ -0,0 +1,464 @@
+/**
+ * @file srp_freq.c
+ * @brief 频域SRP引擎实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 导向矩阵按网格点行优先存放，行内按 [pair][bin] 交织 (cos, -sin)，与打包后的
+ * 互功率谱 (re, im) * s_k / N 逐元素对应，每个网格点的SRP即两者的点积。
+ * 多帧时为 C = B * A^T (B: 帧数 x D)，按SRP_FREQ_BLOCK个float沿D分块:
+ * 块内4行导向矩阵与2帧互功率谱常驻L1，微内核一次产生4x2个部分和。
+ * 导向向量按麦克风对与网格点用双精度复数递推 e^(j*w*(k+1)) = e^(j*w*k) * e^(j*w) 生成。
+ * 计划创建时记录启用的麦克风对，导向矩阵与互功率谱只包含这些对。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "srp_freq.h"
+#include "gcc_phat.h"
+#include "fft.h"
+#include "fft_lags.h"
+#include "fft_simd.h"
+
+/*============================================================================
+ * 分块与代价模型参数
+ * 
+ * 开销单位与fft_lags相同 (一次标量乘加)，数值由benchmark实测标定。
+ *============================================================================*/
+#define SRP_FREQ_BLOCK          4096        /* D方向分块长度 (float, 8的倍数) */
+#define SRP_FREQ_MAX_FRAMES     8           /* 每次打包的最大帧数 */
+#define SRP_FREQ_CACHE_BYTES    (1 << 20)   /* 导向矩阵可视为常驻缓存的大小 */
+
+#define SRP_COST_GEMM           0.5f        /* 导向矩阵乘法: 每个乘加 (标量) */
+#define SRP_COST_GEMM_AVX2      0.25f       /* 导向矩阵乘法: 每个乘加 (AVX2) */
+#define SRP_COST_STREAM         0.2f        /* 导向矩阵超出缓存: 每个float每次读取 */
+#define SRP_COST_PACK           3.0f        /* 互功率谱: 每对每个频点 */
+#define SRP_COST_GATHER         1.0f        /* 查表累加: 每对每个网格点 */
+
+/*============================================================================
+ * 计划结构
+ *============================================================================*/
+typedef void (*srp_tile_kernel_t)(const float32_t* a, size_t a_stride,
+                                  const float32_t* b, size_t b_stride,
+                                  int len, float32_t* sums);
+typedef float32_t (*srp_dot_kernel_t)(const float32_t* a, const float32_t* b, int len);
+
+struct srp_freq_plan {
+    int num_points;
+    int bin_lo;
+    int bin_hi;
+    int num_bins;                   /* 频带内频点数 */
+    int dim;                        /* 导向向量长度 D (补齐到8的倍数) */
+    int num_pairs;                  /* 启用的麦克风对数 */
+    int pairs[NUM_MIC_PAIRS];       /* 启用的麦克风对索引 */
+    float32_t* mask;                /* 创建时频带内的频点权重 (num_bins个)，无掩码时为NULL */
+    float32_t* steer;               /* 导向矩阵 (num_points x dim) */
+    float32_t* cross;               /* 打包的互功率谱 (SRP_FREQ_MAX_FRAMES x dim) */
+    srp_tile_kernel_t tile_fn;      /* 4x2微内核 */
+    srp_dot_kernel_t dot_fn;        /* 边缘的单点积 */
+};
+
+/*============================================================================
+ * 微内核
+ *============================================================================*/
+
+/**
+ * @brief 4行导向矩阵与2帧互功率谱的点积 (sums[2 * r + f])
+ */
+static void tile_4x2_scalar(const float32_t* a, size_t a_stride,
+                            const float32_t* b, size_t b_stride,
+                            int len, float32_t* sums)
+{
+    const float32_t* a0 = a;
+    const float32_t* a1 = a + a_stride;
+    const float32_t* a2 = a + 2 * a_stride;
+    const float32_t* a3 = a + 3 * a_stride;
+    const float32_t* b0 = b;
+    const float32_t* b1 = b + b_stride;
+    float32_t s00 = 0.0f, s01 = 0.0f, s10 = 0.0f, s11 = 0.0f;
+    float32_t s20 = 0.0f, s21 = 0.0f, s30 = 0.0f, s31 = 0.0f;
+    
+    for (int i = 0; i < len; i++) {
+        float32_t x0 = b0[i], x1 = b1[i];
+        s00 += a0[i] * x0;  s01 += a0[i] * x1;
+        s10 += a1[i] * x0;  s11 += a1[i] * x1;
+        s20 += a2[i] * x0;  s21 += a2[i] * x1;
+        s30 += a3[i] * x0;  s31 += a3[i] * x1;
+    }
+    
+    sums[0] = s00;  sums[1] = s01;
+    sums[2] = s10;  sums[3] = s11;
+    sums[4] = s20;  sums[5] = s21;
+    sums[6] = s30;  sums[7] = s31;
+}
+
+static float32_t dot_scalar(const float32_t* a, const float32_t* b, int len)
+{
+    float32_t sum = 0.0f;
+    for (int i = 0; i < len; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+#if FFT_SIMD_X86
+FFT_TARGET_AVX2
+static float32_t hsum_avx2(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+/**
+ * @brief AVX2 4x2微内核 (len为8的倍数)
+ */
+FFT_TARGET_AVX2
+static void tile_4x2_avx2(const float32_t* a, size_t a_stride,
+                          const float32_t* b, size_t b_stride,
+                          int len, float32_t* sums)
+{
+    const float32_t* b1 = b + b_stride;
+    __m256 acc[8];
+    for (int i = 0; i < 8; i++) {
+        acc[i] = _mm256_setzero_ps();
+    }
+    
+    for (int i = 0; i < len; i += 8) {
+        __m256 x0 = _mm256_loadu_ps(b + i);
+        __m256 x1 = _mm256_loadu_ps(b1 + i);
+        for (int r = 0; r < 4; r++) {
+            __m256 row = _mm256_loadu_ps(a + r * a_stride + i);
+            acc[2 * r] = _mm256_fmadd_ps(row, x0, acc[2 * r]);
+            acc[2 * r + 1] = _mm256_fmadd_ps(row, x1, acc[2 * r + 1]);
+        }
+    }
+    
+    for (int i = 0; i < 8; i++) {
+        sums[i] = hsum_avx2(acc[i]);
+    }
+}
+
+FFT_TARGET_AVX2
+static float32_t dot_avx2(const float32_t* a, const float32_t* b, int len)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int i = 0;
+    
+    for (; i + 16 <= len; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i < len; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    
+    return hsum_avx2(_mm256_add_ps(acc0, acc1));
+}
+#endif
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+static size_t steer_bytes(int num_points, int dim)
+{
+    return (size_t)num_points * dim * sizeof(float32_t);
+}
+
+static int steer_dim(int bin_lo, int bin_hi, int num_pairs)
+{
+    int dim = 2 * (bin_hi - bin_lo + 1) * num_pairs;
+    return (dim + 7) & ~7;
+}
+
+/**
+ * @brief 生成一个麦克风对在一个网格点的导向向量 (cos, -sin)(2*pi*k*tau/N)
+ */
+static void fill_steering(float32_t* row, float64_t tau, int bin_lo, int num_bins)
+{
+    float64_t w = 2.0 * 3.14159265358979323846 * tau / FFT_SIZE;
+    float64_t cr = cos(w * bin_lo), ci = sin(w * bin_lo);
+    float64_t sr = cos(w), si = sin(w);
+    
+    for (int k = 0; k < num_bins; k++) {
+        row[2 * k] = (float32_t)cr;
+        row[2 * k + 1] = (float32_t)-ci;
+        float64_t t = cr * sr - ci * si;
+        ci = cr * si + ci * sr;
+        cr = t;
+    }
+}
+
+/**
+ * @brief 打包一帧的互功率谱: (re, im) * s_k / N，按 [pair][bin] 排列
+ */
+static void pack_cross(const srp_freq_plan_t* plan, const fft_result_t* whitened, float32_t* out)
+{
+    int lo = plan->bin_lo;
+    int num_bins = plan->num_bins;
+    float32_t scale = 2.0f / FFT_SIZE;
+    
+    for (int i = 0; i < plan->num_pairs; i++) {
+        int mic1, mic2;
+        gcc_phat_get_mic_pair(plan->pairs[i], &mic1, &mic2);
+        const float32_t* w1 = (const float32_t*)(whitened->data[mic1] + lo);
+        const float32_t* w2 = (const float32_t*)(whitened->data[mic2] + lo);
+        float32_t* row = out + (size_t)i * 2 * num_bins;
+        
+        for (int i = 0; i < 2 * num_bins; i += 2) {
+            float32_t ar = w1[i], ai = w1[i + 1];
+            float32_t br = w2[i], bi = w2[i + 1];
+            row[i] = (ar * br + ai * bi) * scale;
+            row[i + 1] = (ai * br - ar * bi) * scale;
+        }
+        
+        /* 与GCC路径相同的逐频点权重 (gcc_phat_set_band_mask) */
+        if (plan->mask != NULL) {
+            for (int k = 0; k < num_bins; k++) {
+                row[2 * k] *= plan->mask[k];
+                row[2 * k + 1] *= plan->mask[k];
+            }
+        }
+        
+        /* DC与Nyquist没有共轭镜像，权重减半 */
+        if (lo == 0) {
+            row[0] *= 0.5f;
+            row[1] *= 0.5f;
+        }
+        if (plan->bin_hi == FFT_SIZE / 2) {
+            row[2 * num_bins - 2] *= 0.5f;
+            row[2 * num_bins - 1] *= 0.5f;
+        }
+    }
+}
+
+/**
+ * @brief 分块SGEMM: out[f][g] = sum_d steer[g][d] * cross[f][d]
+ */
+static void gemm_frames(const srp_freq_plan_t* plan, int num_frames, float32_t* out, int out_stride)
+{
+    int num_points = plan->num_points;
+    size_t dim = (size_t)plan->dim;
+    float32_t sums[8];
+    
+    for (int f = 0; f < num_frames; f++) {
+        memset(out + (size_t)f * out_stride, 0, num_points * sizeof(float32_t));
+    }
+    
+    for (size_t d0 = 0; d0 < dim; d0 += SRP_FREQ_BLOCK) {
+        int len = (int)((dim - d0 < SRP_FREQ_BLOCK) ? dim - d0 : SRP_FREQ_BLOCK);
+        
+        for (int g = 0; g < num_points; g += 4) {
+            const float32_t* a = plan->steer + (size_t)g * dim + d0;
+            int rows = (num_points - g < 4) ? num_points - g : 4;
+            
+            for (int f = 0; f < num_frames; f += 2) {
+                const float32_t* b = plan->cross + (size_t)f * dim + d0;
+                float32_t* c = out + (size_t)f * out_stride + g;
+                
+                if (rows == 4 && f + 1 < num_frames) {
+                    plan->tile_fn(a, dim, b, dim, len, sums);
+                    for (int r = 0; r < 4; r++) {
+                        c[r] += sums[2 * r];
+                        c[out_stride + r] += sums[2 * r + 1];
+                    }
+                    continue;
+                }
+                
+                /* 边缘: 不足4个网格点或只剩1帧 */
+                int frames = (f + 1 < num_frames) ? 2 : 1;
+                for (int j = 0; j < frames; j++) {
+                    for (int r = 0; r < rows; r++) {
+                        c[(size_t)j * out_stride + r] += plan->dot_fn(a + r * dim, b + j * dim, len);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * 函数实现
+ *============================================================================*/
+
+const char* srp_engine_name(srp_engine_t engine)
+{
+    switch (engine) {
+        case SRP_ENGINE_AUTO:   return "auto";
+        case SRP_ENGINE_LOOKUP: return "GCC lookup";
+        case SRP_ENGINE_FREQ:   return "frequency-domain";
+        default:                return "unknown";
+    }
+}
+
+srp_engine_t srp_freq_choose_engine(int num_points, int bin_lo, int bin_hi, int max_lag, int num_frames)
+{
+    int num_bins = bin_hi - bin_lo + 1;
+    int num_pairs = gcc_phat_get_active_pairs(NULL);
+    int dim = steer_dim(bin_lo, bin_hi, num_pairs);
+    size_t bytes = steer_bytes(num_points, dim);
+    
+    if (num_points <= 0 || num_bins <= 0 || bytes > ((size_t)SRP_FREQ_MAX_STEER_MB << 20)) {
+        return SRP_ENGINE_LOOKUP;
+    }
+    if (num_frames < 1) {
+        num_frames = 1;
+    }
+    
+    /* 两条路径都要形成各对的互功率谱 */
+    float32_t pack = SRP_COST_PACK * (float32_t)num_pairs * num_bins;
+    
+    float32_t lookup = pack + (float32_t)num_pairs *
+                       (fft_lags_estimate_cost(FFT_SIZE, max_lag) + SRP_COST_GATHER * num_points);
+    
+    float32_t unit = (fft_simd_best_engine() == FFT_ENGINE_AVX2) ? SRP_COST_GEMM_AVX2 : SRP_COST_GEMM;
+    if (bytes > SRP_FREQ_CACHE_BYTES) {
+        unit += SRP_COST_STREAM / num_frames;
+    }
+    float32_t freq = pack + unit * (float32_t)num_points * dim;
+    
+    return (freq < lookup) ? SRP_ENGINE_FREQ : SRP_ENGINE_LOOKUP;
+}
+
+srp_freq_plan_t* srp_freq_plan_create(const float32_t* tau, int num_points, int bin_lo, int bin_hi)
+{
+    if (tau == NULL || num_points <= 0 || bin_lo < 0 || bin_hi >= FFT_BINS || bin_lo > bin_hi) {
+        return NULL;
+    }
+    
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    int dim = steer_dim(bin_lo, bin_hi, num_pairs);
+    size_t bytes = steer_bytes(num_points, dim);
+    if (bytes > ((size_t)SRP_FREQ_MAX_STEER_MB << 20)) {
+        printf("[ERROR] Steering matrix too large: %.1f MB (limit %d MB)\n",
+               bytes / 1048576.0, SRP_FREQ_MAX_STEER_MB);
+        return NULL;
+    }
+    
+    srp_freq_plan_t* plan = (srp_freq_plan_t*)calloc(1, sizeof(srp_freq_plan_t));
+    if (plan == NULL) {
+        return NULL;
+    }
+    
+    plan->num_points = num_points;
+    plan->bin_lo = bin_lo;
+    plan->bin_hi = bin_hi;
+    plan->num_bins = bin_hi - bin_lo + 1;
+    plan->dim = dim;
+    plan->num_pairs = num_pairs;
+    memcpy(plan->pairs, pairs, num_pairs * sizeof(int));
+    plan->steer = (float32_t*)calloc((size_t)num_points * dim, sizeof(float32_t));
+    plan->cross = (float32_t*)calloc((size_t)SRP_FREQ_MAX_FRAMES * dim, sizeof(float32_t));
+    if (plan->steer == NULL || plan->cross == NULL) {
+        srp_freq_plan_destroy(plan);
+        return NULL;
+    }
+    
+    const float32_t* mask = gcc_phat_get_band_mask();
+    if (mask != NULL) {
+        plan->mask = (float32_t*)malloc(plan->num_bins * sizeof(float32_t));
+        if (plan->mask == NULL) {
+            srp_freq_plan_destroy(plan);
+            return NULL;
+        }
+        memcpy(plan->mask, mask + bin_lo, plan->num_bins * sizeof(float32_t));
+    }
+    
+    plan->tile_fn = tile_4x2_scalar;
+    plan->dot_fn = dot_scalar;
+#if FFT_SIMD_X86
+    if (fft_simd_best_engine() == FFT_ENGINE_AVX2) {
+        plan->tile_fn = tile_4x2_avx2;
+        plan->dot_fn = dot_avx2;
+    }
+#endif
+    
+    for (int g = 0; g < num_points; g++) {
+        float32_t* row = plan->steer + (size_t)g * dim;
+        for (int i = 0; i < num_pairs; i++) {
+            fill_steering(row + (size_t)i * 2 * plan->num_bins,
+                          tau[(size_t)pairs[i] * num_points + g], bin_lo, plan->num_bins);
+        }
+    }
+    
+    if (DEBUG_PRINT) {
+        printf("[INFO] Frequency-domain SRP plan: %d points x %d bins x %d pairs, steering %.1f MB\n",
+               num_points, plan->num_bins, num_pairs, bytes / 1048576.0);
+    }
+    
+    return plan;
+}
+
+void srp_freq_plan_destroy(srp_freq_plan_t* plan)
+{
+    if (plan == NULL) {
+        return;
+    }
+    
+    free(plan->mask);
+    free(plan->steer);
+    free(plan->cross);
+    free(plan);
+}
+
+int srp_freq_plan_num_points(const srp_freq_plan_t* plan)
+{
+    return (plan != NULL) ? plan->num_points : 0;
+}
+
+int srp_freq_plan_is_current(const srp_freq_plan_t* plan)
+{
+    if (plan == NULL) {
+        return 0;
+    }
+    
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    if (plan->num_pairs != num_pairs || memcmp(plan->pairs, pairs, num_pairs * sizeof(int)) != 0) {
+        return 0;
+    }
+    
+    /* 频带外的频点未经加权 (gcc_phat_weight_spectrum只写频带内)，频带变化后必须重建 */
+    int bin_lo, bin_hi;
+    gcc_phat_get_band(&bin_lo, &bin_hi);
+    if (plan->bin_lo != bin_lo || plan->bin_hi != bin_hi) {
+        return 0;
+    }
+    
+    const float32_t* mask = gcc_phat_get_band_mask();
+    if ((mask == NULL) != (plan->mask == NULL)) {
+        return 0;
+    }
+    return mask == NULL ||
+           memcmp(plan->mask, mask + bin_lo, plan->num_bins * sizeof(float32_t)) == 0;
+}
+
+status_t srp_freq_compute(srp_freq_plan_t* plan, const fft_result_t* whitened, float32_t* srp_out)
+{
+    return srp_freq_compute_batch(plan, whitened, 1, srp_out);
+}
+
+status_t srp_freq_compute_batch(srp_freq_plan_t* plan, const fft_result_t* whitened,
+                                int num_frames, float32_t* srp_out)
+{
+    if (plan == NULL || whitened == NULL || srp_out == NULL || num_frames < 1) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    for (int f0 = 0; f0 < num_frames; f0 += SRP_FREQ_MAX_FRAMES) {
+        int frames = (num_frames - f0 < SRP_FREQ_MAX_FRAMES) ? num_frames - f0 : SRP_FREQ_MAX_FRAMES;
+        
+        for (int f = 0; f < frames; f++) {
+            pack_cross(plan, &whitened[f0 + f], plan->cross + (size_t)f * plan->dim);
+        }
+        gemm_frames(plan, frames, srp_out + (size_t)f0 * plan->num_points, plan->num_points);
+    }
+    
+    return STATUS_OK;
+}
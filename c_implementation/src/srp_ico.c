@@ -0,0 +1,890 @@
+/**
+ * @file srp_ico.c
+ * @brief 二十面体SRP-Map模块实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 网格生成按icoCNN/icoGrid.py逐步移植 (双精度):
+ * 平面顶点 vp[n] = 2^r * (-1/2 + n/2, ((n+1) % 2) * sin(pi/3), 0)，n = 0..5；
+ * 球面顶点 vi 为北极、两个上纬圈顶点、两个下纬圈顶点与南极，每个图表绕z轴旋转72度。
+ * 第f个面 (f = 0..3) 把平面三角形 vp[f..f+2] 仿射映射到 vi[f..f+2]。
+ * 
+ * 按网格点排列时，每帧先把启用的对的孔径窗口 [-max_lag, max_lag] 复制到紧凑GCC
+ * (第i个启用的对占 [i * width, (i + 1) * width)，末尾一个0作为补齐项的目标)，
+ * 再逐网格点按int16偏移求和。AVX2内核一次处理4个网格点，每8个偏移符号扩展为int32后gather。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "srp_ico.h"
+#include "gcc_phat.h"
+#include "fft_simd.h"
+#include "tau_cache.h"
+
+#define ICO_PI                  3.14159265358979323846
+#define ICO_GATHER_LANES        8       /* 每个网格点的偏移数补齐到该值的倍数 */
+#define ICO_CHILD_RADIUS        1.5     /* 子节点半径 (细一层的网格间距的倍数) */
+
+/*============================================================================
+ * 计划结构
+ *============================================================================*/
+typedef void (*srp_ico_gather_kernel_t)(const int16_t* offsets, int stride,
+                                        const float32_t* compact, int num_points, float32_t* out);
+
+struct srp_ico_plan {
+    int r;
+    int num_points;
+    int max_lag;                    /* 全部网格点与麦克风对的最大时延 */
+    const int32_t* tau;             /* 完整GCC索引，按 [pair][point] 排列 (指向tau_owned或缓存映射) */
+    int32_t* tau_owned;             /* 本计划计算的时延表 (缓存命中时为NULL) */
+    tau_cache_view_t* cache;        /* 时延表缓存 (未命中时为NULL) */
+    srp_ico_layout_t layout;
+    
+    /* 按网格点排列的时延表 (layout为SRP_ICO_LAYOUT_GRID_MAJOR时有效) */
+    int num_pairs;                  /* 建表时启用的麦克风对数 */
+    int pairs[NUM_MIC_PAIRS];       /* 建表时启用的麦克风对索引 */
+    int stride;                     /* 每个网格点的偏移数 (num_pairs补齐到8的倍数) */
+    int16_t* offsets;               /* 紧凑GCC偏移，按 [point][stride] 排列 */
+    float32_t* compact;             /* 紧凑GCC工作缓冲区 (num_pairs * width + 1个) */
+    srp_ico_gather_kernel_t gather_fn;
+};
+
+struct srp_ico_search {
+    int r;                                          /* 目标分辨率 */
+    int top_k;                                      /* 每层保留的候选数 */
+    srp_ico_plan_t* plans[SRP_ICO_MAX_RESOLUTION + 1];  /* 第1..r层的计划 (只用按对排列的时延表) */
+    int* child_start[SRP_ICO_MAX_RESOLUTION];       /* 第l层网格点的子节点范围 (num_points + 1个) */
+    int* child_index[SRP_ICO_MAX_RESOLUTION];       /* 第l + 1层的网格点索引 */
+    float32_t* direction;                           /* 目标层网格点的单位方向，[point][3] */
+    int* candidates;                                /* 当前层待计算的网格点 */
+    float32_t* power;                               /* 候选网格点的GCC和 */
+    unsigned char* mark;                            /* 子节点去重标记 (目标层网格点数) */
+};
+
+/*============================================================================
+ * gather累加内核
+ *============================================================================*/
+
+static void gather_scalar(const int16_t* offsets, int stride,
+                          const float32_t* compact, int num_points, float32_t* out)
+{
+    for (int g = 0; g < num_points; g++) {
+        const int16_t* row = offsets + (size_t)g * stride;
+        float32_t sum = 0.0f;
+        for (int i = 0; i < stride; i++) {
+            sum += compact[row[i]];
+        }
+        out[g] = sum;
+    }
+}
+
+#if FFT_SIMD_X86
+FFT_TARGET_AVX2
+static inline __m256 gather8_avx2(const float32_t* compact, const int16_t* offsets)
+{
+    __m256i idx = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)offsets));
+    return _mm256_i32gather_ps(compact, idx, 4);
+}
+
+/**
+ * @brief AVX2 gather累加 (stride为8的倍数)，4个网格点的累加器交错以隐藏gather延迟
+ */
+FFT_TARGET_AVX2
+static void gather_avx2(const int16_t* offsets, int stride,
+                        const float32_t* compact, int num_points, float32_t* out)
+{
+    int g = 0;
+    
+    for (; g + 4 <= num_points; g += 4) {
+        const int16_t* row = offsets + (size_t)g * stride;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        
+        for (int i = 0; i < stride; i += 8) {
+            acc0 = _mm256_add_ps(acc0, gather8_avx2(compact, row + i));
+            acc1 = _mm256_add_ps(acc1, gather8_avx2(compact, row + stride + i));
+            acc2 = _mm256_add_ps(acc2, gather8_avx2(compact, row + 2 * stride + i));
+            acc3 = _mm256_add_ps(acc3, gather8_avx2(compact, row + 3 * stride + i));
+        }
+        
+        /* 4个累加器的水平和: 两级hadd后高低128位相加得到 (sum0, sum1, sum2, sum3) */
+        __m256 s = _mm256_hadd_ps(_mm256_hadd_ps(acc0, acc1), _mm256_hadd_ps(acc2, acc3));
+        _mm_storeu_ps(out + g, _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1)));
+    }
+    
+    for (; g < num_points; g++) {
+        const int16_t* row = offsets + (size_t)g * stride;
+        __m256 acc = _mm256_setzero_ps();
+        for (int i = 0; i < stride; i += 8) {
+            acc = _mm256_add_ps(acc, gather8_avx2(compact, row + i));
+        }
+        __m128 v = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+        out[g] = _mm_cvtss_f32(v);
+    }
+}
+#endif
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+static void sph2car(float64_t el, float64_t az, float64_t v[3])
+{
+    v[0] = cos(az) * sin(el);
+    v[1] = sin(az) * sin(el);
+    v[2] = cos(el);
+}
+
+static void cross3(const float64_t a[3], const float64_t b[3], float64_t c[3])
+{
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/**
+ * @brief 3x3矩阵求逆 (伴随矩阵法)
+ */
+static void invert3(const float64_t m[3][3], float64_t inv[3][3])
+{
+    inv[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    inv[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    inv[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    inv[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    inv[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    inv[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    inv[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    inv[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    inv[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    
+    float64_t det = m[0][0] * inv[0][0] + m[0][1] * inv[1][0] + m[0][2] * inv[2][0];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            inv[i][j] /= det;
+        }
+    }
+}
+
+/**
+ * @brief 把三角形p映射到三角形q的仿射变换: v -> m * (v - p[0]) + q[0]
+ * 
+ * m = Q * P^-1，P、Q的列为两条边及其叉积 (与icoGrid._get_affine_transform相同)。
+ */
+static void affine_transform(const float64_t p[3][3], const float64_t q[3][3], float64_t m[3][3])
+{
+    float64_t pm[3][3], qm[3][3], pinv[3][3];
+    float64_t pe[3][3], qe[3][3];
+    
+    for (int i = 0; i < 3; i++) {
+        pe[0][i] = p[1][i] - p[0][i];
+        pe[1][i] = p[2][i] - p[0][i];
+        qe[0][i] = q[1][i] - q[0][i];
+        qe[1][i] = q[2][i] - q[0][i];
+    }
+    cross3(pe[0], pe[1], pe[2]);
+    cross3(qe[0], qe[1], qe[2]);
+    
+    /* 列向量组成矩阵 */
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            pm[i][j] = pe[j][i];
+            qm[i][j] = qe[j][i];
+        }
+    }
+    invert3(pm, pinv);
+    
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m[i][j] = qm[i][0] * pinv[0][j] + qm[i][1] * pinv[1][j] + qm[i][2] * pinv[2][j];
+        }
+    }
+}
+
+/**
+ * @brief 生成网格坐标 (双精度)，按 [5][H][W][3] 排列
+ */
+static void build_grid(int r, float64_t* xyz)
+{
+    int height = SRP_ICO_HEIGHT(r);
+    int width = SRP_ICO_WIDTH(r);
+    float64_t s60 = sin(ICO_PI / 3.0);
+    float64_t c60 = cos(ICO_PI / 3.0);
+    float64_t lat = atan(0.5);
+    
+    /* 平面三角形顶点 */
+    float64_t vp[6][3];
+    for (int n = 0; n < 6; n++) {
+        vp[n][0] = height * (-0.5 + n / 2.0);
+        vp[n][1] = height * ((n + 1) % 2) * s60;
+        vp[n][2] = 0.0;
+    }
+    
+    /* 第一个图表的球面顶点 */
+    float64_t vi[6][3];
+    sph2car(0.0, 0.0, vi[0]);
+    sph2car(ICO_PI / 2 - lat, 0.0, vi[1]);
+    sph2car(ICO_PI / 2 - lat, 2 * 2 * ICO_PI / 10, vi[2]);
+    sph2car(ICO_PI / 2 + lat, 1 * 2 * ICO_PI / 10, vi[3]);
+    sph2car(ICO_PI / 2 + lat, 3 * 2 * ICO_PI / 10, vi[4]);
+    sph2car(ICO_PI, 0.0, vi[5]);
+    
+    float64_t rc = cos(2 * ICO_PI / 5), rs = sin(2 * ICO_PI / 5);
+    
+    for (int c = 0; c < SRP_ICO_CHARTS; c++) {
+        float64_t m[4][3][3];
+        for (int f = 0; f < 4; f++) {
+            affine_transform((const float64_t(*)[3])(vp + f), (const float64_t(*)[3])(vi + f), m[f]);
+        }
+        
+        for (int h = 0; h < height; h++) {
+            for (int w = 0; w < width; w++) {
+                /* 图表内的面: 左下、左上、右下、右上 */
+                int f = (w < height && h > w) ? 0 :
+                        (w < height) ? 1 :
+                        (h > w - height) ? 2 : 3;
+                const float64_t* p0 = vp[f];
+                const float64_t* q0 = vi[f];
+                float64_t d[3] = { w - h * c60 - p0[0], h * s60 - p0[1], -p0[2] };
+                float64_t* out = xyz + 3 * (((size_t)c * height + h) * width + w);
+                
+                for (int i = 0; i < 3; i++) {
+                    out[i] = m[f][i][0] * d[0] + m[f][i][1] * d[1] + m[f][i][2] * d[2] + q0[i];
+                }
+            }
+        }
+        
+        /* 下一个图表: 球面顶点绕z轴旋转72度 */
+        for (int n = 0; n < 6; n++) {
+            float64_t x = vi[n][0], y = vi[n][1];
+            vi[n][0] = x * rc - y * rs;
+            vi[n][1] = x * rs + y * rc;
+        }
+    }
+}
+
+/**
+ * @brief 按当前启用的麦克风对建立按网格点排列的时延表
+ */
+static status_t build_grid_major(srp_ico_plan_t* plan)
+{
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    int width = 2 * plan->max_lag + 1;
+    int stride = (num_pairs + ICO_GATHER_LANES - 1) / ICO_GATHER_LANES * ICO_GATHER_LANES;
+    int zero_slot = num_pairs * width;
+    
+    if (zero_slot > INT16_MAX) {
+        printf("[ERROR] Compact GCC (%d x %d) exceeds int16 offsets\n", num_pairs, width);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int16_t* offsets = (int16_t*)malloc((size_t)plan->num_points * stride * sizeof(int16_t));
+    float32_t* compact = (float32_t*)calloc((size_t)zero_slot + 1, sizeof(float32_t));
+    if (offsets == NULL || compact == NULL) {
+        free(offsets);
+        free(compact);
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    for (int g = 0; g < plan->num_points; g++) {
+        int16_t* row = offsets + (size_t)g * stride;
+        for (int i = 0; i < num_pairs; i++) {
+            int tau = plan->tau[(size_t)pairs[i] * plan->num_points + g] - GCC_LENGTH / 2;
+            row[i] = (int16_t)(i * width + plan->max_lag + tau);
+        }
+        for (int i = num_pairs; i < stride; i++) {
+            row[i] = (int16_t)zero_slot;
+        }
+    }
+    
+    free(plan->offsets);
+    free(plan->compact);
+    plan->offsets = offsets;
+    plan->compact = compact;
+    plan->num_pairs = num_pairs;
+    plan->stride = stride;
+    memcpy(plan->pairs, pairs, num_pairs * sizeof(int));
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 按网格点排列的表是否与当前启用的麦克风对一致
+ */
+static int grid_major_is_current(const srp_ico_plan_t* plan)
+{
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    
+    return plan->offsets != NULL && num_pairs == plan->num_pairs &&
+           memcmp(pairs, plan->pairs, num_pairs * sizeof(int)) == 0;
+}
+
+/**
+ * @brief 启用的麦克风对用到的通道数 (对角项: 每个通道贡献一个零时延自相关)
+ */
+static int count_used_channels(const int* pairs, int num_pairs)
+{
+    int used[NUM_CHANNELS] = { 0 };
+    int num_used = 0;
+    
+    for (int i = 0; i < num_pairs; i++) {
+        int mic1, mic2;
+        gcc_phat_get_mic_pair(pairs[i], &mic1, &mic2);
+        used[mic1] = used[mic2] = 1;
+    }
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        num_used += used[ch];
+    }
+    
+    return num_used;
+}
+
+/**
+ * @brief 建立第l层网格点到第l + 1层子节点的映射
+ * 
+ * 第l层的点 (h, w) 即第l + 1层的 (2h, 2w)，第l + 1层其余的点都是第l层相邻两点的中点。
+ * 子节点取3D距离不超过ICO_CHILD_RADIUS倍细网格间距的点 (自身与六个相邻的中点，
+ * 五度顶点处为五个)，按距离判断可跨越图表边界。
+ */
+static status_t build_children(srp_ico_search_t* search, int l)
+{
+    int coarse_points = SRP_ICO_POINTS(l);
+    int fine_points = SRP_ICO_POINTS(l + 1);
+    float64_t* coarse = (float64_t*)malloc(3 * (size_t)coarse_points * sizeof(float64_t));
+    float64_t* fine = (float64_t*)malloc(3 * (size_t)fine_points * sizeof(float64_t));
+    status_t status = STATUS_ERROR_MEMORY_ALLOC;
+    
+    search->child_start[l] = (int*)malloc(((size_t)coarse_points + 1) * sizeof(int));
+    if (coarse == NULL || fine == NULL || search->child_start[l] == NULL) {
+        goto cleanup;
+    }
+    
+    build_grid(l, coarse);
+    build_grid(l + 1, fine);
+    
+    /* 细网格间距: 图表0第0行相邻两点 (同一面内) */
+    float64_t dx = fine[3] - fine[0], dy = fine[4] - fine[1], dz = fine[5] - fine[2];
+    float64_t radius2 = ICO_CHILD_RADIUS * ICO_CHILD_RADIUS * (dx * dx + dy * dy + dz * dz);
+    
+    /* 两遍: 先计数，再填写 */
+    int* index = NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        int count = 0;
+        for (int g = 0; g < coarse_points; g++) {
+            const float64_t* c = coarse + 3 * (size_t)g;
+            search->child_start[l][g] = count;
+            for (int f = 0; f < fine_points; f++) {
+                const float64_t* v = fine + 3 * (size_t)f;
+                float64_t d0 = v[0] - c[0], d1 = v[1] - c[1], d2 = v[2] - c[2];
+                if (d0 * d0 + d1 * d1 + d2 * d2 <= radius2) {
+                    if (index != NULL) {
+                        index[count] = f;
+                    }
+                    count++;
+                }
+            }
+        }
+        search->child_start[l][coarse_points] = count;
+        
+        if (pass == 0) {
+            index = (int*)malloc((size_t)count * sizeof(int));
+            if (index == NULL) {
+                goto cleanup;
+            }
+            search->child_index[l] = index;
+        }
+    }
+    
+    status = STATUS_OK;
+
+cleanup:
+    free(coarse);
+    free(fine);
+    return status;
+}
+
+/**
+ * @brief 计算候选网格点上启用的麦克风对的GCC和 (逐对读取时延行)
+ */
+static void evaluate_points(const srp_ico_plan_t* plan, const gcc_result_t* gcc_result,
+                            const int* pairs, int num_pairs,
+                            const int* points, int num_candidates, float32_t* power)
+{
+    memset(power, 0, num_candidates * sizeof(float32_t));
+    
+    for (int i = 0; i < num_pairs; i++) {
+        const float32_t* gcc = gcc_result->data[pairs[i]];
+        const int32_t* row = plan->tau + (size_t)pairs[i] * plan->num_points;
+        for (int c = 0; c < num_candidates; c++) {
+            power[c] += gcc[row[points[c]]];
+        }
+    }
+}
+
+/**
+ * @brief 选出GCC和最大的k个候选 (按降序写入best，相等时保留靠前的候选)
+ * @return 选出的个数 min(n, k)
+ */
+static int select_top_k(const float32_t* power, int n, int k, int* best)
+{
+    int count = 0;
+    
+    for (int c = 0; c < n; c++) {
+        int pos = count;
+        while (pos > 0 && power[c] > power[best[pos - 1]]) {
+            pos--;
+        }
+        if (pos >= k) {
+            continue;
+        }
+        
+        int last = (count < k) ? count : k - 1;
+        for (int j = last; j > pos; j--) {
+            best[j] = best[j - 1];
+        }
+        best[pos] = c;
+        if (count < k) {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/*============================================================================
+ * 函数实现
+ *============================================================================*/
+
+status_t srp_ico_grid_coordinates(int r, float32_t* xyz)
+{
+    if (r < 1 || r > SRP_ICO_MAX_RESOLUTION || xyz == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int count = 3 * SRP_ICO_POINTS(r);
+    float64_t* grid = (float64_t*)malloc(count * sizeof(float64_t));
+    if (grid == NULL) {
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    build_grid(r, grid);
+    for (int i = 0; i < count; i++) {
+        xyz[i] = (float32_t)grid[i];
+    }
+    
+    free(grid);
+    return STATUS_OK;
+}
+
+/**
+ * @brief 计算 [pair][point] 的完整GCC索引表 (grid为3 * SRP_ICO_POINTS(r)个坐标的工作区)
+ */
+static void compute_tau(int r, const mic_position_t* mic_positions, float64_t* grid,
+                        int32_t* tau_table)
+{
+    int num_points = SRP_ICO_POINTS(r);
+    
+    build_grid(r, grid);
+    
+    /* 远场时延 g · (p2 - p1) / c，取最近的采样点 (等距时取较小者，与Python的argmin一致) */
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        int mic1, mic2;
+        gcc_phat_get_mic_pair(pair, &mic1, &mic2);
+        float64_t bx = (float64_t)mic_positions[mic2].x - mic_positions[mic1].x;
+        float64_t by = (float64_t)mic_positions[mic2].y - mic_positions[mic1].y;
+        float64_t bz = (float64_t)mic_positions[mic2].z - mic_positions[mic1].z;
+        int32_t* row = tau_table + (size_t)pair * num_points;
+        
+        for (int g = 0; g < num_points; g++) {
+            const float64_t* v = grid + 3 * (size_t)g;
+            float64_t tau = (v[0] * bx + v[1] * by + v[2] * bz) / SPEED_OF_SOUND * SAMPLE_RATE;
+            int idx = GCC_LENGTH / 2 + (int)ceil(tau - 0.5);
+            if (idx < 0) idx = 0;
+            if (idx >= GCC_LENGTH) idx = GCC_LENGTH - 1;
+            row[g] = idx;
+        }
+    }
+}
+
+srp_ico_plan_t* srp_ico_plan_create(int r, const mic_position_t* mic_positions)
+{
+    if (r < 1 || r > SRP_ICO_MAX_RESOLUTION || mic_positions == NULL) {
+        printf("[ERROR] Invalid icosahedral grid resolution: %d\n", r);
+        return NULL;
+    }
+    
+    int num_points = SRP_ICO_POINTS(r);
+    srp_ico_plan_t* plan = (srp_ico_plan_t*)calloc(1, sizeof(srp_ico_plan_t));
+    if (plan == NULL) {
+        return NULL;
+    }
+    
+    plan->r = r;
+    plan->num_points = num_points;
+    
+    /* 缓存键: 阵列几何 + 网格定义 (模块名与分辨率) */
+    int32_t resolution = r;
+    uint64_t key = tau_cache_key_geometry(mic_positions);
+    key = tau_cache_hash(key, "srp_ico", 7);
+    key = tau_cache_hash(key, &resolution, sizeof(resolution));
+    
+    size_t table_size = (size_t)NUM_MIC_PAIRS * num_points;
+    plan->cache = tau_cache_open(key, TAU_CACHE_INT32, NUM_MIC_PAIRS, num_points);
+    if (plan->cache != NULL) {
+        /* 索引越界的缓存视为未命中 (gather偏移与逐对累加都直接按索引寻址) */
+        const int32_t* cached = (const int32_t*)tau_cache_data(plan->cache);
+        for (size_t i = 0; i < table_size; i++) {
+            if (cached[i] < 0 || cached[i] >= GCC_LENGTH) {
+                printf("[INFO] Ignoring tau cache: index out of range\n");
+                tau_cache_close(plan->cache);
+                plan->cache = NULL;
+                break;
+            }
+        }
+        plan->tau = (plan->cache != NULL) ? cached : NULL;
+    }
+    
+    if (plan->cache == NULL) {
+        float64_t* grid = (float64_t*)malloc(3 * (size_t)num_points * sizeof(float64_t));
+        plan->tau_owned = (int32_t*)malloc(table_size * sizeof(int32_t));
+        if (grid == NULL || plan->tau_owned == NULL) {
+            free(grid);
+            srp_ico_plan_destroy(plan);
+            return NULL;
+        }
+        
+        compute_tau(r, mic_positions, grid, plan->tau_owned);
+        free(grid);
+        plan->tau = plan->tau_owned;
+        
+        /* 写缓存失败不影响计划 */
+        tau_cache_store(key, TAU_CACHE_INT32, NUM_MIC_PAIRS, num_points, plan->tau_owned);
+    }
+    
+    for (size_t i = 0; i < table_size; i++) {
+        int lag = abs(plan->tau[i] - GCC_LENGTH / 2);
+        if (lag > plan->max_lag) {
+            plan->max_lag = lag;
+        }
+    }
+    
+    /* 标量gather慢于按对逐行累加 (后者可被编译器向量化)，只在AVX2下默认按网格点排列 */
+    plan->layout = SRP_ICO_LAYOUT_PAIR_MAJOR;
+    plan->gather_fn = gather_scalar;
+#if FFT_SIMD_X86
+    if (fft_simd_best_engine() == FFT_ENGINE_AVX2) {
+        plan->gather_fn = gather_avx2;
+        srp_ico_plan_set_layout(plan, SRP_ICO_LAYOUT_GRID_MAJOR);
+    }
+#endif
+    
+    if (DEBUG_PRINT) {
+        printf("[INFO] Icosahedral SRP plan: r=%d, %d x %d x %d grid, max lag %d, %s%s\n",
+               r, SRP_ICO_CHARTS, SRP_ICO_HEIGHT(r), SRP_ICO_WIDTH(r), plan->max_lag,
+               srp_ico_layout_name(plan->layout), (plan->cache != NULL) ? ", cached taus" : "");
+    }
+    
+    return plan;
+}
+
+void srp_ico_plan_destroy(srp_ico_plan_t* plan)
+{
+    if (plan == NULL) {
+        return;
+    }
+    
+    free(plan->tau_owned);
+    tau_cache_close(plan->cache);
+    free(plan->offsets);
+    free(plan->compact);
+    free(plan);
+}
+
+status_t srp_ico_plan_set_layout(srp_ico_plan_t* plan, srp_ico_layout_t layout)
+{
+    if (plan == NULL ||
+        (layout != SRP_ICO_LAYOUT_PAIR_MAJOR && layout != SRP_ICO_LAYOUT_GRID_MAJOR)) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    if (layout == SRP_ICO_LAYOUT_GRID_MAJOR && !grid_major_is_current(plan)) {
+        status_t status = build_grid_major(plan);
+        if (status != STATUS_OK) {
+            return status;
+        }
+    }
+    
+    plan->layout = layout;
+    return STATUS_OK;
+}
+
+srp_ico_layout_t srp_ico_plan_get_layout(const srp_ico_plan_t* plan)
+{
+    return (plan != NULL) ? plan->layout : SRP_ICO_LAYOUT_PAIR_MAJOR;
+}
+
+int srp_ico_plan_resolution(const srp_ico_plan_t* plan)
+{
+    return (plan != NULL) ? plan->r : 0;
+}
+
+int srp_ico_plan_num_points(const srp_ico_plan_t* plan)
+{
+    return (plan != NULL) ? plan->num_points : 0;
+}
+
+int srp_ico_plan_is_cache_mapped(const srp_ico_plan_t* plan)
+{
+    return (plan != NULL) ? tau_cache_is_mapped(plan->cache) : 0;
+}
+
+status_t srp_ico_map_compute(srp_ico_plan_t* plan, const gcc_result_t* gcc_result,
+                             float32_t* map)
+{
+    if (plan == NULL || gcc_result == NULL || map == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    int num_points = plan->num_points;
+    int num_used = count_used_channels(pairs, num_pairs);
+    
+    if (plan->layout == SRP_ICO_LAYOUT_GRID_MAJOR) {
+        /* 启用的对变化后重建 */
+        if (!grid_major_is_current(plan)) {
+            status_t status = build_grid_major(plan);
+            if (status != STATUS_OK) {
+                return status;
+            }
+        }
+        
+        /* 复制孔径窗口到紧凑GCC，再逐网格点gather累加 */
+        int width = 2 * plan->max_lag + 1;
+        for (int i = 0; i < num_pairs; i++) {
+            memcpy(plan->compact + (size_t)i * width,
+                   gcc_result->data[pairs[i]] + GCC_LENGTH / 2 - plan->max_lag,
+                   width * sizeof(float32_t));
+        }
+        plan->gather_fn(plan->offsets, plan->stride, plan->compact, num_points, map);
+    } else {
+        /* 逐对累加: 时延行连续读取，输出图常驻L1 */
+        memset(map, 0, num_points * sizeof(float32_t));
+        for (int i = 0; i < num_pairs; i++) {
+            const float32_t* gcc = gcc_result->data[pairs[i]];
+            const int32_t* row = plan->tau + (size_t)pairs[i] * num_points;
+            for (int g = 0; g < num_points; g++) {
+                map[g] += gcc[row[g]];
+            }
+        }
+    }
+    
+    /* P = 2 * sum + 通道数，再按最大值归一化 */
+    float32_t peak = -INFINITY;
+    for (int g = 0; g < num_points; g++) {
+        map[g] = 2.0f * map[g] + (float32_t)num_used + 1e-12f;
+        if (map[g] > peak) {
+            peak = map[g];
+        }
+    }
+    
+    float32_t inv = 1.0f / peak;
+    for (int g = 0; g < num_points; g++) {
+        map[g] *= inv;
+    }
+    
+    return STATUS_OK;
+}
+
+status_t srp_ico_save_map(const char* filename, const srp_ico_plan_t* plan, const float32_t* map)
+{
+    if (plan == NULL || map == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL) {
+        printf("[ERROR] Cannot create file: %s\n", filename);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    /* 写入文件头 */
+    char magic[4] = "ICO";
+    int32_t charts = SRP_ICO_CHARTS;
+    int32_t height = SRP_ICO_HEIGHT(plan->r);
+    int32_t width = SRP_ICO_WIDTH(plan->r);
+    
+    fwrite(magic, 1, 4, fp);
+    fwrite(&charts, sizeof(int32_t), 1, fp);
+    fwrite(&height, sizeof(int32_t), 1, fp);
+    fwrite(&width, sizeof(int32_t), 1, fp);
+    
+    /* 写入SRP图 */
+    fwrite(map, sizeof(float32_t), plan->num_points, fp);
+    
+    fclose(fp);
+    printf("[INFO] Icosahedral SRP map saved to: %s\n", filename);
+    
+    return STATUS_OK;
+}
+
+srp_ico_search_t* srp_ico_search_create(int r, int top_k, const mic_position_t* mic_positions)
+{
+    if (r < 1 || r > SRP_ICO_MAX_RESOLUTION || top_k < 1 || top_k > SRP_ICO_SEARCH_MAX_K ||
+        mic_positions == NULL) {
+        printf("[ERROR] Invalid hierarchical search: r=%d, top-K %d\n", r, top_k);
+        return NULL;
+    }
+    
+    srp_ico_search_t* search = (srp_ico_search_t*)calloc(1, sizeof(srp_ico_search_t));
+    if (search == NULL) {
+        return NULL;
+    }
+    
+    search->r = r;
+    search->top_k = top_k;
+    
+    int num_points = SRP_ICO_POINTS(r);
+    float64_t* grid = (float64_t*)malloc(3 * (size_t)num_points * sizeof(float64_t));
+    search->direction = (float32_t*)malloc(3 * (size_t)num_points * sizeof(float32_t));
+    search->candidates = (int*)malloc(num_points * sizeof(int));
+    search->power = (float32_t*)malloc(num_points * sizeof(float32_t));
+    search->mark = (unsigned char*)calloc(num_points, 1);
+    if (grid == NULL || search->direction == NULL || search->candidates == NULL ||
+        search->power == NULL || search->mark == NULL) {
+        goto fail;
+    }
+    
+    /* 目标层网格点的单位方向 */
+    build_grid(r, grid);
+    for (int g = 0; g < num_points; g++) {
+        const float64_t* v = grid + 3 * (size_t)g;
+        float64_t norm = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        for (int i = 0; i < 3; i++) {
+            search->direction[3 * (size_t)g + i] = (float32_t)(v[i] / norm);
+        }
+    }
+    free(grid);
+    grid = NULL;
+    
+    for (int l = 1; l <= r; l++) {
+        search->plans[l] = srp_ico_plan_create(l, mic_positions);
+        if (search->plans[l] == NULL || (l < r && build_children(search, l) != STATUS_OK)) {
+            goto fail;
+        }
+    }
+    
+    if (DEBUG_PRINT) {
+        printf("[INFO] Hierarchical icosahedral search: r=1..%d, top-%d per level\n", r, top_k);
+    }
+    
+    return search;
+
+fail:
+    free(grid);
+    srp_ico_search_destroy(search);
+    return NULL;
+}
+
+void srp_ico_search_destroy(srp_ico_search_t* search)
+{
+    if (search == NULL) {
+        return;
+    }
+    
+    for (int l = 1; l <= SRP_ICO_MAX_RESOLUTION; l++) {
+        srp_ico_plan_destroy(search->plans[l]);
+    }
+    for (int l = 0; l < SRP_ICO_MAX_RESOLUTION; l++) {
+        free(search->child_start[l]);
+        free(search->child_index[l]);
+    }
+    free(search->direction);
+    free(search->candidates);
+    free(search->power);
+    free(search->mark);
+    free(search);
+}
+
+status_t srp_ico_search_run(srp_ico_search_t* search, const gcc_result_t* gcc_result,
+                            srp_ico_peak_t* peak)
+{
+    if (search == NULL || gcc_result == NULL || peak == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    int best[SRP_ICO_SEARCH_MAX_K];
+    int* candidates = search->candidates;
+    
+    /* 第1层: 全部网格点 */
+    int num_candidates = SRP_ICO_POINTS(1);
+    for (int g = 0; g < num_candidates; g++) {
+        candidates[g] = g;
+    }
+    evaluate_points(search->plans[1], gcc_result, pairs, num_pairs,
+                    candidates, num_candidates, search->power);
+    int evaluated = num_candidates;
+    int num_best = select_top_k(search->power, num_candidates, search->top_k, best);
+    
+    /* 逐层只计算保留的候选的子节点 */
+    for (int l = 1; l < search->r; l++) {
+        const int* start = search->child_start[l];
+        const int* index = search->child_index[l];
+        int parents[SRP_ICO_SEARCH_MAX_K];
+        int num_children = 0;
+        
+        /* 候选数组原位改写为下一层的子节点，先取出保留的父节点 */
+        for (int b = 0; b < num_best; b++) {
+            parents[b] = candidates[best[b]];
+        }
+        for (int b = 0; b < num_best; b++) {
+            for (int j = start[parents[b]]; j < start[parents[b] + 1]; j++) {
+                if (!search->mark[index[j]]) {
+                    search->mark[index[j]] = 1;
+                    candidates[num_children++] = index[j];
+                }
+            }
+        }
+        for (int c = 0; c < num_children; c++) {
+            search->mark[candidates[c]] = 0;
+        }
+        
+        num_candidates = num_children;
+        evaluate_points(search->plans[l + 1], gcc_result, pairs, num_pairs,
+                        candidates, num_candidates, search->power);
+        evaluated += num_candidates;
+        num_best = select_top_k(search->power, num_candidates, search->top_k, best);
+    }
+    
+    int g = candidates[best[0]];
+    int height = SRP_ICO_HEIGHT(search->r);
+    int width = SRP_ICO_WIDTH(search->r);
+    
+    peak->index = g;
+    peak->chart = g / (height * width);
+    peak->h = (g / width) % height;
+    peak->w = g % width;
+    peak->power = 2.0f * search->power[best[0]] + (float32_t)count_used_channels(pairs, num_pairs);
+    memcpy(peak->direction, search->direction + 3 * (size_t)g, sizeof(peak->direction));
+    peak->evaluated = evaluated;
+    
+    return STATUS_OK;
+}
+
+const char* srp_ico_layout_name(srp_ico_layout_t layout)
+{
+    switch (layout) {
+        case SRP_ICO_LAYOUT_PAIR_MAJOR: return "pair-major";
+        case SRP_ICO_LAYOUT_GRID_MAJOR: return "grid-major";
+        default:                        return "unknown";
+    }
+}
@@ -6,6 +6,12 @@
  * 
  * 实现SRP(Steered Response Power)空间功率谱投影
  * 将GCC结果映射到三维空间网格
+ * 
+ * Tau Table保存全部麦克风对的行，投影只累加启用的麦克风对 (gcc_phat_get_active_pairs)。
+ * 
+ * 时延列 (一个网格点在全部麦克风对上的时延) 相同的网格点投影结果相同，去重时各投影路径
+ * 只计算每组的代表网格点 (g_unique_points)，再按g_point_unique写回全部网格点。
+ * 取整时延只比较整数列；插值或频域引擎还要求小数时延相同。
  */
 
 #include <stdio.h>
@@ -14,13 +20,32 @@
 #include <math.h>
 #include "srp_map.h"
 #include "gcc_phat.h"
+#include "srp_freq.h"
+#include "tau_cache.h"
+
+/*============================================================================
+ * 插值参数
+ *============================================================================*/
+#define SRP_INTERP_MARGIN   2           /* 插值额外读取的时延 (三次插值读取 floor-1..floor+2) */
 
 /*============================================================================
  * 静态变量
  *============================================================================*/
 static tau_table_t g_tau_table;
+static tau_frac_table_t g_frac_table;                           /* 小数时延 (插值投影) */
+static srp_interp_t g_interp = (srp_interp_t)SRP_TAU_INTERP;
+static tau_table_t g_compact_table;                             /* 紧凑GCC中的偏移 */
+static int g_aperture_tau = 1;                                  /* 孔径决定的最大时延 */
 static mic_position_t g_mic_positions[NUM_CHANNELS];
 static int g_srp_initialized = 0;
+static srp_engine_t g_engine = SRP_ENGINE_LOOKUP;                 /* 实际使用的计算路径 */
+static srp_engine_t g_engine_request = SRP_ENGINE_LOOKUP;         /* 设置的计算路径 (可为AUTO) */
+static srp_freq_plan_t* g_freq_plan = NULL;                     /* 频域引擎计划 */
+static int g_far_field = SRP_FAR_FIELD;                         /* 远场模式 (平面波时延) */
+static int g_dedup = SRP_DEDUP_TAU;                             /* 合并时延列相同的网格点 */
+static int g_num_unique = TAU_TABLE_SIZE;                       /* 不同时延列的个数 */
+static int g_unique_points[TAU_TABLE_SIZE];                     /* 第u个不同列的代表网格点 */
+static int g_point_unique[TAU_TABLE_SIZE];                      /* 网格点所属的不同列 */
 
 /* 空间网格参数 */
 static float32_t g_elevation_range[2] = {0.0f, PI};           /* 俯仰角范围 */
@@ -54,15 +79,279 @@ static void sph2cart(float32_t elevation, float32_t azimuth, float32_t range,
     *z = range * cosf(elevation);
 }
 
+/**
+ * @brief 网格点的未取整时延: 近场按声源到两个麦克风的距离差，远场按方向向量的平面波时延
+ */
+static float32_t grid_tau(const mic_position_t* mic1_pos, const mic_position_t* mic2_pos,
+                          float32_t elevation, float32_t azimuth, float32_t range)
+{
+    if (!g_far_field) {
+        return srp_map_compute_tau_frac(mic1_pos, mic2_pos, elevation, azimuth, range);
+    }
+    
+    /* 距离远大于孔径时 d1 - d2 -> u · (p2 - p1) */
+    float32_t ux, uy, uz;
+    sph2cart(elevation, azimuth, 1.0f, &ux, &uy, &uz);
+    float32_t path = ux * (mic2_pos->x - mic1_pos->x) + uy * (mic2_pos->y - mic1_pos->y) +
+                     uz * (mic2_pos->z - mic1_pos->z);
+    return path / SPEED_OF_SOUND * SAMPLE_RATE;
+}
+
+/**
+ * @brief 由麦克风位置计算孔径决定的最大时延
+ */
+static int compute_aperture_tau(const mic_position_t* mic_positions)
+{
+    float32_t max_distance = 0.0f;
+    
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+        for (int j = i + 1; j < NUM_CHANNELS; j++) {
+            float32_t d = compute_distance(&mic_positions[i],
+                                           mic_positions[j].x, mic_positions[j].y, mic_positions[j].z);
+            if (d > max_distance) {
+                max_distance = d;
+            }
+        }
+    }
+    
+    /* 时延按四舍五入取整，取上整保证覆盖 */
+    int tau = (int)ceilf(max_distance / SPEED_OF_SOUND * SAMPLE_RATE);
+    if (tau < 1) tau = 1;
+    if (tau > MAX_TAU_SAMPLES) tau = MAX_TAU_SAMPLES;
+    
+    return tau;
+}
+
+/**
+ * @brief 将Tau Table的完整GCC索引映射为紧凑GCC偏移
+ */
+static void build_compact_table(void)
+{
+    int width = 2 * g_aperture_tau + 1;
+    
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            int tau = g_tau_table.tau_indices[pair][i] - GCC_LENGTH / 2;
+            if (tau < -g_aperture_tau) tau = -g_aperture_tau;
+            if (tau > g_aperture_tau) tau = g_aperture_tau;
+            g_compact_table.tau_indices[pair][i] = pair * width + g_aperture_tau + tau;
+        }
+    }
+}
+
+/**
+ * @brief 由未取整的时延生成小数时延表 (索引向下取整，权重为小数部分)
+ */
+static void build_frac_table(const float32_t* tau_frac)
+{
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            float32_t tau = tau_frac[(size_t)pair * TAU_TABLE_SIZE + i];
+            float32_t base = floorf(tau);
+            int idx = GCC_LENGTH / 2 + (int)base;
+            float32_t weight = tau - base;
+            
+            /* 插值读取 idx-1..idx+2，边界处退化为端点 */
+            if (idx < 1) { idx = 1; weight = 0.0f; }
+            if (idx > GCC_LENGTH - 3) { idx = GCC_LENGTH - 3; weight = 0.0f; }
+            
+            g_frac_table.tau_indices[pair][i] = idx;
+            g_frac_table.tau_weights[pair][i] = weight;
+        }
+    }
+}
+
+/**
+ * @brief 由整数Tau Table生成小数时延表 (外部加载的表没有小数部分)
+ */
+static void build_frac_from_int(void)
+{
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            int idx = g_tau_table.tau_indices[pair][i];
+            if (idx < 1) idx = 1;
+            if (idx > GCC_LENGTH - 3) idx = GCC_LENGTH - 3;
+            g_frac_table.tau_indices[pair][i] = idx;
+            g_frac_table.tau_weights[pair][i] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief 两个网格点的时延列是否相同 (fractional非0时还比较小数时延表)
+ */
+static int tau_columns_equal(int a, int b, int fractional)
+{
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        if (g_tau_table.tau_indices[pair][a] != g_tau_table.tau_indices[pair][b]) {
+            return 0;
+        }
+        if (fractional &&
+            (g_frac_table.tau_indices[pair][a] != g_frac_table.tau_indices[pair][b] ||
+             g_frac_table.tau_weights[pair][a] != g_frac_table.tau_weights[pair][b])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 按时延列对网格点分组 (不去重时每个网格点自成一组)
+ */
+static void build_unique(int fractional)
+{
+    g_num_unique = 0;
+    
+    for (int g = 0; g < TAU_TABLE_SIZE; g++) {
+        int u = g_num_unique;
+        if (g_dedup) {
+            for (u = 0; u < g_num_unique; u++) {
+                if (tau_columns_equal(g_unique_points[u], g, fractional)) {
+                    break;
+                }
+            }
+        }
+        if (u == g_num_unique) {
+            g_unique_points[g_num_unique++] = g;
+        }
+        g_point_unique[g] = u;
+    }
+}
+
+/**
+ * @brief 当前投影路径所需的分组: 插值与频域引擎使用小数时延
+ */
+static void rebuild_unique(void)
+{
+    build_unique(g_interp != SRP_INTERP_NEAREST || g_engine == SRP_ENGINE_FREQ);
+}
+
+/**
+ * @brief 把各组代表网格点的SRP写回全部网格点
+ */
+static void scatter_unique(const float32_t* sums, srp_map_t* srp_result)
+{
+    float32_t* out = &srp_result->data[0][0][0];
+    for (int g = 0; g < TAU_TABLE_SIZE; g++) {
+        out[g] = sums[g_point_unique[g]];
+    }
+}
+
+/**
+ * @brief 打印网格定义
+ */
+static void print_grid_info(void)
+{
+    printf("  Elevation: %.2f to %.2f rad, %d bins\n", 
+           g_elevation_range[0], g_elevation_range[1], SRP_ELEVATION_BINS);
+    printf("  Azimuth: %.2f to %.2f rad, %d bins\n", 
+           g_azimuth_range[0], g_azimuth_range[1], SRP_AZIMUTH_BINS);
+    if (g_far_field) {
+        printf("  Range: %d bins (far field, direction only)\n", SRP_RANGE_BINS);
+    } else {
+        printf("  Range: %d bins\n", SRP_RANGE_BINS);
+    }
+}
+
+/**
+ * @brief 当前阵列与网格定义的时延表缓存键
+ */
+static uint64_t tau_cache_key(void)
+{
+    int32_t bins[4] = { SRP_ELEVATION_BINS, SRP_AZIMUTH_BINS, SRP_RANGE_BINS, g_far_field };
+    
+    uint64_t key = tau_cache_key_geometry(g_mic_positions);
+    key = tau_cache_hash(key, "srp_map", 7);
+    key = tau_cache_hash(key, bins, sizeof(bins));
+    key = tau_cache_hash(key, g_elevation_range, sizeof(g_elevation_range));
+    key = tau_cache_hash(key, g_azimuth_range, sizeof(g_azimuth_range));
+    key = tau_cache_hash(key, g_range_values, sizeof(g_range_values));
+    
+    return key;
+}
+
+/**
+ * @brief 获取未取整的时延表 [NUM_MIC_PAIRS][TAU_TABLE_SIZE]: 缓存命中时复制，否则计算并写回
+ * @return 1表示缓存命中
+ */
+static int load_frac_taus(float32_t* tau)
+{
+    uint64_t key = tau_cache_key();
+    size_t bytes = (size_t)NUM_MIC_PAIRS * TAU_TABLE_SIZE * sizeof(float32_t);
+    
+    tau_cache_view_t* view = tau_cache_open(key, TAU_CACHE_FLOAT32, NUM_MIC_PAIRS, TAU_TABLE_SIZE);
+    if (view != NULL) {
+        memcpy(tau, tau_cache_data(view), bytes);
+        tau_cache_close(view);
+        return 1;
+    }
+    
+    srp_map_compute_frac_tau_table(g_mic_positions, tau);
+    tau_cache_store(key, TAU_CACHE_FLOAT32, NUM_MIC_PAIRS, TAU_TABLE_SIZE, tau);
+    return 0;
+}
+
+/**
+ * @brief 建立取整、紧凑与小数时延表
+ * 
+ * 取整规则与srp_map_compute_tau_table相同 (四舍五入后限制在GCC范围内)，
+ * 三张表都由同一份未取整的时延导出。
+ */
+static status_t build_tau_tables(void)
+{
+    float32_t* tau = (float32_t*)malloc((size_t)NUM_MIC_PAIRS * TAU_TABLE_SIZE * sizeof(float32_t));
+    if (tau == NULL) {
+        return STATUS_ERROR_MEMORY_ALLOC;
+    }
+    
+    int cached = load_frac_taus(tau);
+    printf("[INFO] Tau Table %s: %d pairs x %d grid points\n",
+           cached ? "loaded from cache" : "computed", NUM_MIC_PAIRS, TAU_TABLE_SIZE);
+    print_grid_info();
+    
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            int gcc_idx = GCC_LENGTH / 2 + (int)roundf(tau[(size_t)pair * TAU_TABLE_SIZE + i]);
+            if (gcc_idx < 0) gcc_idx = 0;
+            if (gcc_idx >= GCC_LENGTH) gcc_idx = GCC_LENGTH - 1;
+            g_tau_table.tau_indices[pair][i] = gcc_idx;
+        }
+    }
+    
+    build_compact_table();
+    build_frac_table(tau);
+    free(tau);
+    
+    return STATUS_OK;
+}
+
+/**
+ * @brief 在 x[i] 与 x[i+1] 之间按权重w线性插值
+ */
+static inline float32_t interp_linear(const float32_t* x, int i, float32_t w)
+{
+    return x[i] + w * (x[i + 1] - x[i]);
+}
+
+/**
+ * @brief 在 x[i] 与 x[i+1] 之间按权重w三次插值 (Catmull-Rom，另读取x[i-1]与x[i+2])
+ */
+static inline float32_t interp_cubic(const float32_t* x, int i, float32_t w)
+{
+    float32_t p0 = x[i - 1], p1 = x[i], p2 = x[i + 1], p3 = x[i + 2];
+    return p1 + 0.5f * w * (p2 - p0 + w * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                                           w * (3.0f * (p1 - p2) + p3 - p0)));
+}
+
 /*============================================================================
  * 函数实现
  *============================================================================*/
 
-int srp_map_compute_tau(const mic_position_t* mic1_pos,
-                         const mic_position_t* mic2_pos,
-                         float32_t elevation,
-                         float32_t azimuth,
-                         float32_t range)
+float32_t srp_map_compute_tau_frac(const mic_position_t* mic1_pos,
+                                   const mic_position_t* mic2_pos,
+                                   float32_t elevation,
+                                   float32_t azimuth,
+                                   float32_t range)
 {
     /* 计算声源位置（笛卡尔坐标） */
     float32_t src_x, src_y, src_z;
@@ -74,9 +363,47 @@ int srp_map_compute_tau(const mic_position_t* mic1_pos,
     
     /* 计算时延（采样点数） */
     float32_t tau_seconds = (d1 - d2) / SPEED_OF_SOUND;
-    int tau_samples = (int)roundf(tau_seconds * SAMPLE_RATE);
+    return tau_seconds * SAMPLE_RATE;
+}
+
+int srp_map_compute_tau(const mic_position_t* mic1_pos,
+                         const mic_position_t* mic2_pos,
+                         float32_t elevation,
+                         float32_t azimuth,
+                         float32_t range)
+{
+    return (int)roundf(srp_map_compute_tau_frac(mic1_pos, mic2_pos, elevation, azimuth, range));
+}
+
+status_t srp_map_compute_frac_tau_table(const mic_position_t* mic_positions, float32_t* tau)
+{
+    if (mic_positions == NULL || tau == NULL) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    float32_t elev_step = (g_elevation_range[1] - g_elevation_range[0]) / 
+                          (SRP_ELEVATION_BINS - 1);
+    float32_t azim_step = (g_azimuth_range[1] - g_azimuth_range[0]) / 
+                          (SRP_AZIMUTH_BINS - 1);
+    
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        int mic1, mic2;
+        gcc_phat_get_mic_pair(pair, &mic1, &mic2);
+        float32_t* row = tau + (size_t)pair * TAU_TABLE_SIZE;
+        
+        for (int e = 0; e < SRP_ELEVATION_BINS; e++) {
+            float32_t elevation = g_elevation_range[0] + e * elev_step;
+            for (int a = 0; a < SRP_AZIMUTH_BINS; a++) {
+                float32_t azimuth = g_azimuth_range[0] + a * azim_step;
+                for (int r = 0; r < SRP_RANGE_BINS; r++) {
+                    *row++ = grid_tau(&mic_positions[mic1], &mic_positions[mic2],
+                                      elevation, azimuth, g_range_values[r]);
+                }
+            }
+        }
+    }
     
-    return tau_samples;
+    return STATUS_OK;
 }
 
 status_t srp_map_compute_tau_table(const mic_position_t* mic_positions,
@@ -88,11 +415,7 @@ status_t srp_map_compute_tau_table(const mic_position_t* mic_positions,
                           (SRP_AZIMUTH_BINS - 1);
     
     printf("[INFO] Computing Tau Table...\n");
-    printf("  Elevation: %.2f to %.2f rad, %d bins\n", 
-           g_elevation_range[0], g_elevation_range[1], SRP_ELEVATION_BINS);
-    printf("  Azimuth: %.2f to %.2f rad, %d bins\n", 
-           g_azimuth_range[0], g_azimuth_range[1], SRP_AZIMUTH_BINS);
-    printf("  Range: %d bins\n", SRP_RANGE_BINS);
+    print_grid_info();
     
     /* 遍历所有麦克风对 */
     for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
@@ -112,11 +435,11 @@ status_t srp_map_compute_tau_table(const mic_position_t* mic_positions,
                     float32_t range = g_range_values[r];
                     
                     /* 计算时延 */
-                    int tau = srp_map_compute_tau(
+                    int tau = (int)roundf(grid_tau(
                         &mic_positions[mic1],
                         &mic_positions[mic2],
                         elevation, azimuth, range
-                    );
+                    ));
                     
                     /* 转换为GCC数组索引（考虑fftshift后零时延在中心） */
                     int gcc_idx = GCC_LENGTH / 2 + tau;
@@ -148,11 +471,15 @@ status_t srp_map_init(const mic_position_t* mic_positions)
     memcpy(g_mic_positions, mic_positions, 
            NUM_CHANNELS * sizeof(mic_position_t));
     
-    /* 计算Tau Table */
-    status_t status = srp_map_compute_tau_table(mic_positions, &g_tau_table);
+    /* 孔径决定的最大时延，Tau Table、紧凑GCC的Tau Table与小数时延表 (按阵列与网格缓存) */
+    g_aperture_tau = compute_aperture_tau(mic_positions);
+    status_t status = build_tau_tables();
     if (status != STATUS_OK) {
         return status;
     }
+    rebuild_unique();
+    printf("[INFO] Array aperture: max tau %d samples\n", g_aperture_tau);
+    printf("[INFO] Distinct tau columns: %d of %d grid points\n", g_num_unique, TAU_TABLE_SIZE);
     
     g_srp_initialized = 1;
     printf("[INFO] SRP-Map module initialized\n");
@@ -162,9 +489,131 @@ status_t srp_map_init(const mic_position_t* mic_positions)
 
 void srp_map_cleanup(void)
 {
+    srp_freq_plan_destroy(g_freq_plan);
+    g_freq_plan = NULL;
+    g_engine = SRP_ENGINE_LOOKUP;
+    g_engine_request = SRP_ENGINE_LOOKUP;
     g_srp_initialized = 0;
 }
 
+status_t srp_map_set_engine(srp_engine_t engine)
+{
+    if (!g_srp_initialized) {
+        printf("[ERROR] SRP-Map module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (engine != SRP_ENGINE_AUTO && engine != SRP_ENGINE_LOOKUP && engine != SRP_ENGINE_FREQ) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    int bin_lo, bin_hi;
+    gcc_phat_get_band(&bin_lo, &bin_hi);
+    
+    srp_engine_t chosen = engine;
+    if (engine == SRP_ENGINE_AUTO) {
+        chosen = srp_freq_choose_engine(g_num_unique, bin_lo, bin_hi, g_aperture_tau, 1);
+    }
+    
+    srp_freq_plan_destroy(g_freq_plan);
+    g_freq_plan = NULL;
+    g_engine = SRP_ENGINE_LOOKUP;
+    g_engine_request = engine;
+    
+    if (chosen == SRP_ENGINE_FREQ) {
+        /* 频域引擎使用未取整的时延，只为各组的代表网格点建立导向向量 */
+        build_unique(1);
+        float32_t* tau = (float32_t*)malloc((size_t)NUM_MIC_PAIRS * TAU_TABLE_SIZE * sizeof(float32_t));
+        if (tau == NULL) {
+            rebuild_unique();
+            return STATUS_ERROR_MEMORY_ALLOC;
+        }
+        load_frac_taus(tau);
+        for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+            float32_t* row = tau + (size_t)pair * TAU_TABLE_SIZE;
+            float32_t* packed = tau + (size_t)pair * g_num_unique;
+            for (int u = 0; u < g_num_unique; u++) {
+                packed[u] = row[g_unique_points[u]];
+            }
+        }
+        g_freq_plan = srp_freq_plan_create(tau, g_num_unique, bin_lo, bin_hi);
+        free(tau);
+        
+        if (g_freq_plan == NULL) {
+            printf("[ERROR] Failed to create frequency-domain SRP plan\n");
+            rebuild_unique();
+            return STATUS_ERROR_MEMORY_ALLOC;
+        }
+        g_engine = SRP_ENGINE_FREQ;
+    }
+    
+    rebuild_unique();
+    
+    if (DEBUG_PRINT) {
+        printf("[INFO] SRP engine: %s\n", srp_engine_name(g_engine));
+    }
+    
+    return STATUS_OK;
+}
+
+srp_engine_t srp_map_get_engine(void)
+{
+    return g_engine;
+}
+
+status_t srp_map_set_interp(srp_interp_t mode)
+{
+    if (mode != SRP_INTERP_NEAREST && mode != SRP_INTERP_LINEAR && mode != SRP_INTERP_CUBIC) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    g_interp = mode;
+    if (g_srp_initialized) {
+        rebuild_unique();
+    }
+    return STATUS_OK;
+}
+
+srp_interp_t srp_map_get_interp(void)
+{
+    return g_interp;
+}
+
+status_t srp_map_set_far_field(int enable)
+{
+    g_far_field = (enable != 0);
+    if (!g_srp_initialized) {
+        return STATUS_OK;
+    }
+    
+    /* 重新建立各时延表，频域计划按原设置重建 */
+    status_t status = build_tau_tables();
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return srp_map_set_engine(g_engine_request);
+}
+
+int srp_map_is_far_field(void)
+{
+    return g_far_field;
+}
+
+status_t srp_map_set_dedup(int enable)
+{
+    g_dedup = (enable != 0);
+    if (!g_srp_initialized) {
+        return STATUS_OK;
+    }
+    
+    return srp_map_set_engine(g_engine_request);
+}
+
+int srp_map_get_num_unique(void)
+{
+    return g_num_unique;
+}
+
 status_t srp_map_compute(const gcc_result_t* gcc_result, 
                           srp_map_t* srp_result)
 {
@@ -173,36 +622,206 @@ status_t srp_map_compute(const gcc_result_t* gcc_result,
         return STATUS_ERROR_INVALID_PARAM;
     }
     
-    /* 清零输出 */
-    memset(srp_result, 0, sizeof(srp_map_t));
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    float32_t sums[TAU_TABLE_SIZE];
+    
+    /* 小数时延: 在相邻GCC样本之间插值 */
+    if (g_interp != SRP_INTERP_NEAREST) {
+        for (int u = 0; u < g_num_unique; u++) {
+            int grid_idx = g_unique_points[u];
+            float32_t sum = 0.0f;
+            for (int i = 0; i < num_pairs; i++) {
+                int pair = pairs[i];
+                int idx = g_frac_table.tau_indices[pair][grid_idx];
+                float32_t w = g_frac_table.tau_weights[pair][grid_idx];
+                sum += (g_interp == SRP_INTERP_CUBIC) ? interp_cubic(gcc_result->data[pair], idx, w)
+                                                      : interp_linear(gcc_result->data[pair], idx, w);
+            }
+            sums[u] = sum;
+        }
+        scatter_unique(sums, srp_result);
+        return STATUS_OK;
+    }
     
-    /* 遍历所有空间网格点 */
-    for (int e = 0; e < SRP_ELEVATION_BINS; e++) {
-        for (int a = 0; a < SRP_AZIMUTH_BINS; a++) {
-            for (int r = 0; r < SRP_RANGE_BINS; r++) {
-                float32_t sum = 0.0f;
-                int grid_idx = e * SRP_AZIMUTH_BINS * SRP_RANGE_BINS + 
-                               a * SRP_RANGE_BINS + r;
-                
-                /* 累加所有麦克风对的GCC值 */
-                for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
-                    int gcc_idx = g_tau_table.tau_indices[pair][grid_idx];
-                    sum += gcc_result->data[pair][gcc_idx];
-                }
-                
-                srp_result->data[e][a][r] = sum;
+    /* 遍历时延列不同的网格点 */
+    for (int u = 0; u < g_num_unique; u++) {
+        int grid_idx = g_unique_points[u];
+        float32_t sum = 0.0f;
+        
+        /* 累加启用的麦克风对的GCC值 */
+        for (int i = 0; i < num_pairs; i++) {
+            int pair = pairs[i];
+            int gcc_idx = g_tau_table.tau_indices[pair][grid_idx];
+            sum += gcc_result->data[pair][gcc_idx];
+        }
+        
+        sums[u] = sum;
+    }
+    
+    scatter_unique(sums, srp_result);
+    return STATUS_OK;
+}
+
+status_t srp_map_compute_compact(const gcc_compact_t* compact,
+                                 srp_map_t* srp_result)
+{
+    if (!g_srp_initialized) {
+        printf("[ERROR] SRP-Map module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (compact->max_lag != g_aperture_tau) {
+        printf("[ERROR] Compact GCC lag range %d does not match aperture %d\n",
+               compact->max_lag, g_aperture_tau);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    float32_t sums[TAU_TABLE_SIZE];
+    
+    for (int u = 0; u < g_num_unique; u++) {
+        int grid_idx = g_unique_points[u];
+        float32_t sum = 0.0f;
+        
+        /* 累加启用的麦克风对的GCC值 (紧凑GCC只有几KB，常驻L1) */
+        for (int i = 0; i < num_pairs; i++) {
+            sum += compact->data[g_compact_table.tau_indices[pairs[i]][grid_idx]];
+        }
+        
+        sums[u] = sum;
+    }
+    
+    scatter_unique(sums, srp_result);
+    return STATUS_OK;
+}
+
+status_t srp_map_compute_fused(const fft_result_t* whitened,
+                               srp_map_t* srp_result)
+{
+    if (!g_srp_initialized) {
+        printf("[ERROR] SRP-Map module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    float32_t lags[2 * (MAX_TAU_SAMPLES + SRP_INTERP_MARGIN) + 1];
+    int width = 2 * g_aperture_tau + 1;
+    const int* pairs;
+    int num_pairs = gcc_phat_get_active_pairs(&pairs);
+    float32_t sums[TAU_TABLE_SIZE];
+    
+    memset(sums, 0, g_num_unique * sizeof(float32_t));
+    
+    /* 小数时延: 时延窗口两侧各多算SRP_INTERP_MARGIN个点供插值读取 */
+    if (g_interp != SRP_INTERP_NEAREST) {
+        int max_lag = g_aperture_tau + SRP_INTERP_MARGIN;
+        for (int i = 0; i < num_pairs; i++) {
+            int pair = pairs[i];
+            status_t status = gcc_phat_compute_pair_lags(whitened, pair, max_lag, lags);
+            if (status != STATUS_OK) {
+                printf("[ERROR] Fused GCC-SRP failed for pair %d\n", pair);
+                return status;
+            }
+            
+            const int* row = g_frac_table.tau_indices[pair];
+            const float32_t* weights = g_frac_table.tau_weights[pair];
+            for (int u = 0; u < g_num_unique; u++) {
+                int grid_idx = g_unique_points[u];
+                int pos = max_lag + row[grid_idx] - GCC_LENGTH / 2;
+                if (pos < 1) pos = 1;
+                if (pos > 2 * max_lag - 2) pos = 2 * max_lag - 2;
+                sums[u] += (g_interp == SRP_INTERP_CUBIC) ? interp_cubic(lags, pos, weights[grid_idx])
+                                                          : interp_linear(lags, pos, weights[grid_idx]);
             }
         }
+        scatter_unique(sums, srp_result);
+        return STATUS_OK;
+    }
+    
+    for (int i = 0; i < num_pairs; i++) {
+        int pair = pairs[i];
+        status_t status = gcc_phat_compute_pair_lags(whitened, pair, g_aperture_tau, lags);
+        if (status != STATUS_OK) {
+            printf("[ERROR] Fused GCC-SRP failed for pair %d\n", pair);
+            return status;
+        }
+        
+        /* 紧凑表的偏移减去行首即为暂存区内的位置 */
+        const int* row = g_compact_table.tau_indices[pair];
+        int base = pair * width;
+        for (int u = 0; u < g_num_unique; u++) {
+            sums[u] += lags[row[g_unique_points[u]] - base];
+        }
     }
     
+    scatter_unique(sums, srp_result);
     return STATUS_OK;
 }
 
+status_t srp_map_compute_spectrum(const fft_result_t* whitened,
+                                  srp_map_t* srp_result)
+{
+    if (!g_srp_initialized) {
+        printf("[ERROR] SRP-Map module not initialized\n");
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 启用的麦克风对、GCC频带或频点掩码变化后按原设置重建频域计划 */
+    if (g_engine == SRP_ENGINE_FREQ && !srp_freq_plan_is_current(g_freq_plan)) {
+        status_t status = srp_map_set_engine(g_engine_request);
+        if (status != STATUS_OK) {
+            return status;
+        }
+    }
+    
+    if (g_engine == SRP_ENGINE_FREQ) {
+        float32_t sums[TAU_TABLE_SIZE];
+        status_t status = srp_freq_compute(g_freq_plan, whitened, sums);
+        if (status == STATUS_OK) {
+            scatter_unique(sums, srp_result);
+        }
+        return status;
+    }
+    
+    return srp_map_compute_fused(whitened, srp_result);
+}
+
 const tau_table_t* srp_map_get_tau_table(void)
 {
     return &g_tau_table;
 }
 
+int srp_map_get_max_tau(void)
+{
+    int max_tau = 0;
+    
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            int tau = abs(g_tau_table.tau_indices[pair][i] - GCC_LENGTH / 2);
+            if (tau > max_tau) {
+                max_tau = tau;
+            }
+        }
+    }
+    
+    return max_tau;
+}
+
+int srp_map_get_aperture_tau(void)
+{
+    return g_aperture_tau;
+}
+
+const tau_table_t* srp_map_get_compact_tau_table(void)
+{
+    return &g_compact_table;
+}
+
+const tau_frac_table_t* srp_map_get_frac_tau_table(void)
+{
+    return &g_frac_table;
+}
+
 status_t srp_map_save_tau_table(const char* filename)
 {
     FILE* fp = fopen(filename, "wb");
@@ -241,30 +860,60 @@ status_t srp_map_load_tau_table(const char* filename)
         return STATUS_ERROR_FILE_NOT_FOUND;
     }
     
+    status_t status = STATUS_ERROR_INVALID_PARAM;
+    tau_table_t* table = NULL;
+    
     /* 读取文件头 */
     char magic[4];
     int32_t num_pairs, table_size, reserved;
     
-    fread(magic, 1, 4, fp);
-    if (strncmp(magic, "TAU", 3) != 0) {
+    if (fread(magic, 1, 4, fp) != 4 || memcmp(magic, "TAU", 4) != 0 ||
+        fread(&num_pairs, sizeof(int32_t), 1, fp) != 1 ||
+        fread(&table_size, sizeof(int32_t), 1, fp) != 1 ||
+        fread(&reserved, sizeof(int32_t), 1, fp) != 1) {
         printf("[ERROR] Invalid Tau Table file format\n");
-        fclose(fp);
-        return STATUS_ERROR_INVALID_PARAM;
+        goto cleanup;
+    }
+    
+    if (num_pairs != NUM_MIC_PAIRS || table_size != TAU_TABLE_SIZE) {
+        printf("[ERROR] Tau Table shape mismatch: %d x %d (expected %d x %d)\n",
+               num_pairs, table_size, NUM_MIC_PAIRS, TAU_TABLE_SIZE);
+        goto cleanup;
     }
     
-    fread(&num_pairs, sizeof(int32_t), 1, fp);
-    fread(&table_size, sizeof(int32_t), 1, fp);
-    fread(&reserved, sizeof(int32_t), 1, fp);
+    /* 先读入临时表，全部校验通过后再替换当前表 */
+    table = (tau_table_t*)malloc(sizeof(tau_table_t));
+    if (table == NULL) {
+        status = STATUS_ERROR_MEMORY_ALLOC;
+        goto cleanup;
+    }
     
-    /* 读取Tau Table数据 */
     for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
-        fread(g_tau_table.tau_indices[pair], sizeof(int), TAU_TABLE_SIZE, fp);
+        if (fread(table->tau_indices[pair], sizeof(int), TAU_TABLE_SIZE, fp) != TAU_TABLE_SIZE) {
+            printf("[ERROR] Tau Table file truncated: %s\n", filename);
+            goto cleanup;
+        }
+        for (int i = 0; i < TAU_TABLE_SIZE; i++) {
+            int idx = table->tau_indices[pair][i];
+            if (idx < 0 || idx >= GCC_LENGTH) {
+                printf("[ERROR] Tau Table index out of range: pair %d, point %d, index %d\n",
+                       pair, i, idx);
+                goto cleanup;
+            }
+        }
     }
     
-    fclose(fp);
+    memcpy(&g_tau_table, table, sizeof(tau_table_t));
+    build_compact_table();
+    build_frac_from_int();
+    rebuild_unique();
     printf("[INFO] Tau Table loaded from: %s\n", filename);
-    
-    return STATUS_OK;
+    status = STATUS_OK;
+
+cleanup:
+    free(table);
+    fclose(fp);
+    return status;
 }
 
 void srp_map_print_result(const srp_map_t* srp_result)
@@ -305,7 +954,11 @@ void srp_map_print_result(const srp_map_t* srp_result)
            est_elevation, est_elevation * 180.0f / PI);
     printf("  Azimuth: %.2f rad (%.2f deg)\n", 
            est_azimuth, est_azimuth * 180.0f / PI);
-    printf("  Range: %.2f m\n", est_range);
+    if (g_far_field) {
+        printf("  Range: far field\n");
+    } else {
+        printf("  Range: %.2f m\n", est_range);
+    }
     printf("  Value: %.4f\n", max_val);
     
     /* 打印一个切片 */
@@ -0,0 +1,437 @@
+/**
+ * @file tau_cache.c
+ * @brief 时延表缓存模块实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 文件布局: 64字节文件头，补零到TAU_CACHE_ALIGN，再接rows x cols个4字节元素。
+ * 映射整个文件后数据指针即为 base + data_offset，与页对齐。
+ * 内存映射不可用时退化为整个文件读入内存，校验与使用方式相同。
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tau_cache.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define TAU_CACHE_ENDIAN_MARK   0x01020304      /* 写入端的字节序标记 */
+#define TAU_CACHE_DIR_LEN       256
+#define TAU_CACHE_PATH_LEN      (TAU_CACHE_DIR_LEN + 32)   /* 目录 + "/tau_<16位十六进制>.bin" */
+
+/*============================================================================
+ * 文件头 (64字节)
+ *============================================================================*/
+typedef struct {
+    char magic[4];          /* "TCH\0" */
+    int32_t version;        /* TAU_CACHE_VERSION */
+    int32_t header_bytes;   /* sizeof(tau_cache_header_t) */
+    int32_t data_offset;    /* 数据起始偏移 (TAU_CACHE_ALIGN) */
+    uint64_t key;           /* 缓存键 */
+    int32_t elem_type;      /* tau_cache_elem_t */
+    int32_t elem_bytes;     /* 元素字节数 (4) */
+    int32_t rows;
+    int32_t cols;
+    uint64_t data_bytes;    /* rows * cols * elem_bytes */
+    uint64_t checksum;      /* 数据校验和 (见checksum) */
+    int32_t endian;         /* TAU_CACHE_ENDIAN_MARK */
+    int32_t reserved;
+} tau_cache_header_t;
+
+struct tau_cache_view {
+    void* base;             /* 映射起始地址 (或读入的副本) */
+    size_t length;          /* 文件长度 */
+    const void* data;       /* base + data_offset */
+    int mapped;             /* 1: 内存映射, 0: malloc副本 */
+};
+
+/*============================================================================
+ * 静态变量
+ *============================================================================*/
+static char g_cache_dir[TAU_CACHE_DIR_LEN] = TAU_CACHE_DIR;
+static int g_cache_enabled = TAU_CACHE_ENABLE;
+static int g_store_warned = 0;          /* 写入失败只提示一次 */
+
+/*============================================================================
+ * 辅助函数
+ *============================================================================*/
+
+/**
+ * @brief 缓存文件路径: <目录>/tau_<键>.bin
+ */
+static void cache_path(uint64_t key, char* path, size_t size)
+{
+    snprintf(path, size, "%s/tau_%016llx.bin", g_cache_dir, (unsigned long long)key);
+}
+
+/**
+ * @brief 逐级创建目录 (相当于 mkdir -p)，已存在的目录忽略
+ */
+static void make_dirs(const char* dir)
+{
+    char buf[TAU_CACHE_DIR_LEN];
+    snprintf(buf, sizeof(buf), "%s", dir);
+    if (buf[0] == '\0') {
+        return;
+    }
+    
+    for (char* p = buf + 1; ; p++) {
+        if (*p != '/' && *p != '\\' && *p != '\0') {
+            continue;
+        }
+        char c = *p;
+        *p = '\0';
+#if defined(_WIN32)
+        _mkdir(buf);
+#else
+        mkdir(buf, 0755);
+#endif
+        if (c == '\0') {
+            break;
+        }
+        *p = c;
+    }
+}
+
+/**
+ * @brief 写入失败提示 (非致命，整个进程只打印一次)
+ */
+static void warn_store_failed(const char* path)
+{
+    if (!g_store_warned) {
+        printf("[WARNING] Cannot write tau cache %s, continuing without cache\n", path);
+        g_store_warned = 1;
+    }
+}
+
+/**
+ * @brief 内存映射整个文件 (只读)，失败时读入内存
+ */
+static int map_file(const char* path, tau_cache_view_t* view)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            view->base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        view->length = (size_t)size.QuadPart;
+    }
+    CloseHandle(file);
+    
+    if (view->base != NULL) {
+        view->mapped = 1;
+        return 1;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        view->length = (size_t)st.st_size;
+        if (base != MAP_FAILED) {
+            view->base = base;
+            view->mapped = 1;
+        }
+    }
+    close(fd);
+    
+    if (view->mapped) {
+        return 1;
+    }
+#endif
+    
+    /* 映射失败: 读入内存 */
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    
+    if (length <= 0 || (view->base = malloc((size_t)length)) == NULL ||
+        fread(view->base, 1, (size_t)length, fp) != (size_t)length) {
+        free(view->base);
+        view->base = NULL;
+        fclose(fp);
+        return 0;
+    }
+    
+    fclose(fp);
+    view->length = (size_t)length;
+    view->mapped = 0;
+    return 1;
+}
+
+static void unmap_file(tau_cache_view_t* view)
+{
+    if (view->base == NULL) {
+        return;
+    }
+    
+    if (view->mapped) {
+#if defined(_WIN32)
+        UnmapViewOfFile(view->base);
+#else
+        munmap(view->base, view->length);
+#endif
+    } else {
+        free(view->base);
+    }
+    view->base = NULL;
+}
+
+/**
+ * @brief 数据校验和: 4个交错通道分别对32位字做FNV-1a，最后与剩余字节一起合并
+ * 
+ * 逐字节FNV-1a的乘法链在r = 4的时延表 (675 KB) 上约需1 ms，与直接计算时延相当；
+ * 按字处理并拆成独立的4条乘法链后校验不再主导命中时的开销。
+ */
+static uint64_t checksum(const void* data, size_t bytes)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    size_t words = bytes / 4;
+    uint64_t lane[4] = { TAU_CACHE_HASH_INIT, TAU_CACHE_HASH_INIT ^ 1,
+                         TAU_CACHE_HASH_INIT ^ 2, TAU_CACHE_HASH_INIT ^ 3 };
+    size_t i = 0;
+    
+    for (; i + 4 <= words; i += 4) {
+        for (int k = 0; k < 4; k++) {
+            uint32_t w;
+            memcpy(&w, p + 4 * (i + k), sizeof(w));
+            lane[k] = (lane[k] ^ w) * 1099511628211ULL;
+        }
+    }
+    
+    uint64_t hash = tau_cache_hash(TAU_CACHE_HASH_INIT, lane, sizeof(lane));
+    return tau_cache_hash(hash, p + 4 * i, bytes - 4 * i);
+}
+
+/**
+ * @brief 校验文件头与数据，返回不符的原因 (NULL表示通过)
+ */
+static const char* validate(const tau_cache_view_t* view, uint64_t key,
+                            tau_cache_elem_t type, int rows, int cols)
+{
+    if (view->length < sizeof(tau_cache_header_t)) {
+        return "truncated header";
+    }
+    
+    const tau_cache_header_t* header = (const tau_cache_header_t*)view->base;
+    uint64_t data_bytes = (uint64_t)rows * cols * 4;
+    
+    if (memcmp(header->magic, "TCH", 4) != 0) {
+        return "bad magic";
+    }
+    if (header->endian != TAU_CACHE_ENDIAN_MARK) {
+        return "byte order mismatch";
+    }
+    if (header->version != TAU_CACHE_VERSION || header->header_bytes != (int32_t)sizeof(tau_cache_header_t)) {
+        return "version mismatch";
+    }
+    if (header->key != key) {
+        return "key mismatch";
+    }
+    if (header->elem_type != (int32_t)type || header->elem_bytes != 4 ||
+        header->rows != rows || header->cols != cols || header->data_bytes != data_bytes) {
+        return "shape mismatch";
+    }
+    if (header->data_offset < (int32_t)sizeof(tau_cache_header_t) ||
+        header->data_offset % TAU_CACHE_ALIGN != 0 ||
+        (uint64_t)header->data_offset + data_bytes > view->length) {
+        return "truncated data";
+    }
+    if (checksum((const char*)view->base + header->data_offset, (size_t)data_bytes) != header->checksum) {
+        return "checksum mismatch";
+    }
+    
+    return NULL;
+}
+
+/*============================================================================
+ * 函数实现
+ *============================================================================*/
+
+uint64_t tau_cache_hash(uint64_t hash, const void* data, size_t bytes)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    
+    return hash;
+}
+
+uint64_t tau_cache_key_geometry(const mic_position_t* mic_positions)
+{
+    int32_t ints[6] = { TAU_CACHE_VERSION, NUM_CHANNELS, NUM_MIC_PAIRS,
+                        SAMPLE_RATE, FFT_SIZE, GCC_LENGTH };
+    float32_t speed = SPEED_OF_SOUND;
+    
+    uint64_t hash = tau_cache_hash(TAU_CACHE_HASH_INIT, ints, sizeof(ints));
+    hash = tau_cache_hash(hash, &speed, sizeof(speed));
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        float32_t xyz[3] = { mic_positions[ch].x, mic_positions[ch].y, mic_positions[ch].z };
+        hash = tau_cache_hash(hash, xyz, sizeof(xyz));
+    }
+    
+    return hash;
+}
+
+void tau_cache_set_dir(const char* dir)
+{
+    if (dir == NULL) {
+        g_cache_enabled = 0;
+        return;
+    }
+    
+    snprintf(g_cache_dir, sizeof(g_cache_dir), "%s", dir);
+    g_cache_enabled = 1;
+}
+
+const char* tau_cache_get_dir(void)
+{
+    return g_cache_enabled ? g_cache_dir : NULL;
+}
+
+tau_cache_view_t* tau_cache_open(uint64_t key, tau_cache_elem_t type, int rows, int cols)
+{
+    if (!g_cache_enabled || rows <= 0 || cols <= 0) {
+        return NULL;
+    }
+    
+    char path[TAU_CACHE_PATH_LEN];
+    cache_path(key, path, sizeof(path));
+    
+    tau_cache_view_t* view = (tau_cache_view_t*)calloc(1, sizeof(tau_cache_view_t));
+    if (view == NULL) {
+        return NULL;
+    }
+    
+    if (!map_file(path, view)) {
+        free(view);
+        return NULL;
+    }
+    
+    const char* reason = validate(view, key, type, rows, cols);
+    if (reason != NULL) {
+        printf("[INFO] Ignoring tau cache %s: %s\n", path, reason);
+        tau_cache_close(view);
+        return NULL;
+    }
+    
+    view->data = (const char*)view->base + ((const tau_cache_header_t*)view->base)->data_offset;
+    return view;
+}
+
+const void* tau_cache_data(const tau_cache_view_t* view)
+{
+    return (view != NULL) ? view->data : NULL;
+}
+
+int tau_cache_is_mapped(const tau_cache_view_t* view)
+{
+    return (view != NULL) ? view->mapped : 0;
+}
+
+void tau_cache_close(tau_cache_view_t* view)
+{
+    if (view == NULL) {
+        return;
+    }
+    
+    unmap_file(view);
+    free(view);
+}
+
+status_t tau_cache_store(uint64_t key, tau_cache_elem_t type, int rows, int cols, const void* data)
+{
+    if (!g_cache_enabled) {
+        return STATUS_OK;
+    }
+    if (data == NULL || rows <= 0 || cols <= 0) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    char path[TAU_CACHE_PATH_LEN];
+    char tmp_path[TAU_CACHE_PATH_LEN + 8];
+    cache_path(key, path, sizeof(path));
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    
+    /* 缓存目录不存在时逐级创建 */
+    make_dirs(g_cache_dir);
+    
+    tau_cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "TCH", 4);
+    header.version = TAU_CACHE_VERSION;
+    header.header_bytes = (int32_t)sizeof(tau_cache_header_t);
+    header.data_offset = TAU_CACHE_ALIGN;
+    header.key = key;
+    header.elem_type = (int32_t)type;
+    header.elem_bytes = 4;
+    header.rows = rows;
+    header.cols = cols;
+    header.data_bytes = (uint64_t)rows * cols * 4;
+    header.checksum = checksum(data, (size_t)header.data_bytes);
+    header.endian = TAU_CACHE_ENDIAN_MARK;
+    
+    FILE* fp = fopen(tmp_path, "wb");
+    if (fp == NULL) {
+        warn_store_failed(tmp_path);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    /* 文件头补零到数据偏移 */
+    static const char zeros[TAU_CACHE_ALIGN] = { 0 };
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             fwrite(zeros, 1, TAU_CACHE_ALIGN - sizeof(header), fp) == TAU_CACHE_ALIGN - sizeof(header) &&
+             fwrite(data, 1, (size_t)header.data_bytes, fp) == (size_t)header.data_bytes;
+    ok = (fclose(fp) == 0) && ok;
+    
+    /* 写完再改名，读取端不会看到不完整的文件 */
+#if defined(_WIN32)
+    if (ok) {
+        remove(path);
+    }
+#endif
+    if (!ok || rename(tmp_path, path) != 0) {
+        warn_store_failed(path);
+        remove(tmp_path);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    if (DEBUG_PRINT) {
+        printf("[INFO] Tau cache written: %s (%d x %d)\n", path, rows, cols);
+    }
+    
+    return STATUS_OK;
+}
@@ -372,6 +372,119 @@ status_t test_data_save_srp(const char* filename,
     return STATUS_OK;
 }
 
+status_t test_data_load_fft(const char* filename,
+                             fft_result_t* fft_result)
+{
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        printf("[ERROR] Cannot open file: %s\n", filename);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    /* 读取并校验文件头 */
+    char magic[4];
+    int32_t nc = 0, nb = 0, reserved;
+    
+    fread(magic, 1, 4, fp);
+    fread(&nc, sizeof(int32_t), 1, fp);
+    fread(&nb, sizeof(int32_t), 1, fp);
+    fread(&reserved, sizeof(int32_t), 1, fp);
+    if (strncmp(magic, "FFT", 3) != 0 || nc != NUM_CHANNELS || nb != FFT_BINS) {
+        printf("[ERROR] Invalid FFT file format: %s\n", filename);
+        fclose(fp);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 读取FFT数据 */
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        if (fread(fft_result->data[ch], sizeof(complex_t), FFT_BINS, fp) != FFT_BINS) {
+            printf("[ERROR] Truncated FFT file: %s\n", filename);
+            fclose(fp);
+            return STATUS_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    fclose(fp);
+    printf("[INFO] FFT result loaded from: %s\n", filename);
+    
+    return STATUS_OK;
+}
+
+status_t test_data_load_gcc(const char* filename,
+                             gcc_result_t* gcc_result)
+{
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        printf("[ERROR] Cannot open file: %s\n", filename);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    /* 读取并校验文件头 */
+    char magic[4];
+    int32_t np = 0, len = 0, reserved;
+    
+    fread(magic, 1, 4, fp);
+    fread(&np, sizeof(int32_t), 1, fp);
+    fread(&len, sizeof(int32_t), 1, fp);
+    fread(&reserved, sizeof(int32_t), 1, fp);
+    if (strncmp(magic, "GCC", 3) != 0 || np != NUM_MIC_PAIRS || len != GCC_LENGTH) {
+        printf("[ERROR] Invalid GCC file format: %s\n", filename);
+        fclose(fp);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 读取GCC数据 */
+    for (int pair = 0; pair < NUM_MIC_PAIRS; pair++) {
+        if (fread(gcc_result->data[pair], sizeof(float32_t), GCC_LENGTH, fp) != GCC_LENGTH) {
+            printf("[ERROR] Truncated GCC file: %s\n", filename);
+            fclose(fp);
+            return STATUS_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    fclose(fp);
+    printf("[INFO] GCC result loaded from: %s\n", filename);
+    
+    return STATUS_OK;
+}
+
+status_t test_data_load_srp(const char* filename,
+                             srp_map_t* srp_result)
+{
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        printf("[ERROR] Cannot open file: %s\n", filename);
+        return STATUS_ERROR_FILE_NOT_FOUND;
+    }
+    
+    /* 读取并校验文件头 */
+    char magic[4];
+    int32_t ne = 0, na = 0, nr = 0;
+    
+    fread(magic, 1, 4, fp);
+    fread(&ne, sizeof(int32_t), 1, fp);
+    fread(&na, sizeof(int32_t), 1, fp);
+    fread(&nr, sizeof(int32_t), 1, fp);
+    if (strncmp(magic, "SRP", 3) != 0 || ne != SRP_ELEVATION_BINS ||
+        na != SRP_AZIMUTH_BINS || nr != SRP_RANGE_BINS) {
+        printf("[ERROR] Invalid SRP file format: %s\n", filename);
+        fclose(fp);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    /* 读取SRP数据 */
+    if (fread(srp_result->data, sizeof(float32_t), TAU_TABLE_SIZE, fp) != TAU_TABLE_SIZE) {
+        printf("[ERROR] Truncated SRP file: %s\n", filename);
+        fclose(fp);
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    
+    fclose(fp);
+    printf("[INFO] SRP result loaded from: %s\n", filename);
+    
+    return STATUS_OK;
+}
+
 status_t test_data_save_as_text(const char* filename,
                                  const float32_t* data,
                                  int rows,
@@ -0,0 +1,250 @@
+/**
+ * @file thread_pool.c
+ * @brief 工作线程池实现
+ * @author Cross3D C Implementation
+ * @date 2024
+ * 
+ * 一个互斥量保护任务计数，工作线程在work条件变量上等待新批次，
+ * 调用线程在done条件变量上等待本批任务全部完成。
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "thread_pool.h"
+
+/*============================================================================
+ * 平台线程原语
+ *============================================================================*/
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef HANDLE              tp_thread_t;
+typedef CRITICAL_SECTION    tp_mutex_t;
+typedef CONDITION_VARIABLE  tp_cond_t;
+
+#define tp_mutex_init(m)        (InitializeCriticalSection(m), 0)
+#define tp_mutex_destroy(m)     DeleteCriticalSection(m)
+#define tp_mutex_lock(m)        EnterCriticalSection(m)
+#define tp_mutex_unlock(m)      LeaveCriticalSection(m)
+#define tp_cond_init(c)         (InitializeConditionVariable(c), 0)
+#define tp_cond_destroy(c)      ((void)(c))
+#define tp_cond_wait(c, m)      SleepConditionVariableCS(c, m, INFINITE)
+#define tp_cond_broadcast(c)    WakeAllConditionVariable(c)
+#define tp_cond_signal(c)       WakeConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t           tp_thread_t;
+typedef pthread_mutex_t     tp_mutex_t;
+typedef pthread_cond_t      tp_cond_t;
+
+#define tp_mutex_init(m)        pthread_mutex_init(m, NULL)
+#define tp_mutex_destroy(m)     pthread_mutex_destroy(m)
+#define tp_mutex_lock(m)        pthread_mutex_lock(m)
+#define tp_mutex_unlock(m)      pthread_mutex_unlock(m)
+#define tp_cond_init(c)         pthread_cond_init(c, NULL)
+#define tp_cond_destroy(c)      pthread_cond_destroy(c)
+#define tp_cond_wait(c, m)      pthread_cond_wait(c, m)
+#define tp_cond_broadcast(c)    pthread_cond_broadcast(c)
+#define tp_cond_signal(c)       pthread_cond_signal(c)
+#endif
+
+/*============================================================================
+ * 线程池结构
+ *============================================================================*/
+struct thread_pool;
+
+typedef struct {
+    struct thread_pool* pool;
+    int index;                      /* 工作线程编号 */
+} tp_worker_t;
+
+struct thread_pool {
+    int num_workers;
+    int num_started;                /* 成功创建的线程数 */
+    tp_thread_t* threads;
+    tp_worker_t* workers;
+    
+    tp_mutex_t mutex;
+    tp_cond_t work;                 /* 新批次或退出 */
+    tp_cond_t done;                 /* 本批次完成 */
+    
+    thread_pool_task_t fn;          /* 当前批次 (NULL表示空闲) */
+    void* arg;
+    int num_tasks;
+    int next_task;                  /* 下一个待分发的任务 */
+    int completed;                  /* 已完成的任务数 */
+    int shutdown;
+};
+
+/*============================================================================
+ * 工作线程
+ *============================================================================*/
+
+static void worker_loop(tp_worker_t* worker)
+{
+    thread_pool_t* pool = worker->pool;
+    
+    tp_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->shutdown && (pool->fn == NULL || pool->next_task >= pool->num_tasks)) {
+            tp_cond_wait(&pool->work, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        
+        int task = pool->next_task++;
+        thread_pool_task_t fn = pool->fn;
+        void* arg = pool->arg;
+        
+        tp_mutex_unlock(&pool->mutex);
+        fn(arg, task, worker->index);
+        tp_mutex_lock(&pool->mutex);
+        
+        if (++pool->completed == pool->num_tasks) {
+            tp_cond_signal(&pool->done);
+        }
+    }
+    tp_mutex_unlock(&pool->mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI worker_main(LPVOID param)
+{
+    worker_loop((tp_worker_t*)param);
+    return 0;
+}
+#else
+static void* worker_main(void* param)
+{
+    worker_loop((tp_worker_t*)param);
+    return NULL;
+}
+#endif
+
+/*============================================================================
+ * 函数实现
+ *============================================================================*/
+
+int thread_pool_cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    int count = 1;
+#endif
+    return (count > 0) ? count : 1;
+}
+
+thread_pool_t* thread_pool_create(int num_workers)
+{
+    if (num_workers <= 0) {
+        num_workers = thread_pool_cpu_count();
+    }
+    
+    thread_pool_t* pool = (thread_pool_t*)calloc(1, sizeof(thread_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    
+    pool->num_workers = num_workers;
+    pool->threads = (tp_thread_t*)calloc(num_workers, sizeof(tp_thread_t));
+    pool->workers = (tp_worker_t*)calloc(num_workers, sizeof(tp_worker_t));
+    if (pool->threads == NULL || pool->workers == NULL ||
+        tp_mutex_init(&pool->mutex) != 0) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    tp_cond_init(&pool->work);
+    tp_cond_init(&pool->done);
+    
+    for (int i = 0; i < num_workers; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+#if defined(_WIN32)
+        pool->threads[i] = CreateThread(NULL, 0, worker_main, &pool->workers[i], 0, NULL);
+        int failed = (pool->threads[i] == NULL);
+#else
+        int failed = pthread_create(&pool->threads[i], NULL, worker_main, &pool->workers[i]);
+#endif
+        if (failed) {
+            printf("[ERROR] Failed to start worker thread %d\n", i);
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->num_started++;
+    }
+    
+    return pool;
+}
+
+void thread_pool_destroy(thread_pool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    
+    tp_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    tp_cond_broadcast(&pool->work);
+    tp_mutex_unlock(&pool->mutex);
+    
+    for (int i = 0; i < pool->num_started; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+    
+    tp_cond_destroy(&pool->work);
+    tp_cond_destroy(&pool->done);
+    tp_mutex_destroy(&pool->mutex);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool);
+}
+
+int thread_pool_size(const thread_pool_t* pool)
+{
+    return (pool != NULL) ? pool->num_workers : 0;
+}
+
+status_t thread_pool_run(thread_pool_t* pool, thread_pool_task_t fn, void* arg, int num_tasks)
+{
+    if (pool == NULL || fn == NULL || num_tasks < 0) {
+        return STATUS_ERROR_INVALID_PARAM;
+    }
+    if (num_tasks == 0) {
+        return STATUS_OK;
+    }
+    
+    tp_mutex_lock(&pool->mutex);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->num_tasks = num_tasks;
+    pool->next_task = 0;
+    pool->completed = 0;
+    tp_cond_broadcast(&pool->work);
+    
+    while (pool->completed < pool->num_tasks) {
+        tp_cond_wait(&pool->done, &pool->mutex);
+    }
+    pool->fn = NULL;
+    tp_mutex_unlock(&pool->mutex);
+    
+    return STATUS_OK;
+}